@@ -1,15 +1,23 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cmath>
+#include <cstdint>
+#include <array>
 #include "SimulationSettings.h"
 #include "Pathfinder.h"
+#include "MemoryTracker.h"
 
 // forward declarations for optimization systems
 // TODO: restructure to change this
 class SpatialGrid;
 class OptimizedTrailMap;
+class ParallelProcessor;
 struct SharedExplorationState;
 #include "FoodPellet.h"
 
+// agent storage, counted under MemoryTag::Agents
+struct Agent;
+using AgentVector = std::vector<Agent, TrackedAllocator<Agent, MemoryTag::Agents>>;
 
 // based on N body sim
 // mem aligned agent structure for optimal cache performance
@@ -40,6 +48,85 @@ public:
     // cached constraint for turn clamping (radians per step)
     float maxTurnPerStep = 3.14159265f;
 
+    // heading as a unit vector kept alongside angle. angle stays the source of truth for the
+    // behaviors that set it directly, the vector is only recomputed when angle moved without it
+    // (headingAngle = the angle headingDir belongs to)
+    struct Rotation
+    {
+        float radians = 0.0f;
+        float c = 1.0f;
+        float s = 0.0f;
+        void set(float r)
+        {
+            if (r != radians)
+            {
+                radians = r;
+                c = std::cos(r);
+                s = std::sin(r);
+            }
+        }
+    };
+    sf::Vector2f headingDir = sf::Vector2f(1.0f, 0.0f);
+    float headingAngle = 0.0f;
+    Rotation sensorRotation; // sensor spacing (species * genome), refreshed only when it changes
+    Rotation turnRotation;   // fixed chemotaxis turn step (species * genome)
+
+    // level of detail: an agent whose sensing keeps coming back with "no turn" (settled on a vein, or
+    // in a saturated patch where all sensors read the same) only senses every 2nd (level 1) or 4th
+    // (level 2) step and keeps its heading in between. any turn or nearby event puts it back to 0
+    static constexpr int MAX_LOD_LEVEL = 2;
+    std::uint8_t lodLevel = 0;
+    std::uint8_t lodStableSenses = 0; // senses in a row without a turn at the current level
+    bool lodSenseDue(std::uint32_t step) const { return (step & ((1u << lodLevel) - 1u)) == 0; }
+    void recordLodSense(bool turned, int stableSenses)
+    {
+        if (turned)
+        {
+            promoteLod();
+            return;
+        }
+        if (lodStableSenses < 255)
+            ++lodStableSenses;
+        if (lodStableSenses >= stableSenses && lodLevel < MAX_LOD_LEVEL)
+        {
+            ++lodLevel;
+            lodStableSenses = 0;
+        }
+    }
+    void promoteLod()
+    {
+        lodLevel = 0;
+        lodStableSenses = 0;
+    }
+
+    const sf::Vector2f &heading()
+    {
+        if (angle != headingAngle)
+        {
+            headingDir = sf::Vector2f(std::cos(angle), std::sin(angle));
+            headingAngle = angle;
+        }
+        return headingDir;
+    }
+    // direction rotated by +/- r from the heading, no trig
+    sf::Vector2f rotatedHeading(const Rotation &r, float sign)
+    {
+        const sf::Vector2f h = heading();
+        const float s = r.s * sign;
+        return sf::Vector2f(h.x * r.c - h.y * s, h.x * s + h.y * r.c);
+    }
+    // turn by +/- r keeping angle and the vector in sync
+    void turnBy(const Rotation &r, float sign)
+    {
+        sf::Vector2f h = rotatedHeading(r, sign);
+        // first order renormalize so rounding doesnt build up over thousands of turns
+        const float fix = 1.5f - 0.5f * (h.x * h.x + h.y * h.y);
+        headingDir = h * fix;
+        // keep angle wrapped, a float angle that grows without bound drifts away from the vector
+        angle = std::remainder(angle + r.radians * sign, 6.28318531f);
+        headingAngle = angle;
+    }
+
     // benchmark control slime helpers
     float benchmarkEnergy = 1.0f;
     float benchmarkSignalMemory = 0.0f;
@@ -81,7 +168,7 @@ public:
     int parentSpeciesB = -1;
 
     // path following for algorithm race mode
-    std::vector<GridCell> currentPath;      // path from pathfinder
+    CompactPath currentPath;                // path from pathfinder (packed, see Pathfinder.h)
     size_t pathIndex = 0;                   // current position in path
     bool hasPath = false;                   // whether agent has a computed path
     bool reachedGoal = false;               // whether agent has reached the goal
@@ -108,10 +195,10 @@ public:
     bool isLeader = false;                                 // is this agent the "leader" for shared exploration (DFS)
     bool isBackwardWave = false;                           // for Bidirectional: true = searching from goal, false = from start
     GridCell currentCell;                                  // current grid position
-    std::deque<GridCell> explorationFrontier;              // cells to explore next (deque for efficient front/back operations)
-    std::unordered_set<GridCell, GridCellHash> visitedCells; // already visited cells
-    std::unordered_map<GridCell, GridCell, GridCellHash> explorationParents; // for path reconstruction
-    std::unordered_map<GridCell, float, GridCellHash> explorationCosts;      // for Dijkstra: cost to reach each cell
+    TrackedCellDeque<MemoryTag::Exploration> explorationFrontier;                   // cells to explore next (deque for efficient front/back operations)
+    TrackedCellSet<MemoryTag::Exploration> visitedCells;                           // already visited cells
+    TrackedCellMap<GridCell, MemoryTag::Exploration> explorationParents;           // for path reconstruction
+    TrackedCellMap<float, MemoryTag::Exploration> explorationCosts;                // for Dijkstra: cost to reach each cell
     int explorationStepsPerFrame = 1;                      // how many cells to explore per frame
     
     // smooth movement for exploration (same speed as pathfinders)
@@ -133,6 +220,12 @@ public:
 
     Agent(float x, float y, float a, int species = 0);
     ~Agent(); 
+    // spelled out because of the destructor: without them every vector shuffle falls back to copying
+    // the exploration containers and path memory
+    Agent(const Agent &) = default;
+    Agent &operator=(const Agent &) = default;
+    Agent(Agent &&) noexcept = default;
+    Agent &operator=(Agent &&) noexcept = default;
 
     // species mask management for correct color rendering after rerolls
     void setDefaultSpeciesMask(int localSpeciesIndex);
@@ -142,14 +235,21 @@ public:
     void move(const SimulationSettings &settings);
     void moveWithPelletSeeking(const SimulationSettings &settings, const std::vector<FoodPellet> &foodPellets);
     void sense(const float *chemoattractant, int width, int height, const SimulationSettings &settings);
+    // forward / left / right sensor positions from the cached heading and sensor rotation (what the
+    // next sense call will read, give or take the turn it makes first)
+    std::array<sf::Vector2f, 3> sensorPositions(const SimulationSettings &settings) const;
+    // stage 1 of the sensing pipeline: prefetch this agent's sensor cells ahead of its sense call
+    void prefetchSensors(const class TrailMap &trailMap, const SimulationSettings &settings) const;
+    void prefetchSensors(const float *chemoattractant, int width, int height, const SimulationSettings &settings) const;
     void senseMultiSpeciesOptimized(class TrailMap &trailMap, const SimulationSettings &settings,
-                                    const SpatialGrid &spatialGrid, const std::vector<Agent> &allAgents);
-    void senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vector<Agent> &allAgents,
+                                    const SpatialGrid &spatialGrid, const AgentVector &allAgents);
+    void senseWithSpatialGrid(const SpatialGrid &spatialGrid, const AgentVector &allAgents,
                               class OptimizedTrailMap &trailMap, const SimulationSettings &settings);
     void depositOptimized(class OptimizedTrailMap &trailMap, const SimulationSettings &settings);
     void senseMultiSpecies(class TrailMap &trailMap, const SimulationSettings &settings);
 
     void deposit(float *chemoattractant, int width, int height, const SimulationSettings &settings);
+    void deposit(class TrailMap &trailMap, const SimulationSettings &settings); // channel 0, lazy decay aware
     void depositMultiSpecies(class TrailMap &trailMap, const SimulationSettings &settings);
     void depositBenchmark(class TrailMap &trailMap, float strength);  // simple direct deposit for benchmark mode
 
@@ -179,11 +279,15 @@ public:
     // benchmark slime behavior 
     // authentic slime behavior for benchmark mode - trail based navigation with weak goal bias
     // goalX/goalY: used for weak directional bias when no trail detected (not cheating - just drift)
-    // returns true if goal was found (by sensing high trail concentration at goal)
-    bool benchmarkSlimeStep(class TrailMap& trailMap, const Pathfinder& pathfinder,
+    // returns false if the slime ran out of energy this step.
+    // only reads the trail map so it is safe to run in parallel - the trail is laid afterwards
+    // by depositBenchmarkSlime (staged per channel by the caller)
+    bool benchmarkSlimeStep(const class TrailMap& trailMap, const Pathfinder& pathfinder,
                             const SimulationSettings &settings,
-                            float trailDepositStrength, float goalX, float goalY,
+                            float goalX, float goalY,
                             int goalFieldChannel);
+    // lays the slime trail for the position/energy left by benchmarkSlimeStep
+    void depositBenchmarkSlime(class TrailMap& trailMap, float trailDepositStrength) const;
     // reinforce the recent path with bonus trail deposits when goal is found
     // creates stigmergic feedback - other slimes will follow the proven path
     void reinforceRecentPath(class TrailMap& trailMap, float baseStrength);
@@ -214,6 +318,13 @@ public:
     static Agent createOffspring(const Agent &a, const Agent &b, const SimulationSettings &settings);
     void applyGenomeToCachedParams(const SimulationSettings &settings);
 
+    // drops all per agent behavior state in the static maps (lazily recreated on the next move).
+    // used when agent slots get reused wholesale so a respawned agent doesnt inherit stale modes
+    static void resetSharedBehaviorState();
+    // the static maps are keyed by agent address, so when agents get reordered inside one vector
+    // their entries have to follow them. base = &agents[0], order[i] = old slot of the agent now in slot i
+    static void permuteSharedBehaviorState(const Agent *base, size_t count, const std::vector<std::uint32_t> &order);
+
 private:
     float sampleChemoattractant(const float *grid, int x, int y, int width, int height) const;
 
@@ -244,7 +355,7 @@ private:
     bool shouldSeekPellets(const SimulationSettings &settings) const;
 
     // deposition pattern helpers
-    void depositThickTrail(class TrailMap &trailMap, int centerX, int centerY, float strength, int radius);
+    void depositThickTrail(class TrailMap &trailMap, int centerX, int centerY, float strength, int radius, bool fastMath = false);
     void depositNetworkPattern(class TrailMap &trailMap, int centerX, int centerY, float strength);
     void depositSegmentedPattern(class TrailMap &trailMap, int centerX, int centerY, float strength);
     void depositRadialPattern(class TrailMap &trailMap, int centerX, int centerY, float strength);
@@ -258,8 +369,22 @@ private:
 class AgentFactory
 {
 public:
-    static std::vector<Agent> createAgents(const SimulationSettings &settings);
-    static std::vector<Agent> createAgents(const SimulationSettings &settings, const std::vector<int> &activeSpeciesIndices);
+    static AgentVector createAgents(const SimulationSettings &settings);
+    static AgentVector createAgents(const SimulationSettings &settings, const std::vector<int> &activeSpeciesIndices);
+
+    // bulk spawner: fills `agents` with settings.numAgents fresh agents in place.
+    // existing elements are reused (copy assigned from a per species prototype) so a reset
+    // doesnt free and reconstruct every agent. positions/angles/ages come from a counter based
+    // rng so chunks run in parallel on the pool (serial if pool is null)
+    static void spawnAgents(AgentVector &agents, const SimulationSettings &settings,
+                            const std::vector<int> &activeSpeciesIndices, ParallelProcessor *pool);
+    // appends a full quota of agents (numAgents / species count) in fresh colonies for each
+    // listed species index - used when species are added without respawning everyone else
+    static void spawnSpecies(AgentVector &agents, const SimulationSettings &settings,
+                             const std::vector<int> &speciesToSpawn, ParallelProcessor *pool);
+    // appends `count` agents cloned near random existing agents (adjustAgentCount)
+    static void spawnClones(AgentVector &agents, size_t count, const SimulationSettings &settings,
+                            ParallelProcessor *pool);
 
 private:
     static sf::Vector2f getSpawnPosition(SimulationSettings::SpawnMode mode,
@@ -5,16 +5,23 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <deque>
+#include <map>
 #include <queue>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 #include "SimulationSettings.h"
 #include "Pathfinder.h"
+#include "RetainedHud.h"
+#include "EventLog.h"
 #include <SFML/Graphics.hpp>
 
 // shared exploration state for explorer algorithms (BFS, Dijkstra, DFS, RandomWalk, whatever)
 struct SharedExplorationState {
-    std::deque<GridCell> frontier;  // shared frontier queue
-    std::unordered_set<GridCell, GridCellHash> visited;  // shared visited set
-    std::unordered_map<GridCell, GridCell, GridCellHash> parents;  // for path reconstruction
+    TrackedCellDeque<MemoryTag::Exploration> frontier;          // shared frontier queue
+    TrackedCellSet<MemoryTag::Exploration> visited;             // shared visited set
+    TrackedCellMap<GridCell, MemoryTag::Exploration> parents;   // for path reconstruction
     bool foundGoal = false;
     GridCell goalCell;
     
@@ -52,9 +59,9 @@ struct SharedExplorationState {
 // bidirectional search state - two waves that meet in the middle
 struct BidirectionalState {
     // forward wave (from start)
-    std::unordered_set<GridCell, GridCellHash> forwardVisited;
+    TrackedCellSet<MemoryTag::Exploration> forwardVisited;
     // backward wave (from goal)  
-    std::unordered_set<GridCell, GridCellHash> backwardVisited;
+    TrackedCellSet<MemoryTag::Exploration> backwardVisited;
     
     bool wavesHaveMet = false;  // true when forward and backward waves meet
     GridCell meetingPoint;      // where they met
@@ -97,6 +104,37 @@ struct BidirectionalState {
     }
 };
 
+// lock free fixed bucket histogram for arrival times. buckets are log2 spaced with
+// SUB_BUCKETS per octave (~4% relative error) so percentiles cost O(buckets) and no
+// individual samples are stored. record() is safe from any number of threads
+class ArrivalTimeHistogram {
+public:
+    static constexpr int SUB_BUCKETS = 16;
+    static constexpr int OCTAVES = 24;                             // 1ms .. ~4.6 hours
+    static constexpr int NUM_BUCKETS = SUB_BUCKETS * OCTAVES + 1;  // bucket 0 = under 1ms
+
+    ArrivalTimeHistogram() { clear(); }
+
+    void clear();
+    void record(double ms);
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    double mean() const;
+    double minMs() const;
+    double maxMs() const;
+    double percentile(double p) const;  // p in [0, 1], -1 if empty
+
+private:
+    static int bucketFor(double ms);
+    static double bucketLowerMs(int bucket);
+
+    std::array<std::atomic<std::uint64_t>, NUM_BUCKETS> buckets_;
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sumMicros_{0};
+    std::atomic<std::uint64_t> minMicros_{UINT64_MAX};
+    std::atomic<std::uint64_t> maxMicros_{0};
+};
+
 // statistics for a single algorithm in the benchmark
 struct AlgorithmStats {
     SimulationSettings::Algos algorithm;
@@ -112,6 +150,8 @@ struct AlgorithmStats {
     double firstArrivalTimeMs = -1.0;   // time when first agent arrived
     double lastArrivalTimeMs = -1.0;    // time when last agent arrived
     double avgArrivalTimeMs = 0.0;      // average arrival time
+    double p50ArrivalTimeMs = -1.0;     // median arrival time (from the histogram)
+    double p95ArrivalTimeMs = -1.0;     // 95th percentile arrival time
     
     // pathfinding metrics (from initial path computation)
     double totalComputeTimeMs = 0.0;    // total time to compute all paths
@@ -136,6 +176,24 @@ struct DoublingResult {
     double timeMs;             // pathfinding compute time
     double ratio;              // T(2N) / T(N)
     std::string estimatedBigO; // estimated complexity
+    size_t peakWorkspaceBytes = 0; // largest search workspace (MemoryTag::Pathfinder) over the trials
+};
+
+// sequential vs concurrent bidirectional search on the same doubling mazes
+struct BidirectionalTiming {
+    int problemSize;     // N (maze cells)
+    double sequentialMs; // findPathBidirectional
+    double parallelMs;   // findPathBidirectionalParallel
+    int sequentialHops;  // path lengths: the concurrent one is hop optimal, the sequential one takes the first meeting
+    int parallelHops;
+};
+
+// sequential dijkstra vs delta stepping distance fields from the spawn, on the same mazes
+struct DistanceFieldTiming {
+    int problemSize;     // N (maze cells)
+    double sequentialMs; // computeDistanceField
+    double parallelMs;   // computeDistanceFieldParallel
+    bool matches;        // the two fields agree on every cell
 };
 
 class BenchmarkManager {
@@ -165,16 +223,35 @@ public:
     bool isBenchmarkComplete() const { return benchmarkComplete_; }
     bool isPaused() const { return benchmarkPaused_; }
     
-    // (called each frame to update timing)
-    void update(float deltaTime);
+    // one race tick: advances the race clock by tickSeconds (a fixed tick, not the frame time)
+    void update(float tickSeconds);
     
-    // the agent arrival notification
+    // the agent arrival notification. lock free so parallel benchmark workers can call it
+    // directly - the counters land in getStats() on the next flushArrivals()
     void recordArrival(int speciesIndex, int agentId);
+    // sizes the arrival bitsets for agent ids [0, slotCount). must be called (serially)
+    // whenever agents are (re)created, arrivals with an id past the reserved range are dropped
+    void reserveArrivalSlots(int slotCount);
+    // publishes the atomic arrival counters into stats_ and assigns finish ranks (not thread safe)
+    void flushArrivals();
+
+    // per agent events for the streaming race log (EventLog.h), opened by startBenchmark when
+    // enabled and closed when the race completes. safe from the parallel workers, paths computed
+    // before the start (the setup) are held back and written once the log opens
+    void setEventLogEnabled(bool enabled) { eventLogEnabled_ = enabled; }
+    void recordPathComputed(int speciesIndex, int agentId, const PathResult& result, bool cached);
+    void recordExplorationStep(int speciesIndex, int agentId, GridCell cell, int visitedCells);
+    void recordRespawn(int speciesIndex, int agentId, GridCell cell);
+    // drops the held back setup paths of agents that are not in raceAgents (species, agent id):
+    // repacking, agent count and algorithm changes before the start replace or remove agents
+    void keepPendingPaths(const std::vector<std::pair<int, int>>& raceAgents);
     
     // statistics
     const std::vector<AlgorithmStats>& getStats() const { return stats_; }
     AlgorithmStats& getStatsMutable(int speciesIndex);
-    double getBenchmarkElapsedMs() const;
+    double getBenchmarkElapsedMs() const;  // race time (ticks * tick), what arrivals are timed in
+    double getBenchmarkWallMs() const;     // wall time the race took so far, pauses left out
+    std::uint64_t getRaceTicks() const { return raceTicks_; }
     int getTotalArrivals() const;
     int getTotalAgents() const;
     
@@ -200,11 +277,13 @@ public:
     // empirical doubling
     void runDoublingExperiment();
     const std::vector<DoublingResult>& getDoublingResults() const { return doublingResults_; }
+    const std::vector<BidirectionalTiming>& getBidirectionalTimings() const { return bidirectionalTimings_; }
+    const std::vector<DistanceFieldTiming>& getDistanceFieldTimings() const { return distanceFieldTimings_; }
     
     // rendering helpers
     void drawObstacles(sf::RenderTarget& target) const;
     void drawGoal(sf::RenderTarget& target) const;
-    void drawHUD(sf::RenderTarget& target, const sf::Font& font) const;
+    void drawHUD(sf::RenderTarget& target, const sf::Font& font);
     
     // updates agent counts for HUD display
     void updateAgentCounts(int newPerAlgo);
@@ -217,6 +296,8 @@ private:
     Pathfinder pathfinder_;
     std::vector<AlgorithmStats> stats_;
     std::vector<DoublingResult> doublingResults_;
+    std::vector<BidirectionalTiming> bidirectionalTimings_;
+    std::vector<DistanceFieldTiming> distanceFieldTimings_;
     std::vector<bool> algorithmEnabled_;  // which algorithms to show in HUD
     
     // benchmark state
@@ -226,6 +307,13 @@ private:
     std::chrono::high_resolution_clock::time_point benchmarkStartTime_;
     std::chrono::high_resolution_clock::time_point pauseStartTime_;
     double totalPausedTimeMs_ = 0.0;
+    double completedWallMs_ = 0.0;  // wall time frozen when the race completes
+    std::uint64_t raceTicks_ = 0;
+    double raceTimeMs_ = 0.0;
+
+    // event log
+    bool eventLogEnabled_ = false;
+    std::map<std::pair<int, int>, EventLog::Event> pendingPaths_;  // latest setup path per (species, agent), until the log opens
     
     // benchmark parameters
     int width_ = 800;
@@ -236,8 +324,17 @@ private:
     float spawnMargin_ = 50.0f;  // left margin for spawn area
     float goalMargin_ = 50.0f;   // right margin for goal
     
-    // track which agents have arrived (to prevent double counting)
-    std::unordered_map<int, std::unordered_set<int>> arrivedAgents_; // speciesIndex -> set of agentIds
+    // track which agents have arrived (to prevent double counting).
+    // one bit per agent id per species, set with fetch_or so a double arrival is detected
+    // without locks or hashing. atomics arent movable so each species lives behind a pointer
+    struct SpeciesArrivals {
+        std::unique_ptr<std::atomic<std::uint64_t>[]> arrivedBits;
+        size_t bitWords = 0;
+        std::atomic<int> arrivedCount{0};
+        ArrivalTimeHistogram histogram;
+    };
+    std::vector<std::unique_ptr<SpeciesArrivals>> arrivals_;
+    int arrivalSlots_ = 0;
     
     // maze settings
     Pathfinder::MazeType currentMazeType_ = Pathfinder::MazeType::MultiPath;
@@ -246,6 +343,15 @@ private:
     // ranking
     int nextRank_ = 1;
     
+    // retained hud layer (widget ids below, rows are consecutive ids from their base)
+    enum HudWidget {
+        HUD_BACKGROUND, HUD_TITLE, HUD_TIME, HUD_MAZE, HUD_MEMORY, HUD_HINTS, HUD_ALGORITHM_ROWS = HUD_HINTS + 2,
+        HUD_DOUBLING_BACKGROUND = HUD_ALGORITHM_ROWS + 16, HUD_DOUBLING_TITLE, HUD_DOUBLING_SUBTITLE,
+        HUD_DOUBLING_NOTES, HUD_DOUBLING_BIDIRECTIONAL = HUD_DOUBLING_NOTES + 8, HUD_DOUBLING_FIELD,
+        HUD_DOUBLING_ROWS
+    };
+    RetainedHud hud_;
+    
     // then shared exploration state per algorithm (for proper BFS/Dijkstra visualization)
     std::unordered_map<SimulationSettings::Algos, SharedExplorationState> sharedExplorationStates_;
     
@@ -261,6 +367,8 @@ public:
     
 private:
     void initializeStats();
-    void updateRankings();
+    void clearArrivals();
+    EventLog::Event makeEvent(EventLog::Type type, int speciesIndex, int agentId) const;
+    void openEventLog();
     std::string estimateBigO(double ratio) const;
 };
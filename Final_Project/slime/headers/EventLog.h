@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * streaming event log for benchmark races: one csv row per agent event (arrivals, computed paths,
+ * explorer steps, slime respawns), so distributions can be looked at offline instead of only the
+ * aggregates in AlgorithmStats.
+ *
+ * record() appends to a per thread chunk and returns, a full chunk is handed to a background writer
+ * that formats and writes it, so the agent step never waits on the disk. nothing is dropped: the
+ * writer keeps every handed over chunk until it is written. flush() hands over the partly filled
+ * chunk of every thread (pool workers stay alive between ticks) and waits until it is all on disk.
+ *
+ * summarize() is the loader: it reads a log back and builds per algorithm tables
+ * (slime --summarize <file> prints them)
+ */
+namespace EventLog
+{
+    enum class Type : std::uint8_t
+    {
+        Arrival,         // agent reached the goal
+        PathComputed,    // a pathfinder agent got its path (nodes, length, compute time)
+        ExplorationStep, // an explorer moved into a new cell (nodes = cells it has visited)
+        Respawn          // a slime died and came back at its spawn
+    };
+
+    struct Event
+    {
+        Type type;
+        std::int16_t species = -1;         // benchmark algorithm index
+        const char *algorithm = "";        // its name (static string)
+        std::int32_t agentId = -1;
+        std::uint64_t tick = 0;            // race tick
+        double raceMs = 0.0;               // race time (ticks * tick length)
+        std::int32_t cellX = -1, cellY = -1;
+        std::int32_t nodes = 0;
+        float pathLength = 0.0f;           // cells
+        float computeMs = 0.0f;
+        bool cached = false;               // path came from the spawn path cache (not searched again)
+    };
+
+    const char *typeName(Type type);
+
+    // starts a new log at path (header row first), closing the one before. false when the file cant be made
+    bool open(const std::string &path);
+    void close();
+    bool isOpen();
+
+    // hot path: cheap no-op when no log is open
+    void record(const Event &event);
+
+    void flush();
+
+    // events written to the current / last log
+    std::uint64_t written();
+
+    // loader: one row per algorithm and metric
+    struct SummaryRow
+    {
+        std::string algorithm;
+        std::string metric;
+        std::size_t count = 0;
+        double mean = 0.0, p50 = 0.0, p95 = 0.0, max = 0.0;
+    };
+    std::vector<SummaryRow> summarize(const std::string &path);
+    void printSummary(const std::vector<SummaryRow> &rows, std::ostream &out);
+}
@@ -0,0 +1,237 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * polynomial approximations for the transcendental calls that sit in per pixel / per agent loops
+ * (splat weights, trail intensity curve, specular shading, the sensing oscillator).
+ * scalar versions are inline here, the array versions in FastMath.cpp run 8 wide on AVX2,
+ * 4 wide on NEON and fall back to the scalar code otherwise (same polynomials, same results
+ * up to rounding of the last bit).
+ *
+ * error bounds against libm (checked by tests/FastMathTest.cpp):
+ *   exp(x)      x in [-87, 88]                          <= 4 ulp, exact 0 below -87.3
+ *   exp2(x)     x in [-126, 127]                        <= 4 ulp, exact 0 below -126
+ *   log2(x)     x > 0 (normal floats)                   <= 2e-7 absolute + 1 ulp of the result (the
+ *                                                       e + log2(m) sum rounds, 7.6e-6 near +-100)
+ *   pow(x, y)   x >= 0, 0 < y <= 32, result > 1e-30     <= 1e-5 relative (pow(0, y) = 0)
+ *               (the log2 error gets scaled by y, so the bound loosens with the exponent)
+ *   sin/cos(x)  |x| <= 8192                             <= 2e-7 absolute, larger |x| goes to libm
+ * for 8 bit color output all of these stay far below one level (the tests check that too)
+ *
+ * the bounds depend on the exact order and rounding of the float operations (the cody waite splits
+ * above all, which -ffast-math reassociates back into one multiply, and the horner steps, which fma
+ * contraction rounds differently), so everything in here is compiled without fast math and without
+ * contraction whatever the build flags are: per function on gcc, per operation on clang (so it also
+ * holds once inlined into a -ffast-math caller)
+ */
+#if defined(__clang__)
+#pragma float_control(precise, on, push)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("no-fast-math", "fp-contract=off")
+#endif
+
+namespace FastMath
+{
+    namespace detail
+    {
+        constexpr float LOG2E = 1.44269504088896341f;
+        constexpr float LN2_HI = 0.693359375f; // few mantissa bits so n * LN2_HI is exact
+        constexpr float LN2_LO = -2.12194440e-4f;
+        constexpr float LN2 = 0.693147180559945309f;
+        constexpr float TWO_OVER_PI = 0.636619772367581343f;
+        // pi/2 split in three (cody waite) for the sin/cos range reduction
+        constexpr float PIO2_1 = 1.5703125f;
+        constexpr float PIO2_2 = 4.837512969970703125e-4f;
+        constexpr float PIO2_3 = 7.54978995489188216e-8f;
+        constexpr float TRIG_MAX_ARG = 8192.0f;
+
+        inline float bitsToFloat(std::uint32_t bits)
+        {
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return f;
+        }
+        inline std::uint32_t floatToBits(float f)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        }
+
+        // e^r for |r| <= ln2/2, degree 6 taylor (truncation ~1.2e-7 relative at the ends)
+        inline float expPoly(float r)
+        {
+            float p = 1.0f / 720.0f;
+            p = p * r + 1.0f / 120.0f;
+            p = p * r + 1.0f / 24.0f;
+            p = p * r + 1.0f / 6.0f;
+            p = p * r + 0.5f;
+            p = p * r + 1.0f;
+            return p * r + 1.0f;
+        }
+
+        // 2^n for integer n in [-126, 127]
+        inline float pow2i(int n)
+        {
+            return bitsToFloat(static_cast<std::uint32_t>(n + 127) << 23);
+        }
+    }
+
+    inline float exp(float x)
+    {
+        if (x < -87.3f)
+            return 0.0f;
+        x = std::fmin(x, 88.0f);
+        const float n = std::floor(x * detail::LOG2E + 0.5f);
+        const float r = (x - n * detail::LN2_HI) - n * detail::LN2_LO;
+        return detail::expPoly(r) * detail::pow2i(static_cast<int>(n));
+    }
+
+    inline float exp2(float x)
+    {
+        if (x < -126.0f)
+            return 0.0f;
+        x = std::fmin(x, 127.0f);
+        const float n = std::floor(x + 0.5f);
+        return detail::expPoly((x - n) * detail::LN2) * detail::pow2i(static_cast<int>(n));
+    }
+
+    inline float log2(float x)
+    {
+        // split into mantissa m in [sqrt(1/2), sqrt(2)) and exponent e
+        std::uint32_t bits = detail::floatToBits(x);
+        int e = static_cast<int>((bits >> 23) & 0xff) - 127;
+        float m = detail::bitsToFloat((bits & 0x007fffffu) | 0x3f800000u);
+        if (m > 1.41421356f)
+        {
+            m *= 0.5f;
+            e += 1;
+        }
+        // ln(m) = 2 atanh(t), t = (m - 1) / (m + 1), |t| <= 0.1716
+        const float t = (m - 1.0f) / (m + 1.0f);
+        const float t2 = t * t;
+        float p = 1.0f / 9.0f;
+        p = p * t2 + 1.0f / 7.0f;
+        p = p * t2 + 1.0f / 5.0f;
+        p = p * t2 + 1.0f / 3.0f;
+        p = p * t2 + 1.0f;
+        return static_cast<float>(e) + 2.0f * t * p * detail::LOG2E;
+    }
+
+    // x >= 0, y > 0 (the shading curves), pow(0, y) = 0
+    inline float pow(float x, float y)
+    {
+        if (x <= 0.0f)
+            return 0.0f;
+        return exp2(y * log2(x));
+    }
+
+    namespace detail
+    {
+        // sin and cos of |r| <= pi/4
+        inline float sinPoly(float r)
+        {
+            const float r2 = r * r;
+            float p = 1.0f / 362880.0f;
+            p = p * r2 - 1.0f / 5040.0f;
+            p = p * r2 + 1.0f / 120.0f;
+            p = p * r2 - 1.0f / 6.0f;
+            return r + r * r2 * p;
+        }
+        inline float cosPoly(float r)
+        {
+            const float r2 = r * r;
+            float p = 1.0f / 40320.0f;
+            p = p * r2 - 1.0f / 720.0f;
+            p = p * r2 + 1.0f / 24.0f;
+            p = p * r2 - 0.5f;
+            return 1.0f + r2 * p;
+        }
+        // reduce x to r in [-pi/4, pi/4] and the quadrant
+        inline float reduceQuadrant(float x, int &quadrant)
+        {
+            const float j = std::floor(x * TWO_OVER_PI + 0.5f);
+            quadrant = static_cast<int>(j) & 3;
+            return ((x - j * PIO2_1) - j * PIO2_2) - j * PIO2_3;
+        }
+    }
+
+    inline float sin(float x)
+    {
+        if (std::fabs(x) > detail::TRIG_MAX_ARG)
+            return std::sin(x);
+        int q;
+        const float r = detail::reduceQuadrant(x, q);
+        switch (q)
+        {
+        case 0:
+            return detail::sinPoly(r);
+        case 1:
+            return detail::cosPoly(r);
+        case 2:
+            return -detail::sinPoly(r);
+        default:
+            return -detail::cosPoly(r);
+        }
+    }
+
+    inline float cos(float x)
+    {
+        if (std::fabs(x) > detail::TRIG_MAX_ARG)
+            return std::cos(x);
+        int q;
+        const float r = detail::reduceQuadrant(x, q);
+        switch (q)
+        {
+        case 0:
+            return detail::cosPoly(r);
+        case 1:
+            return -detail::sinPoly(r);
+        case 2:
+            return -detail::cosPoly(r);
+        default:
+            return detail::sinPoly(r);
+        }
+    }
+
+    // array versions (in place is fine: out may equal in)
+    void expArray(const float *in, float *out, size_t count);
+    void powArray(const float *in, float exponent, float *out, size_t count);
+
+    // libm or the approximations, picked per call site by the fastMath setting
+    inline float exp(float x, bool fast) { return fast ? FastMath::exp(x) : std::exp(x); }
+    inline float pow(float x, float y, bool fast) { return fast ? FastMath::pow(x, y) : std::pow(x, y); }
+    inline float sin(float x, bool fast) { return fast ? FastMath::sin(x) : std::sin(x); }
+    inline void expArray(const float *in, float *out, size_t count, bool fast)
+    {
+        if (fast)
+        {
+            expArray(in, out, count);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+            out[i] = std::exp(in[i]);
+    }
+    inline void powArray(const float *in, float exponent, float *out, size_t count, bool fast)
+    {
+        if (fast)
+        {
+            powArray(in, exponent, out, count);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+            out[i] = std::pow(in[i], exponent);
+    }
+
+}
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
@@ -0,0 +1,161 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MemoryTracker.h"
+
+class TrailMap;
+
+/**
+ * compressed recording of the raw trail field, for analysis that needs the values over time (a
+ * video only keeps colors). every stepInterval simulation steps the species channels are copied
+ * and handed to a writer thread, which does the rest off the simulation thread:
+ *  - quantize each channel to 8 or 16 bits over a per channel range
+ *  - keyframes: every keyframeInterval frames (or when a value leaves the keyframe's range) the
+ *    codes are predicted from their neighbours (med, as in lossless jpeg)
+ *  - the frames between are predicted either the same way or from the last keyframe, whichever
+ *    is cheaper per channel, never from another delta frame, so any frame decodes from two
+ *  - residuals are zigzagged, 16 bit ones split into a low and a high byte plane, and every plane
+ *    is rANS coded with its own frequency table
+ *
+ * file: header, frames, then an index (step + offset of every frame) so the reader can seek. a
+ * recording that was cut short (no index) is still readable, the reader rebuilds the index by
+ * walking the frames
+ */
+class FieldRecorder
+{
+public:
+    struct Options
+    {
+        int stepInterval = 60;     // simulation steps per recorded frame (1 frame/s at 60 steps/s)
+        int bits = 8;              // 8 or 16 bit quantization
+        int keyframeInterval = 64; // frames between keyframes
+    };
+
+    FieldRecorder() = default;
+    ~FieldRecorder();
+    FieldRecorder(const FieldRecorder &) = delete;
+    FieldRecorder &operator=(const FieldRecorder &) = delete;
+
+    // opens path and starts the writer. false when the file cant be made or already recording
+    bool start(const std::string &path, const Options &options, int width, int height, int channels);
+    // writes whatever is still queued, then the index
+    void stop();
+    bool isRecording() const { return recording_; }
+
+    // counts simulation steps and captures a frame once stepInterval of them have passed.
+    // only the copy of the channels happens here (blocks if the writer is several frames behind)
+    void onSteps(const TrailMap &trails, int steps);
+
+    std::uint64_t framesWritten() const;
+    std::uint64_t bytesWritten() const;
+    std::uint64_t rawBytes() const; // float32 size of what was recorded, for the compression ratio
+
+private:
+    struct Frame
+    {
+        std::uint64_t step = 0;
+        TrackedVector<float, MemoryTag::Recording> values; // channel after channel, stored values
+        std::vector<float> scales;                         // lazy decay scale per channel
+    };
+    struct IndexEntry
+    {
+        std::uint64_t step;
+        std::uint64_t offset;
+        bool keyframe;
+    };
+
+    void capture(const TrailMap &trails);
+    void run();
+    void encodeFrame(const Frame &frame);
+
+    Options options_;
+    int width_ = 0, height_ = 0, channels_ = 0;
+    bool recording_ = false;
+    std::uint64_t step_ = 0;
+    int stepsSinceFrame_ = 0;
+
+    // sim thread -> writer
+    static constexpr size_t MAX_QUEUED = 3;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable space_;
+    std::deque<std::unique_ptr<Frame>> queue_;
+    std::vector<std::unique_ptr<Frame>> spare_;
+    bool stop_ = false;
+    std::thread thread_;
+
+    // writer thread only
+    std::ofstream file_;
+    std::uint64_t offset_ = 0;
+    std::vector<IndexEntry> index_;
+    TrackedVector<std::uint16_t, MemoryTag::Recording> keyCodes_; // codes of the last keyframe
+    std::vector<float> keyLo_, keyHi_;                           // its ranges per channel
+    int framesSinceKey_ = 0;
+    std::vector<std::uint16_t> codes_;
+    std::vector<std::uint8_t> residual_, residualAlt_, planeBytes_;
+    std::vector<std::uint8_t> packed_;
+    std::string frameBytes_;
+
+    std::uint64_t framesWritten_ = 0; // under mutex_
+    std::uint64_t bytesWritten_ = 0;
+};
+
+// reads a recording back: any frame as real trail values, without running the simulation
+class FieldReader
+{
+public:
+    bool open(const std::string &path);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int channels() const { return channels_; }
+    int bits() const { return bits_; }
+    int stepInterval() const { return stepInterval_; }
+    size_t frameCount() const { return frames_.size(); }
+    std::uint64_t frameStep(size_t frame) const { return frames_[frame].step; }
+    // last frame recorded at or before step
+    size_t findFrame(std::uint64_t step) const;
+
+    // out = channels * width * height values, channel after channel. false if the frame is damaged
+    bool readFrame(size_t frame, std::vector<float> &out);
+
+private:
+    struct FrameInfo
+    {
+        std::uint64_t step;
+        std::uint64_t offset;
+        bool keyframe;
+        size_t keyframeIndex; // frame its residuals are against (itself for a keyframe)
+    };
+    struct DecodedFrame
+    {
+        bool keyframe = false;
+        std::vector<float> lo, hi;
+        std::vector<std::uint16_t> codes;
+    };
+
+    // key = the decoded keyframe a delta frame is against
+    bool decode(size_t frame, const DecodedFrame *key, DecodedFrame &out);
+    bool loadIndex();
+    bool scanFrames();
+
+    std::ifstream file_;
+    std::uint64_t fileSize_ = 0;
+    std::uint64_t dataStart_ = 0;
+    int width_ = 0, height_ = 0, channels_ = 0, bits_ = 8, stepInterval_ = 1;
+    std::vector<FrameInfo> frames_;
+
+    // the last keyframe stays decoded, so playing forward decodes one frame per frame
+    size_t cachedKey_ = SIZE_MAX;
+    DecodedFrame key_;
+    DecodedFrame scratch_;
+    std::string bytes_;
+    std::vector<std::uint8_t> residual_;
+};
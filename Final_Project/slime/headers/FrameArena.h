@@ -0,0 +1,64 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * frame scoped bump arena for the short lived containers of a step (neighbor lists, per species
+ * counters, futures lists, ...). every thread bumps through its own chain of 64KB blocks, so an
+ * allocation is a pointer add and never takes a lock. beginFrame() (once per rendered frame, from
+ * the main loop) starts a new frame and every thread's arena rewinds the next time it allocates,
+ * the blocks are kept so a steady frame doesnt go to the heap at all. freeing the last allocation
+ * gives its space back right away (a neighbor list per agent in a loop reuses the same bytes),
+ * anything else is only reclaimed at the frame boundary.
+ *
+ * contract: nothing allocated here may live past the frame it was made in (no members, no statics).
+ *
+ * FrameArena.cpp also replaces the global operator new/delete with a counting version, so
+ * heapAllocations() tells how many heap allocations a frame / step made
+ */
+namespace FrameArena
+{
+    // start a new frame: every arena rewinds on its next allocation (main thread, no jobs running)
+    void beginFrame();
+
+    void *allocate(std::size_t bytes, std::size_t alignment);
+    void deallocate(void *pointer, std::size_t bytes) noexcept;
+
+    // bytes the calling thread took from its arena this frame
+    std::size_t threadBytesUsed();
+
+    // heap allocations (operator new + arena blocks) since start, all threads
+    std::uint64_t heapAllocations();
+    // heap allocations between the last two beginFrame() calls (the whole last frame, draw included)
+    std::uint64_t lastFrameHeapAllocations();
+}
+
+// stateless std allocator on top of the calling thread's arena
+template <typename T>
+struct FrameAllocator
+{
+    using value_type = T;
+    using is_always_equal = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+
+    FrameAllocator() noexcept = default;
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n) { return static_cast<T *>(FrameArena::allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T *pointer, std::size_t n) noexcept { FrameArena::deallocate(pointer, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U> &) const noexcept { return true; }
+};
+
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+using FrameHashMap = std::unordered_map<Key, Value, Hash, std::equal_to<Key>, FrameAllocator<std::pair<const Key, Value>>>;
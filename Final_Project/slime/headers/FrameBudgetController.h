@@ -0,0 +1,65 @@
+#pragma once
+#include "SimulationSettings.h"
+#include <cstdint>
+
+/**
+ * fixed timestep scheduler + adaptive quality controller for the main loop
+ * the world advances in whole ticks (1 / tickRate seconds of sim time each) pulled off an
+ * accumulator so a slow frame runs extra ticks instead of slowing the world down.
+ * when the measured frame work stays over budget the controller steps down a quality ladder
+ * (blur cadence -> shading -> agent overlay -> fewer steps per tick) and climbs back up when
+ * there is headroom again
+ */
+class FrameBudgetController
+{
+public:
+    // what the simulation is allowed to do this frame
+    struct Quality
+    {
+        int stepsPerTick = 1;  // simulation steps per tick (requested stepsPerFrame, halved at the bottom levels)
+        int blurInterval = 2;  // apply the blur every N trail updates
+        bool allowShading = true;
+        bool allowOverlay = true;
+    };
+
+    struct Stats
+    {
+        std::uint64_t frames = 0;
+        std::uint64_t missedBudgets = 0; // frames whose work took longer than targetFrameMs
+        std::uint64_t droppedTicks = 0;  // ticks thrown away by the catch up limit
+        float avgFrameMs = 0.0f;         // smoothed frame work time
+        int qualityLevel = 0;            // 0 = full quality
+    };
+
+    explicit FrameBudgetController(const SimulationSettings::FrameBudgetSettings &settings = {});
+
+    void configure(const SimulationSettings::FrameBudgetSettings &settings);
+
+    // feeds the real frame delta, returns how many ticks to simulate this frame
+    int beginFrame(float realDeltaSeconds);
+    // feeds how long the frame work took (update + render, without the vsync/limit wait)
+    void endFrame(float workMs);
+
+    Quality getQuality(int requestedSteps) const;
+    float getTickSeconds() const { return tickSeconds_; }
+    const Stats &getStats() const { return stats_; }
+
+private:
+    static constexpr int MAX_QUALITY_LEVEL = 6;
+
+    SimulationSettings::FrameBudgetSettings settings_;
+    float tickSeconds_ = 1.0f / 60.0f;
+    float accumulator_ = 0.0f;
+
+    // hysteresis so the level doesnt flicker around the budget
+    int overBudgetFrames_ = 0;
+    int underBudgetFrames_ = 0;
+
+    // periodic console report of missed budgets
+    float reportTimer_ = 0.0f;
+    std::uint64_t reportedMisses_ = 0;
+    std::uint64_t reportedDrops_ = 0;
+    std::uint64_t reportFrames_ = 0;
+
+    Stats stats_;
+};
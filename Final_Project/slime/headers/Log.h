@@ -0,0 +1,109 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+
+/**
+ * async logger for diagnostics on the simulation / render paths.
+ * a log call formats into a fixed per thread buffer and pushes the line into that thread's lock free
+ * ring (single producer, the writer thread is the only consumer), then returns. a background writer
+ * drains all rings every few ms, orders the lines by time and does the actual console io, so a slow
+ * or attached terminal never stalls a frame. a full ring drops the line (counted and reported)
+ * instead of blocking.
+ *
+ *   SLIME_LOG(Log::Level::Info, "agents: " << count);
+ *   SLIME_LOG_EVERY(Log::Level::Warn, 1000, "out of bounds: " << y); // at most once a second per call site
+ *
+ * levels below SLIME_LOG_LEVEL are compiled out (the arguments arent even evaluated), e.g.
+ * -DSLIME_LOG_LEVEL=2 drops debug and trace. info and debug go to stdout, warn and error to stderr
+ */
+#ifndef SLIME_LOG_LEVEL
+#define SLIME_LOG_LEVEL 1 // debug
+#endif
+
+namespace Log
+{
+    enum class Level : int
+    {
+        Trace = 0,
+        Debug = 1,
+        Info = 2,
+        Warn = 3,
+        Error = 4
+    };
+
+    constexpr bool compiled(Level level) { return static_cast<int>(level) >= SLIME_LOG_LEVEL; }
+
+    // runtime threshold on top of the compile time one (default: everything that is compiled in)
+    void setLevel(Level level);
+    bool enabled(Level level);
+
+    // blocks until everything queued so far has been written
+    void flush();
+
+    // per call site rate limit: lets one line through per interval and counts what it swallowed,
+    // the next line that gets through reports that count
+    class RateLimit
+    {
+    public:
+        explicit RateLimit(int intervalMs) : intervalNs_(static_cast<std::int64_t>(intervalMs) * 1000000) {}
+
+        bool allow()
+        {
+            if (intervalNs_ <= 0)
+                return true;
+            const std::int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch())
+                                         .count();
+            std::int64_t next = nextNs_.load(std::memory_order_relaxed);
+            if (now >= next && nextNs_.compare_exchange_strong(next, now + intervalNs_, std::memory_order_relaxed))
+                return true;
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        std::uint32_t takeSuppressed() { return suppressed_.exchange(0, std::memory_order_relaxed); }
+
+    private:
+        std::int64_t intervalNs_;
+        std::atomic<std::int64_t> nextNs_{0};
+        std::atomic<std::uint32_t> suppressed_{0};
+    };
+
+    // for multi line reports built in a block: compiled in, enabled, and the site's interval is up
+    inline bool due(Level level, RateLimit &site) { return compiled(level) && enabled(level) && site.allow(); }
+
+    // one log line: stream into it, the destructor queues it
+    class Line
+    {
+    public:
+        Line(Level level, std::uint32_t suppressed);
+        ~Line();
+        Line(const Line &) = delete;
+        Line &operator=(const Line &) = delete;
+
+        std::ostream &stream() { return stream_; }
+
+    private:
+        Level level_;
+        std::uint32_t suppressed_;
+        std::ostream &stream_;
+    };
+}
+
+#define SLIME_LOG_EVERY(level, intervalMs, expr)                                          \
+    do                                                                                    \
+    {                                                                                     \
+        if constexpr (Log::compiled(level))                                               \
+        {                                                                                 \
+            static Log::RateLimit slimeLogSite_(intervalMs);                              \
+            if (Log::enabled(level) && slimeLogSite_.allow())                             \
+            {                                                                             \
+                Log::Line slimeLogLine_(level, slimeLogSite_.takeSuppressed());           \
+                slimeLogLine_.stream() << expr;                                           \
+            }                                                                             \
+        }                                                                                 \
+    } while (0)
+
+#define SLIME_LOG(level, expr) SLIME_LOG_EVERY(level, 0, expr)
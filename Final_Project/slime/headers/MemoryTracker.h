@@ -0,0 +1,114 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// what a tracked allocation belongs to (the hud and benchmark reports list these)
+enum class MemoryTag : int
+{
+    Agents,      // agents_ and the per agent path
+    Exploration, // explorer search state: per agent frontiers / visited sets and the benchmark's shared states
+    SpatialGrid, // hash grid cells
+    Pathfinder,  // obstacle grid and search workspaces
+    Trails,      // trail map channels
+    FrameArena,  // arena blocks (see FrameArena.h)
+    Recording,   // field recorder frames waiting for the writer (see FieldRecorder.h)
+    Count
+};
+
+/**
+ * per subsystem memory accounting: containers that use TrackedAllocator (or arrays made with
+ * makeTrackedArray) add their bytes to their tag's live count, peaks are kept per tag and for the
+ * total. counters are relaxed atomics, so it is safe from the worker threads.
+ *
+ * the optional budget is on the tracked total: the simulation stops population growth before it
+ * and pathfinder searches give up when they push past it (0 = no budget)
+ */
+namespace MemoryTracker
+{
+    void acquire(MemoryTag tag, std::size_t bytes);
+    void release(MemoryTag tag, std::size_t bytes);
+
+    std::size_t live(MemoryTag tag);
+    std::size_t peak(MemoryTag tag); // since start or the last resetPeak
+    void resetPeak(MemoryTag tag);
+    std::size_t totalLive();
+    std::size_t totalPeak();
+
+    const char *name(MemoryTag tag);
+
+    void setBudget(std::size_t bytes);
+    std::size_t budget();
+    bool overBudget();
+    // bytes left under the budget (SIZE_MAX without one, 0 when over it)
+    std::size_t headroom();
+
+    constexpr int TAG_COUNT = static_cast<int>(MemoryTag::Count);
+
+    // for the huds: MB rounded to 0.1, so a widget only relays out when the number it shows changes
+    inline double displayMB(std::size_t bytes) { return std::round(bytes / (1024.0 * 1024.0) * 10.0) / 10.0; }
+}
+
+// std allocator that counts into a tag. stateless, the tag is part of the type
+template <typename T, MemoryTag Tag>
+struct TrackedAllocator
+{
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = TrackedAllocator<U, Tag>;
+    };
+
+    TrackedAllocator() noexcept = default;
+    template <typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        T *pointer = std::allocator<T>().allocate(n);
+        MemoryTracker::acquire(Tag, n * sizeof(T));
+        return pointer;
+    }
+
+    void deallocate(T *pointer, std::size_t n) noexcept
+    {
+        MemoryTracker::release(Tag, n * sizeof(T));
+        std::allocator<T>().deallocate(pointer, n);
+    }
+
+    template <typename U>
+    bool operator==(const TrackedAllocator<U, Tag> &) const noexcept { return true; }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+// owning array (like unique_ptr<T[]>) counted into a tag, for the big flat buffers
+template <typename T, MemoryTag Tag>
+struct TrackedArrayDeleter
+{
+    std::size_t count = 0;
+    void operator()(T *pointer) const noexcept
+    {
+        MemoryTracker::release(Tag, count * sizeof(T));
+        delete[] pointer;
+    }
+};
+
+template <typename T, MemoryTag Tag>
+using TrackedArray = std::unique_ptr<T[], TrackedArrayDeleter<T, Tag>>;
+
+// value initialized like make_unique<T[]>
+template <typename T, MemoryTag Tag>
+TrackedArray<T, Tag> makeTrackedArray(std::size_t count)
+{
+    TrackedArray<T, Tag> array(new T[count](), TrackedArrayDeleter<T, Tag>{count});
+    MemoryTracker::acquire(Tag, count * sizeof(T));
+    return array;
+}
@@ -42,9 +42,9 @@ public:
 
     float sampleOptimized(float x, float y, int species, float selfAttraction, float otherAttraction) const;
     void depositOptimized(int x, int y, float amount, int species);
-    // oriented elliptical gaussian deposit aligned by angle (radians)
-    void depositAnisotropic(int centerX, int centerY, float angle, float sigmaParallel,
-                            float sigmaPerp, float amount, int species, int widthLimit, int heightLimit);
+    // oriented elliptical gaussian deposit aligned with a unit direction (the agent heading)
+    void depositAnisotropic(int centerX, int centerY, sf::Vector2f direction, float sigmaParallel,
+                            float sigmaPerp, float amount, int species, bool fastMath = false);
     void eraseOptimized(int x, int y, float amount, int species);
     void enhanceOptimized(int x, int y, float amount, int species);
     void diffuseOptimized(float diffuseRate) { diffuseSIMD(diffuseRate); }
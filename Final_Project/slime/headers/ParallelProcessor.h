@@ -1,10 +1,13 @@
 #pragma once
 #include <vector>
+#include <algorithm>
+#include <chrono>
 #include <thread>
 #include <future>
 #include <functional>
 #include <type_traits>
 #include "Agent.h"
+#include "FrameArena.h"
 
 // TODO: restructure to change this forward declaration
 class TrailMap;
@@ -49,14 +52,14 @@ public:
     void parallelFor(Iterator begin, Iterator end, Function &&func);
 
     // specialized agent operations
-    void parallelAgentUpdate(std::vector<Agent> &agents, const SimulationSettings &settings);
-    void parallelAgentSensing(std::vector<Agent> &agents, TrailMap &trailMap, const SimulationSettings &settings);
-    void parallelAgentMovement(std::vector<Agent> &agents, const SimulationSettings &settings);
-    void parallelAgentDeposition(std::vector<Agent> &agents, TrailMap &trailMap, const SimulationSettings &settings);
+    void parallelAgentUpdate(AgentVector &agents, const SimulationSettings &settings);
+    void parallelAgentSensing(AgentVector &agents, TrailMap &trailMap, const SimulationSettings &settings);
+    void parallelAgentMovement(AgentVector &agents, const SimulationSettings &settings);
+    void parallelAgentDeposition(AgentVector &agents, TrailMap &trailMap, const SimulationSettings &settings);
 
     // new optimized methods for high performance systems
     template <typename Function>
-    void processAgentsParallel(std::vector<Agent> &agents, Function &&func)
+    void processAgentsParallel(AgentVector &agents, Function &&func)
     {
         if (agents.empty())
             return;
@@ -67,7 +70,7 @@ public:
         auto start = std::chrono::high_resolution_clock::now();
 
         // create futures for parallel execution
-        std::vector<std::future<void>> futures;
+        FrameVector<std::future<void>> futures;
         futures.reserve(numThreads_);
 
         for (size_t threadId = 0; threadId < numThreads_; ++threadId)
@@ -102,6 +105,50 @@ public:
         metrics_.maxExecutionTime = std::max(metrics_.maxExecutionTime, execTime);
         metrics_.minExecutionTime = (metrics_.minExecutionTime == 0.0) ? execTime : std::min(metrics_.minExecutionTime, execTime);
     }
+
+    // index range version of the above: func(startIdx, endIdx) is called once per chunk.
+    // used when the work isnt a plain agent vector (benchmark batches, trail rows, channels)
+    template <typename Function>
+    void processRangeParallel(size_t count, Function &&func)
+    {
+        if (count == 0)
+            return;
+
+        const size_t chunkSize = calculateChunkSize(count, policy_);
+
+        // too little work to be worth spinning up threads
+        if (count <= chunkSize || numThreads_ <= 1)
+        {
+            func(static_cast<size_t>(0), count);
+            return;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        FrameVector<std::future<void>> futures;
+        futures.reserve(numThreads_);
+
+        for (size_t startIdx = 0; startIdx < count; startIdx += chunkSize)
+        {
+            size_t endIdx = std::min(startIdx + chunkSize, count);
+            futures.emplace_back(std::async(std::launch::async, [&func, startIdx, endIdx]()
+                                            { func(startIdx, endIdx); }));
+        }
+
+        for (auto &future : futures)
+        {
+            future.wait();
+        }
+
+        auto end = std::chrono::high_resolution_clock::now();
+        double execTime = std::chrono::duration<double, std::milli>(end - start).count();
+
+        metrics_.totalOperations++;
+        metrics_.avgExecutionTime = (metrics_.avgExecutionTime * (metrics_.totalOperations - 1) + execTime) / metrics_.totalOperations;
+        metrics_.maxExecutionTime = std::max(metrics_.maxExecutionTime, execTime);
+        metrics_.minExecutionTime = (metrics_.minExecutionTime == 0.0) ? execTime : std::min(metrics_.minExecutionTime, execTime);
+    }
+
     void processTrailsParallel(class OptimizedTrailMap &trailMap, float diffuseRate, float decayRate);
 
     // trail processing
@@ -2,13 +2,17 @@
 #include <vector>
 #include <queue>
 #include <stack>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 #include <cmath>
+#include <cstdint>
 #include <algorithm>
 #include <chrono>
 #include <functional>
 #include "SimulationSettings.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
 
 // grid cell coordinates
 struct GridCell {
@@ -40,6 +44,105 @@ struct GridCellHash {
     }
 };
 
+// search state containers counted into a MemoryTag (see MemoryTracker.h)
+template <typename Value, MemoryTag Tag>
+using TrackedCellMap = std::unordered_map<GridCell, Value, GridCellHash, std::equal_to<GridCell>,
+                                          TrackedAllocator<std::pair<const GridCell, Value>, Tag>>;
+template <MemoryTag Tag>
+using TrackedCellSet = std::unordered_set<GridCell, GridCellHash, std::equal_to<GridCell>, TrackedAllocator<GridCell, Tag>>;
+template <MemoryTag Tag>
+using TrackedCellDeque = std::deque<GridCell, TrackedAllocator<GridCell, Tag>>;
+
+/**
+ * compact path for the agents: the first cell plus 32 bit tokens for the rest, instead of 8 bytes
+ * per cell. most paths are chains of unit octile steps, those pack as 3 bit direction codes (8 per
+ * word) and straight stretches collapse into one run word. waypoints that are not a unit step away
+ * (jps jumps, theta* / simplified any-angle corners) get an absolute cell word, so every path
+ * still round trips exactly.
+ *
+ * indexing decodes lazily through a cursor kept in the path, walking forward (what followPath
+ * does) is O(1) per waypoint, going back restarts from the first cell. the cursor is mutable, so
+ * one path must not be read from two threads at once (agents are only touched by their own job)
+ */
+class CompactPath {
+public:
+    void push_back(const GridCell& cell);
+    void assign(const std::vector<GridCell>& cells);  // encodes and trims the storage
+    void clear();
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    const GridCell& front() const { return first_; }
+    const GridCell& back() const { return last_; }
+
+    GridCell operator[](size_t index) const {
+        if (index < cursor_.index)
+            rewind();
+        while (cursor_.index < index)
+            step();
+        return cursor_.cell;
+    }
+
+    size_t memoryBytes() const { return sizeof(CompactPath) + words_.capacity() * sizeof(uint32_t); }
+
+private:
+    // token kind in the top 2 bits
+    static constexpr uint32_t STEPS = 0u << 30;  // bits 29-27: count - 1, bits 23-0: up to 8 direction codes, first in the low bits
+    static constexpr uint32_t RUN = 1u << 30;    // bits 29-27: direction code, bits 26-0: number of steps
+    static constexpr uint32_t CELL = 2u << 30;   // bits 29-15: x, bits 14-0: y (absolute, grids up to 32768 cells a side)
+    static constexpr uint32_t KIND_MASK = 3u << 30;
+    static constexpr uint32_t MAX_RUN = (1u << 27) - 1;
+
+    // octile direction codes, counter clockwise from +x
+    static constexpr int DIR_X[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+    static constexpr int DIR_Y[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+    struct Cursor {
+        GridCell cell{0, 0};
+        size_t index = 0;   // waypoint the cursor is on
+        uint32_t word = 0;  // token that leads to the next waypoint
+        uint32_t offset = 0; // steps of that token already taken
+    };
+
+    void rewind() const { cursor_ = {first_, 0, 0, 0}; }
+
+    // move the cursor one waypoint on
+    void step() const {
+        const uint32_t word = words_[cursor_.word];
+        uint32_t tokenLength = 1;
+        switch (word & KIND_MASK) {
+        case STEPS: {
+            const uint32_t code = (word >> (3 * cursor_.offset)) & 7u;
+            cursor_.cell.x += DIR_X[code];
+            cursor_.cell.y += DIR_Y[code];
+            tokenLength = ((word >> 27) & 7u) + 1;
+            break;
+        }
+        case RUN: {
+            const uint32_t code = (word >> 27) & 7u;
+            cursor_.cell.x += DIR_X[code];
+            cursor_.cell.y += DIR_Y[code];
+            tokenLength = word & MAX_RUN;
+            break;
+        }
+        default:
+            cursor_.cell = {static_cast<int>((word >> 15) & 0x7fffu), static_cast<int>(word & 0x7fffu)};
+            break;
+        }
+        ++cursor_.index;
+        if (++cursor_.offset == tokenLength) {
+            ++cursor_.word;
+            cursor_.offset = 0;
+        }
+    }
+
+    GridCell first_{0, 0};
+    GridCell last_{0, 0};
+    size_t size_ = 0;
+    TrackedVector<uint32_t, MemoryTag::Agents> words_;
+    mutable Cursor cursor_;
+};
+
 // result of a pathfinding operation
 struct PathResult {
     std::vector<GridCell> path;          // the path from start to goal
@@ -109,6 +212,7 @@ public:
     PathResult findPathAStar(const GridCell& start, const GridCell& goal);
     PathResult findPathGreedy(const GridCell& start, const GridCell& goal);
     PathResult findPathBidirectional(const GridCell& start, const GridCell& goal);
+    PathResult findPathBidirectionalParallel(const GridCell& start, const GridCell& goal);  // both directions at once on two threads, hop optimal
     PathResult findPathDFS(const GridCell& start, const GridCell& goal);
     PathResult findPathDijkstra(const GridCell& start, const GridCell& goal);
     PathResult findPathJPS(const GridCell& start, const GridCell& goal);
@@ -118,22 +222,30 @@ public:
     PathResult findPath(SimulationSettings::Algos algo, const GridCell& start, const GridCell& goal);
     PathResult findPath(SimulationSettings::Algos algo, float startX, float startY, float goalX, float goalY);
     
+    // whole map distance fields (flow fields, goal beacons, analysis): flat, index y * gridWidth + x,
+    // octile costs (1 and sqrt 2), infinity where the source cant reach
+    using DistanceField = TrackedVector<float, MemoryTag::Pathfinder>;
+    DistanceField computeDistanceField(const GridCell& source) const;  // sequential dijkstra
+    // delta stepping on threadCount threads (0 = all cores). delta is the bucket width: edges up to
+    // delta are relaxed while a bucket fills, longer ones once it is settled
+    DistanceField computeDistanceFieldParallel(const GridCell& source, float delta = 1.5f, unsigned threadCount = 0) const;
+    
     // path utilities
-    std::vector<GridCell> simplifyPath(const std::vector<GridCell>& path) const;
+    void simplifyPath(const std::vector<GridCell>& path, CompactPath& out) const; // line of sight corners, encoded straight into out
     
     // utility
     float heuristic(const GridCell& a, const GridCell& b) const;
     float euclideanDistance(const GridCell& a, const GridCell& b) const;
     float manhattanDistance(const GridCell& a, const GridCell& b) const;
     bool lineOfSight(const GridCell& a, const GridCell& b) const;
-    std::vector<GridCell> getNeighbors(const GridCell& cell, bool allowDiagonal = true) const;
+    FrameVector<GridCell> getNeighbors(const GridCell& cell, bool allowDiagonal = true) const; // frame arena, dont keep it
     
 private:
     int worldWidth_, worldHeight_;      // world dimensions in pixels
     int cellSize_;                      // size of each grid cell in pixels
     int gridWidth_, gridHeight_;        // grid dimensions in cells
     
-    std::vector<bool> blocked_;         // blocked cells (true = obstacle)
+    TrackedVector<bool, MemoryTag::Pathfinder> blocked_; // blocked cells (true = obstacle)
     std::vector<Obstacle> obstacles_;   // list of obstacles for rendering
     
     // helper to get the flat index from grid coordinates
@@ -146,12 +258,15 @@ private:
     
     // reconstruct path from came_from map
     std::vector<GridCell> reconstructPath(
-        const std::unordered_map<GridCell, GridCell, GridCellHash>& cameFrom,
+        const TrackedCellMap<GridCell, MemoryTag::Pathfinder>& cameFrom,
         const GridCell& start, const GridCell& goal);
     
     // calculate path length
     float calculatePathLength(const std::vector<GridCell>& path) const;
     
+    // search loops stop here when the memory budget is blown (MemoryTracker.h)
+    bool overMemoryBudget(int nodesExpanded) const;
+    
     // JPS helpers
     GridCell jump(const GridCell& current, int dx, int dy, const GridCell& goal);
     std::vector<GridCell> getJPSNeighbors(const GridCell& current, const GridCell& parent);
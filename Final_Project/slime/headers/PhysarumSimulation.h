@@ -8,9 +8,14 @@
 #include "OptimizedTrailMap.h"
 #include "FoodPellet.h"
 #include "BenchmarkManager.h"
+#include "RetainedHud.h"
+#include "FieldRecorder.h"
 #include <vector>
 #include <memory>
 #include <optional>
+#include <future>
+#include <cstdint>
+#include <array>
 
 class PhysarumSimulation
 {
@@ -20,12 +25,20 @@ public:
 
     // core simulation methods
     void update(float deltaTime);
+    // fixed timestep path: run `ticks` ticks of `stepsPerTick` steps each, then refreshDisplay once per
+    // rendered frame
+    void simulateTicks(int ticks, int stepsPerTick);
+    void refreshDisplay();
+    // quality knobs driven by the frame budget controller (blur cadence, shading, agent overlay)
+    void setQualityOverrides(int blurInterval, bool allowShading, bool allowOverlay);
     void reset();
     // void draw(sf::renderwindow &window);
     void draw(sf::RenderWindow &window, sf::Font &font);
 
     // settings management
-    void updateSettings(const SimulationSettings &newSettings);
+    // speciesSources[i] = the old species index that new species i continues (-1 = brand new species).
+    // leave empty to keep species in their current slots
+    void updateSettings(const SimulationSettings &newSettings, const std::vector<int> &speciesSources = {});
     const SimulationSettings &getSettings() const { return settings_; }
 
     // agent management
@@ -45,6 +58,28 @@ public:
     // performance tracking
     float getLastUpdateTime() const { return lastUpdateTime_; }
 
+    // trail texture uploads: only tiles whose 8 bit colors changed since the last upload get sent
+    struct DisplayUploadStats
+    {
+        std::uint64_t bytesLastFrame = 0;
+        int dirtyTilesLastFrame = 0;
+        int totalTiles = 0;
+        std::uint64_t totalBytes = 0; // since the display was (re)initialized
+    };
+    const DisplayUploadStats &getDisplayUploadStats() const { return uploadStats_; }
+
+    // agents per level of detail after the last agent update (index = Agent::lodLevel)
+    const std::array<int, Agent::MAX_LOD_LEVEL + 1> &getAgentLodCounts() const { return agentLodCounts_; }
+
+    // camera over the world (worlds larger than the window): pan by a screen space drag, zoom about a
+    // screen point (factor < 1 zooms in), reset = whole world in view
+    void panCamera(sf::Vector2f screenDelta);
+    void zoomCamera(float factor, sf::Vector2i screenAnchor);
+    void resetCamera();
+    sf::Vector2f screenToWorld(sf::Vector2i screen) const;
+    sf::Vector2f worldToScreen(sf::Vector2f world) const;
+    float getCameraZoom() const { return cameraZoom_; }
+
     // tree visualization methods
     void setTreeVisualizationMode(bool showNodes, bool showConnections, bool showAgents);
     bool isTreeVisualizationEnabled() const;
@@ -59,12 +94,21 @@ public:
     bool isAllUIHidden() const { return hideAllUI_; }
     bool isAgentOverlayEnabled() const { return showAgentOverlay_; }
 
+    // compressed recording of the trail field (FieldRecorder.h) to field_<time>.slfr, every
+    // settings.fieldRecording.stepInterval steps until stopped
+    bool startFieldRecording();
+    void stopFieldRecording();
+    bool isRecordingField() const { return fieldRecorder_.isRecording(); }
+    const FieldRecorder& getFieldRecorder() const { return fieldRecorder_; }
+
     // Algorithm Benchmark Mode
     void enterBenchmarkMode();
     void exitBenchmarkMode();
     bool isInBenchmarkMode() const { return inBenchmarkMode_; }
     void updateBenchmark(float deltaTime);
     void startBenchmark();
+    // runs the race without drawing until it completes (or maxTicks race ticks), returns the ticks it ran
+    int runBenchmarkHeadless(int maxTicks);
     void pauseBenchmark();
     void resetBenchmark();
     void adjustBenchmarkAgentCount(int delta);  // dynamic agent count adjustment
@@ -74,9 +118,20 @@ public:
     bool isBenchmarkPacked() const { return benchmarkAgentsPacked_; }
     void toggleBenchmarkAlgorithm(int algoIndex);  // toggle for algorithm group on/off (0-6)
 
+    // per step breakdown of what the benchmark agents did (replaces the old periodic console census)
+    struct BenchmarkStepCounts
+    {
+        int explorers = 0;
+        int pathfinders = 0;
+        int slimes = 0;
+        int arrived = 0;
+        int noPath = 0;
+    };
+    const BenchmarkStepCounts& getBenchmarkStepCounts() const { return benchmarkStepCounts_; }
+
 private:
     SimulationSettings settings_;
-    std::vector<Agent> agents_;
+    AgentVector agents_;
     std::unique_ptr<TrailMap> trailMap_;
 
     // food pellet system
@@ -97,6 +152,28 @@ private:
     sf::Texture displayTexture_;
     std::optional<sf::Sprite> displaySprite_;
 
+    // what the display texture currently holds (rgba, same layout as the image) for the dirty tile
+    // compare, plus a scratch buffer a run of dirty tiles gets packed into for one sub rect upload
+    std::vector<std::uint8_t> uploadedPixels_;
+    std::vector<std::uint8_t> tileUploadScratch_;
+    DisplayUploadStats uploadStats_;
+
+    // camera: world point at the middle of the view and world cells per screen pixel. the display
+    // image is viewWidth_ x viewHeight_ (settings_.viewWidth/Height, or the world size when unset)
+    sf::Vector2f cameraCenter_{0.0f, 0.0f};
+    float cameraZoom_ = 1.0f;
+    int viewWidth_ = 0;
+    int viewHeight_ = 0;
+
+    // retained hud layer for the overlay text. pellet i uses HUD_PELLET_LABELS + 2i (+1 = its background)
+    enum HudWidget
+    {
+        HUD_AUDIT,
+        HUD_DEATHS,
+        HUD_PELLET_LABELS
+    };
+    RetainedHud hud_;
+
     // agent overlay components
     sf::Texture agentOverlayTexture_;
     std::optional<sf::Sprite> agentOverlaySprite_;
@@ -106,6 +183,12 @@ private:
     float lastUpdateTime_ = 0.0f;
     sf::Clock updateTimer_;
 
+    // frame budget quality overrides
+    int blurInterval_ = 2;
+    int blurCounter_ = 0;
+    bool allowShading_ = true;
+    bool allowOverlay_ = true;
+
     // audit counters (debug): track events per frame
     std::uint64_t auditSplits_ = 0;
     std::uint64_t auditMatingsSame_ = 0;
@@ -113,6 +196,23 @@ private:
     std::uint64_t auditRebirths_ = 0;
     std::uint64_t auditSpores_ = 0;
     std::uint64_t auditDeaths_ = 0;
+    std::uint64_t heapAllocsPerStep_ = 0; // heap allocations of the last simulateTicks / steps it ran
+
+    FieldRecorder fieldRecorder_;
+
+    // morton order agent sorting: the order is built in the background while the trails update
+    // (that stage never touches agents_), then applied before the next agent update
+    std::vector<std::uint64_t> agentSortKeys_; // (z-order key << 32) | old slot
+    std::vector<std::uint32_t> agentSortOrder_; // new slot i <- old slot agentSortOrder_[i]
+    int stepsSinceAgentSort_ = 0;
+    float sortedJumpBaseline_ = 0.0f;          // locality metric right after the last sort (0 = not sorted yet)
+
+    // agent level of detail: step counter the sense schedule runs on, and the census of the last update
+    std::uint32_t lodStep_ = 0;
+    std::array<int, Agent::MAX_LOD_LEVEL + 1> agentLodCounts_{};
+
+    // sensing prefetch lookahead actually in use (-1 = not picked yet, see tunePrefetchDistance)
+    int prefetchDistance_ = -1;
 
     // cumulative per species death tracking (persists across frames)
     std::vector<std::uint64_t> cumulativeDeathsPerSpecies_;
@@ -140,6 +240,13 @@ private:
     sf::Vector2f benchmarkPackPoint_{0.0f, 0.0f};
     std::vector<bool> benchmarkAlgorithmEnabled_;  // track which algorithms are enabled (persists across resets)
 
+    // benchmark step scratch - sized once and reused every frame so the hot loop doesnt allocate
+    std::vector<std::vector<size_t>> benchmarkChannelBatches_; // agent indices grouped by trail channel (= algorithm)
+    std::vector<std::uint8_t> benchmarkStepFlags_;             // what each agent did this step (see BenchmarkStepFlag)
+    std::vector<float> benchmarkSlimeDeposit_;                 // staged slime deposit strength per agent
+    std::vector<float> benchmarkGoalStamp_;                    // cached falloff disk for the goal food beacon
+    BenchmarkStepCounts benchmarkStepCounts_;
+
     // helper methods
     void initializeDisplay();
     void updateAgents();
@@ -147,10 +254,30 @@ private:
     void updateAgentsOptimized();
     void updateTrailsOptimized();
     void updateDisplay();
+    void uploadDirtyTiles(const sf::Image &image);
     void setupDisplaySprite();
     void overlayBuffers();
     void updateAgentOverlayTexture();
 
     void validateSettings();
+    size_t populationCap() const; // most agents allowed: 2x the start count, lower when the memory budget says so
+    // senses once or skips (level of detail), returns whether it sensed. sense = the actual sensing call
+    template <typename SenseFn>
+    bool senseWithLod(Agent &agent, size_t slot, SenseFn &&sense);
+    void promoteAgentsNear(float x, float y, float radius); // back to full detail around an event
+    float maxCameraZoom() const; // zoom that fits the whole world
+    void clampCamera();
+    TrailMap::Viewport cameraViewport() const;
+    sf::View cameraView() const; // world space view for shapes drawn straight into the window
+    bool agentSortDue();
+    std::future<void> startAgentSort();
+    void finishAgentSort(std::future<void> &job);
+    float agentLocalityJump() const; // mean distance between consecutive agents (sampled)
+    int sensingPrefetchDistance();   // setting, or the tuned value when the setting is auto
+    int tunePrefetchDistance() const;
+    void remapAgents(const std::vector<int> &sources, int oldSpecies, int oldWidth, int oldHeight);
+    ParallelProcessor *parallelPool(); // lazily created worker pool, nullptr when parallel updates are off
     void respawnBenchmarkSlime(Agent &agent);
+    void stepBenchmarkTick(int diffusionThreads); // one race tick: agents, then the trail diffusion / decay
+    void stampBenchmarkGoalFood(int goalX, int goalY, int goalFoodChannel);
 };
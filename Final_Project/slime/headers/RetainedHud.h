@@ -0,0 +1,178 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * what a hud text widget prints. the widget runs its content twice at most: first into a key pass
+ * that only hashes the values (no formatting), and into a text pass (a normal ostringstream) only
+ * when that hash changed. so content code looks like the old `oss << ...` code, just with `out`
+ */
+class HudWriter
+{
+public:
+    template <typename T>
+    HudWriter &operator<<(const T &value)
+    {
+        if (text_)
+        {
+            *text_ << value;
+            return *this;
+        }
+        using V = std::decay_t<T>;
+        if constexpr (std::is_same_v<V, const char *> || std::is_same_v<V, char *>)
+        {
+            const std::string_view s = value;
+            mix(s.data(), s.size());
+        }
+        else if constexpr (std::is_arithmetic_v<V> || std::is_enum_v<V> || std::is_pointer_v<V>)
+        {
+            const V v = value;
+            mix(&v, sizeof(v));
+        }
+        else if constexpr (std::is_convertible_v<const T &, std::string_view>)
+        {
+            const std::string_view s = value;
+            mix(s.data(), s.size());
+        }
+        // anything else is a stream manipulator (fixed, setprecision, setw): it changes how values
+        // print, not which values, so there is nothing to hash
+        return *this;
+    }
+
+    std::uint64_t key() const { return key_; }
+
+private:
+    friend class RetainedHud;
+    explicit HudWriter(std::ostringstream *text) : text_(text) {}
+
+    void mix(const void *data, size_t size)
+    {
+        // fnv-1a
+        const auto *bytes = static_cast<const std::uint8_t *>(data);
+        for (size_t i = 0; i < size; ++i)
+            key_ = (key_ ^ bytes[i]) * 1099511628211ull;
+        key_ = (key_ ^ size) * 1099511628211ull; // so "ab","c" and "a","bc" differ
+    }
+
+    std::ostringstream *text_;
+    std::uint64_t key_ = 1469598103934665603ull;
+};
+
+/**
+ * retained hud layer: text widgets keep their glyph geometry and only lay out again when the values
+ * they print change (rate limited per widget for numbers that change every frame), background rects
+ * are plain quads. everything goes out as one triangle batch per font page (one page per character
+ * size, so a hud with one text size is one draw call), and the batches are only rebuilt when a
+ * widget changed, moved, appeared or disappeared.
+ *
+ * usage per frame: beginFrame(font), then text()/place()/rect() for what is on screen this frame
+ * (widgets that arent touched are hidden), then draw(). ids are picked by the caller and only need
+ * to be unique within one RetainedHud. backgrounds always go under all of the text
+ */
+class RetainedHud
+{
+public:
+    struct TextStyle
+    {
+        unsigned characterSize = 12;
+        sf::Color fillColor = sf::Color::White;
+        sf::Color outlineColor = sf::Color::Black;
+        float outlineThickness = 0.0f;
+        bool bold = false;
+        float refreshSeconds = 0.0f; // min time between relayouts (0 = relayout on every change)
+    };
+
+    void beginFrame(const sf::Font &font);
+
+    // refreshes text widget `id` from content(HudWriter &), returns its local bounds (like
+    // sf::Text::getLocalBounds). the text is utf-8
+    template <typename Content>
+    sf::FloatRect text(int id, const TextStyle &style, Content &&content);
+    void place(int id, sf::Vector2f position);
+    void rect(int id, const sf::FloatRect &bounds, sf::Color fill, float outlineThickness = 0.0f,
+              sf::Color outlineColor = sf::Color::Transparent);
+
+    void draw(sf::RenderTarget &target);
+
+    // glyph layouts since construction (stays flat while the hud shows steady values)
+    std::uint64_t getLayoutCount() const { return layoutCount_; }
+
+private:
+    struct Widget
+    {
+        bool isText = false;
+        bool hasContent = false;
+        TextStyle style;
+        std::uint64_t key = 0;
+        float lastLayoutSeconds = 0.0f;
+        std::string text;
+        std::vector<sf::Vertex> vertices; // text: outline then fill glyphs, relative to position
+        sf::FloatRect bounds;
+        sf::Vector2f position;
+        // rect widgets
+        sf::FloatRect rect;
+        sf::Color fill;
+        sf::Color outlineColor;
+        float outlineThickness = 0.0f;
+    };
+
+    struct Batch
+    {
+        unsigned characterSize = 0; // picks the font page texture
+        std::vector<sf::Vertex> vertices;
+    };
+
+    const sf::Font *font_ = nullptr;
+    std::unordered_map<int, Widget> widgets_;
+    std::vector<int> frameOrder_;  // widgets touched this frame, in order
+    std::vector<int> builtOrder_;  // what the batches were last built from
+    std::vector<Batch> batches_;
+    bool dirty_ = true;
+    sf::Clock clock_;
+    std::uint64_t layoutCount_ = 0;
+
+    Widget &touch(int id, bool isText);
+    void layout(Widget &widget);
+    void rebuildBatches();
+    static bool sameStyle(const TextStyle &a, const TextStyle &b);
+};
+
+template <typename Content>
+sf::FloatRect RetainedHud::text(int id, const TextStyle &style, Content &&content)
+{
+    Widget &widget = touch(id, true);
+
+    HudWriter keyPass(nullptr);
+    content(keyPass);
+
+    const bool styleChanged = !widget.hasContent || !sameStyle(style, widget.style);
+    if (!styleChanged && keyPass.key() == widget.key)
+        return widget.bounds;
+
+    const float now = clock_.getElapsedTime().asSeconds();
+    if (!styleChanged && now - widget.lastLayoutSeconds < style.refreshSeconds)
+        return widget.bounds; // stale for a moment, the next frame after the interval picks it up
+
+    std::ostringstream oss;
+    HudWriter textPass(&oss);
+    content(textPass);
+
+    widget.key = keyPass.key();
+    widget.lastLayoutSeconds = now;
+    std::string text = oss.str();
+    if (styleChanged || text != widget.text)
+    {
+        widget.style = style;
+        widget.text = std::move(text);
+        widget.hasContent = true;
+        layout(widget);
+    }
+    return widget.bounds;
+}
@@ -80,9 +80,30 @@ public:
 
     // simulation settings
     int stepsPerFrame = 1;
-    int width = 800;
+    int width = 800;  // world size (trail grid), can be much larger than the window
     int height = 600;
+    // display resolution the world is viewed at through the pan / zoom camera (0 = same as the world).
+    // only the visible part gets converted and uploaded, so display cost follows this, not the world
+    int viewWidth = 0;
+    int viewHeight = 0;
+    bool viewMeanDownsample = false; // zoomed out: average the cells under a pixel instead of the max
     int numAgents = 50000;
+    // agents get re-sorted into z-order (morton) of their position so neighbours in memory sense and
+    // deposit in neighbouring trail memory. every agentSortInterval steps (0 = never) or sooner when
+    // the average jump between consecutive agents grows past agentSortDegradeFactor x the sorted value
+    int agentSortInterval = 240;
+    float agentSortDegradeFactor = 3.0f;
+    // how many agents ahead the sensing loop prefetches trail cells (0 = off, -1 = measure on this machine
+    // at the first update and pick the fastest)
+    int sensingPrefetchDistance = -1;
+    // agent level of detail: agents that went agentLodStableSteps senses without turning sense only
+    // every 2nd, then every 4th step (see Agent::lodLevel)
+    bool agentLodEnabled = true;
+    int agentLodStableSteps = 8;
+
+    // memory budget over the tracked subsystems (MemoryTracker.h), 0 = no budget. near it population
+    // growth stops, past it pathfinder searches give up
+    int memoryBudgetMB = 0;
 
     enum class SpawnMode
     {
@@ -106,9 +127,30 @@ public:
         int pathCellSize = 8;              // grid cell size for pathfinding (larger = faster)
         float mazeDensity = 0.6f;          // maze wall density (0.0-1.0)
         bool useMazeLayout = true;         // use maze style walls instead of random blocks in previous rough version
+        float raceTickSeconds = 1.0f / 60.0f; // race time per benchmark tick (arrival times are counted in ticks, not wall time)
+        int raceTicksPerTick = 1;          // benchmark ticks per simulation tick (> 1 races faster than real time, same results)
+        bool eventLog = true;              // stream per agent race events to benchmark_events_<time>.csv (see EventLog.h)
     };
     BenchmarkSettings benchmarkSettings;
 
+    // frame pacing: the world advances in fixed ticks and a controller trades quality for frame time
+    struct FrameBudgetSettings {
+        bool fixedTimestep = true;     // run whole ticks off an accumulator instead of one update per rendered frame
+        float tickRate = 60.0f;        // simulation ticks per second (one tick = stepsPerFrame steps)
+        int maxTicksPerFrame = 4;      // catch up limit so one slow frame cant snowball into slower ones
+        bool adaptiveQuality = true;   // let the controller back off blur/shading/overlay/steps when over budget
+        float targetFrameMs = 16.67f;  // work time per frame the controller tries to hold (60 fps)
+    };
+    FrameBudgetSettings frameBudget;
+
+    // trail field recording (FieldRecorder.h)
+    struct FieldRecordingSettings {
+        int stepInterval = 60;      // simulation steps per recorded frame (1 frame/s at the default 60 ticks of 1 step)
+        int bits = 8;               // quantization, 8 or 16 bits per cell and channel
+        int keyframeInterval = 64;  // recorded frames between keyframes (the rest are differences from one)
+    };
+    FieldRecordingSettings fieldRecording;
+
     // trail settings
     float trailWeight = 9.0f;
     float decayRate = 0.01f;
@@ -116,6 +158,9 @@ public:
     float displayThreshold = 0.1f;
     bool blurEnabled = true;         // enable gentle blur for smoother trails
     bool slimeShadingEnabled = false; // post process slime shading (cpu) toggle
+    bool lazyDecayEnabled = true;     // decay as a per channel scale factor instead of a full grid sweep
+    bool implicitDiffusion = false;   // ADI diffusion once per tick (stable at any rate) instead of explicit 3x3 every step
+    bool fastMath = true;             // polynomial exp/pow/sin in splats, shading and sensing (FastMath.h, error bounds there)
     // motion smoothing/inertia for squishier movement (0=no smoothing, 0.95=very heavy)
     float motionInertia = 0.15f;
 
@@ -3,9 +3,9 @@
 #include <vector>
 #include <unordered_map>
 #include <cmath>
-
-// TODO: restructure to change this forward declaration
-struct Agent;
+#include "FrameArena.h"
+#include "Agent.h"
+#include "MemoryTracker.h"
 
 /**
  * high performance spatial hash grid for O(1) neighbor lookup
@@ -19,9 +19,12 @@ public:
     static constexpr float CELL_SIZE = 50.0f;
     static constexpr size_t ESTIMATED_AGENTS_PER_CELL = 16;
 
+    // cells and their index lists count under MemoryTag::SpatialGrid
+    using IndexList = TrackedVector<size_t, MemoryTag::SpatialGrid>;
+
     struct Cell
     {
-        std::vector<size_t> agentIndices;
+        IndexList agentIndices;
 
         Cell()
         {
@@ -40,7 +43,9 @@ public:
     };
 
 private:
-    std::unordered_map<uint64_t, Cell> cells_;
+    std::unordered_map<uint64_t, Cell, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                       TrackedAllocator<std::pair<const uint64_t, Cell>, MemoryTag::SpatialGrid>>
+        cells_;
     int width_;
     int height_;
     float invCellSize_; // precomputed for faster division
@@ -69,15 +74,16 @@ public:
     // core operations
     void clear();
     void insertAgent(size_t agentIndex, float x, float y);
-    void rebuild(const std::vector<Agent> &agents);
+    void rebuild(const AgentVector &agents);
 
     // neighbor queries (the performance magic happens here)
-    std::vector<size_t> getNeighbors(float x, float y, float radius) const;
-    std::vector<size_t> getNeighborsInCell(float x, float y) const;
+    // (results live in the frame arena: use them within the step, dont keep them)
+    FrameVector<size_t> getNeighbors(float x, float y, float radius) const;
+    FrameVector<size_t> getNeighborsInCell(float x, float y) const;
 
     // optimized queries for common agent operations
-    std::vector<size_t> getSensingNeighbors(float x, float y, float sensorDistance) const;
-    std::vector<size_t> getNearbyAgents(float x, float y, float radius) const; // alias for compatibility
+    FrameVector<size_t> getSensingNeighbors(float x, float y, float sensorDistance) const;
+    FrameVector<size_t> getNearbyAgents(float x, float y, float radius) const; // alias for compatibility
 
     // statistics and debugging
     size_t getCellCount() const { return cells_.size(); }
@@ -1,6 +1,22 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
+#include <span>
+#include "MemoryTracker.h"
+#include <vector>
+
+// which part of the world a display image shows: output pixel (px, py) covers the world rect
+// starting at (originX + px * scale, originY + py * scale), scale cells wide. scale > 1 is zoomed
+// out and reduces every cell under the pixel (max keeps thin trails visible, mean is smoother),
+// scale <= 1 magnifies (nearest cell). the default is 1:1 from the top left corner
+// (outside the class so it can be a default argument of TrailMap's own members)
+struct TrailViewport
+{
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float scale = 1.0f;
+    bool meanReduce = false;
+};
 
 class TrailMap
 {
@@ -25,20 +41,44 @@ public:
     void deposit(int x, int y, float amount, int speciesIndex);
     float sampleSpeciesInteraction(int x, int y, int currentSpecies,
                                    float selfAttraction, float otherAttraction) const;
+    // prefetch hint for every species channel at (x, y): the sensing loops issue it a few agents
+    // ahead so the random sensor reads are already on their way from dram when they are needed
+    void prefetch(int x, int y) const;
+
+    // incremental reconfiguration - keeps the existing trails instead of rebuilding the map
+    void remapSpecies(const std::vector<int> &sourceChannels); // channel i takes old channel sourceChannels[i] (-1 = new empty channel)
+    void resize(int newWidth, int newHeight);                  // bilinear resample of every channel to the new size
 
     // processing
     void diffuse(float diffuseRate);
+    // unconditionally stable alternating direction implicit diffusion: one backward euler
+    // tridiagonal solve along rows then columns. `steps` explicit diffuse() calls worth of spreading
+    // in one pass. wrapEdges = cyclic (torus) boundary, otherwise clamped (no flux through the edge)
+    void diffuseImplicit(float diffuseRate, int steps, bool wrapEdges, int numThreads = 0);
     void decay(float decayRate);
     void applyBlur();
 
-    // display
-    void updateTexture(sf::Image &image, float displayThreshold, const sf::Color &baseColor) const;
+    using Viewport = TrailViewport;
+
+    // display (fastMath = polynomial pow for the intensity curve, see FastMath.h). the image size is the
+    // output resolution, only the cells inside the viewport are read
+    void updateTexture(sf::Image &image, float displayThreshold, const sf::Color &baseColor, bool fastMath = false,
+                       const Viewport &view = {}) const;
     void updateMultiSpeciesTexture(sf::Image &image, float displayThreshold,
-                                   const std::vector<sf::Color> &speciesColors) const;
+                                   std::span<const sf::Color> speciesColors, bool fastMath = false,
+                                   const Viewport &view = {}) const;
+
+    // lazy decay: decay() only shrinks a per channel scale factor instead of sweeping the grid.
+    // stored values are trail / scale, every read multiplies the scale back in
+    void setLazyDecay(bool enabled);
+    bool isLazyDecay() const { return lazyDecay_; }
+    float getChannelScale(int species = 0) const { return species < numSpecies_ ? channelScale_[species] : 1.0f; }
 
     // accessors
     int getNumSpecies() const { return numSpecies_; }
-    float *getData(int species = 0) { return species < numSpecies_ ? speciesData_[species].get() : nullptr; }
+    // raw pointer access folds the pending scale into the channel first so callers see real values
+    float *getData(int species = 0);
+    // stored (unscaled) values - multiply by getChannelScale(species) for the real trail
     const float *getData(int species = 0) const { return species < numSpecies_ ? speciesData_[species].get() : nullptr; }
 
     // GPU data transfer methods
@@ -48,13 +88,48 @@ public:
 
 private:
     int width_, height_, numSpecies_;
-    std::vector<std::unique_ptr<float[]>> speciesData_;     // one trail map per species
-    std::vector<std::unique_ptr<float[]>> tempSpeciesData_; // for diffusion calculations
+    using Channel = TrackedArray<float, MemoryTag::Trails>;
+    std::vector<Channel> speciesData_;     // one trail map per species
+    std::vector<Channel> tempSpeciesData_; // for diffusion calculations
+
+    // lazy decay state per channel (scale and 1/scale so deposits dont divide)
+    bool lazyDecay_ = true;
+    std::vector<float> channelScale_;
+    std::vector<float> channelInvScale_;
+
+    // per species inner loops specialized on the channel count: the usual 1, 3, 5 and 8 species get
+    // a compile time trip count (unrolled, branch free selects instead of per species ifs), N = 0 is
+    // the generic run time count. picked once in selectKernels() whenever the channel count changes
+    template <int N>
+    static float sampleInteractionKernel(const TrailMap &map, int idx, int species,
+                                         float attractionToSelf, float attractionToOthers);
+    template <int N>
+    static float eatAnyKernel(TrailMap &map, int idx, int excludeSpecies, float maxBite);
+    template <int N>
+    static void composeRowKernel(const TrailMap &map, int width, const float *normalizedRows, const float *intensityRows,
+                                 const float *thresholds, const float *colorRGB, sf::Image &image, int y);
+    template <int N>
+    void useKernels();
+    void selectKernels();
+
+    float (*sampleInteractionFn_)(const TrailMap &, int, int, float, float) = nullptr;
+    float (*eatAnyFn_)(TrailMap &, int, int, float) = nullptr;
+    void (*composeRowFn_)(const TrailMap &, int, const float *, const float *, const float *, const float *,
+                          sf::Image &, int) = nullptr;
+
+    // display scratch reused across frames: reduced view per species, one vertically reduced world row,
+    // and the world column span of every output column
+    mutable std::vector<float> viewValues_;
+    mutable std::vector<float> viewReduceRow_;
+    mutable std::vector<int> viewColumns_;
+    // fills out[outW * outH] with the stored values of one channel as seen through the viewport
+    void reduceView(int species, const Viewport &view, int outW, int outH, float *out) const;
 
     // helper methods
     bool isValidCoordinate(int x, int y) const;
     int getIndex(int x, int y) const;
     void swapBuffers();
+    void settleScale(int species); // multiply the pending scale into the stored values, scale back to 1
 
     // box blur functions for improved diffusion (based on a very helpful go reference)
     // https://github.com/fogleman/physarum
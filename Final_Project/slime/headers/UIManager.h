@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "SimulationSettings.h"
+#include "RetainedHud.h"
 #include <functional>
 
 class UIManager
@@ -33,6 +34,14 @@ private:
     bool showParameterEditor_ = false;
     bool showHelp_ = false;
 
+    // retained hud layer for drawHUD
+    enum HudWidget
+    {
+        HUD_BACKGROUND,
+        HUD_TEXT
+    };
+    RetainedHud hud_;
+
     // ui styling
     sf::Color hudBackgroundColor_ = sf::Color(0, 0, 0, 150);
     sf::Color hudTextColor_ = sf::Color::White;
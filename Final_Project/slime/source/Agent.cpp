@@ -1,9 +1,11 @@
 #include "Agent.h"
+#include "ParallelProcessor.h"
 #include "TrailMap.h"
 #include "SpatialGrid.h"
 #include "OptimizedTrailMap.h"
 #include "PhysarumSimulation.h"
 #include "FoodPellet.h"
+#include "FastMath.h"
 #include <cmath>
 #include <random>
 #include <algorithm>
@@ -11,6 +13,7 @@
 #include <iostream>
 #include <unordered_map>
 #include <map>
+#include <array>
 
 // for float pi to avoid double promotion warnings
 static constexpr float M_PIf = 3.14159265358979323846f;
@@ -187,6 +190,26 @@ void Agent::applyGenomeToCachedParams(const SimulationSettings &settings)
 
 static float clampf(float v, float lo, float hi) { return std::max(lo, std::min(hi, v)); }
 
+// unit vectors for n evenly spaced headings (n <= 32), built once so the pattern deposits
+// dont run sin/cos on the same fixed angles every step
+static const sf::Vector2f *circleDirections(int n)
+{
+    static const std::vector<std::vector<sf::Vector2f>> tables = []
+    {
+        std::vector<std::vector<sf::Vector2f>> t(33);
+        for (int count = 1; count <= 32; ++count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                float a = (2.0f * M_PIf * i) / count;
+                t[count].emplace_back(std::cos(a), std::sin(a));
+            }
+        }
+        return t;
+    }();
+    return tables[std::clamp(n, 1, 32)].data();
+}
+
 Agent Agent::createOffspring(const Agent &a, const Agent &b, const SimulationSettings &settings)
 {
     // place child near mid point
@@ -285,6 +308,101 @@ Agent::LifeEvent Agent::updateEnergyAndState(const SimulationSettings &settings)
     return LifeEvent::None;
 }
 
+void Agent::resetSharedBehaviorState()
+{
+    {
+        std::lock_guard<std::mutex> lock(alien_mutex);
+        alienSpeedPhases.clear();
+        alienSpeedModes.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(anti_alien_mutex);
+        antiAlienSpeedPhases.clear();
+        antiAlienSpeedModes.clear();
+        antiAlienSpeedCounters.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(parasitic_mutex);
+        parasiticSpeedPhases.clear();
+        parasiticHuntModes.clear();
+        parasiticBurstCounters.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(death_bringer_mutex);
+        deathSpeedPhases.clear();
+        deathRageModes.clear();
+        deathRageBuildup.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock(guardian_mutex);
+        guardianSpeedPhases.clear();
+        guardianProtectionModes.clear();
+        guardianDutyLevel.clear();
+    }
+}
+
+namespace
+{
+    // rekeys one address keyed map for a reorder of [base, base + count) agents, entries for
+    // agents outside that range (other vectors, temporaries) are kept as they are
+    template <typename Map>
+    void permuteAddressKeys(Map &map, size_t base, size_t count, const std::vector<std::uint32_t> &order)
+    {
+        if (map.empty())
+            return;
+        const size_t stride = sizeof(Agent);
+        const size_t end = base + count * stride;
+        Map moved;
+        moved.reserve(map.size());
+        for (const auto &entry : map)
+        {
+            if (entry.first < base || entry.first >= end)
+                moved.emplace(entry);
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto it = map.find(base + static_cast<size_t>(order[i]) * stride);
+            if (it != map.end())
+                moved.emplace(base + i * stride, it->second);
+        }
+        map.swap(moved);
+    }
+}
+
+void Agent::permuteSharedBehaviorState(const Agent *base, size_t count, const std::vector<std::uint32_t> &order)
+{
+    const size_t baseKey = reinterpret_cast<size_t>(base);
+    {
+        std::lock_guard<std::mutex> lock(alien_mutex);
+        permuteAddressKeys(alienSpeedPhases, baseKey, count, order);
+        permuteAddressKeys(alienSpeedModes, baseKey, count, order);
+    }
+    {
+        std::lock_guard<std::mutex> lock(anti_alien_mutex);
+        permuteAddressKeys(antiAlienSpeedPhases, baseKey, count, order);
+        permuteAddressKeys(antiAlienSpeedModes, baseKey, count, order);
+        permuteAddressKeys(antiAlienSpeedCounters, baseKey, count, order);
+    }
+    {
+        std::lock_guard<std::mutex> lock(parasitic_mutex);
+        permuteAddressKeys(parasiticSpeedPhases, baseKey, count, order);
+        permuteAddressKeys(parasiticHuntModes, baseKey, count, order);
+        permuteAddressKeys(parasiticBurstCounters, baseKey, count, order);
+    }
+    {
+        std::lock_guard<std::mutex> lock(death_bringer_mutex);
+        permuteAddressKeys(deathSpeedPhases, baseKey, count, order);
+        permuteAddressKeys(deathRageModes, baseKey, count, order);
+        permuteAddressKeys(deathRageBuildup, baseKey, count, order);
+    }
+    {
+        std::lock_guard<std::mutex> lock(guardian_mutex);
+        permuteAddressKeys(guardianSpeedPhases, baseKey, count, order);
+        permuteAddressKeys(guardianProtectionModes, baseKey, count, order);
+        permuteAddressKeys(guardianDutyLevel, baseKey, count, order);
+    }
+}
+
 Agent::~Agent()
 {
     // cleans up all per agent state from the static maps when this agent is destroyed
@@ -781,12 +899,10 @@ void Agent::move(const SimulationSettings &settings)
     // apply heading inertia/compliance for squishier motion
     applyInertia(settings);
 
-    // using sincosf for better throughput on apple platforms
-    float s, c;
-    s = std::sinf(angle);
-    c = std::cosf(angle);
-    position.x += moveSpeed * c;
-    position.y += moveSpeed * s;
+    // heading vector, only pays for a sincos when the angle actually moved since the last step
+    const sf::Vector2f &dir = heading();
+    position.x += moveSpeed * dir.x;
+    position.y += moveSpeed * dir.y;
 
     wrapPosition(settings.width, settings.height);
 }
@@ -798,24 +914,16 @@ void Agent::sense(const float *chemoattractant, int width, int height, const Sim
 
     const auto &species = settings.speciesSettings[speciesIndex];
 
-    // for applying genome scaling to sensor angle
-    float sensorAngleRad = species.sensorAngleSpacing * (hasGenome ? genome.sensorAngleScale : 1.0f) * M_PI / 180.0f;
-    float leftAngle = angle - sensorAngleRad;
-    float rightAngle = angle + sensorAngleRad;
+    // for applying genome scaling to sensor angle (rotation only recomputed when the spacing changes)
+    sensorRotation.set(species.sensorAngleSpacing * (hasGenome ? genome.sensorAngleScale : 1.0f) * M_PIf / 180.0f);
 
     // and for genome scaling to sensor distance
     float sensorDist = species.sensorOffsetDistance * (hasGenome ? genome.sensorDistScale : 1.0f);
 
-    // calculate sensor positions
-    sf::Vector2f forwardPos = position + sf::Vector2f(
-                                             sensorDist * std::cos(angle),
-                                             sensorDist * std::sin(angle));
-    sf::Vector2f leftPos = position + sf::Vector2f(
-                                          sensorDist * std::cos(leftAngle),
-                                          sensorDist * std::sin(leftAngle));
-    sf::Vector2f rightPos = position + sf::Vector2f(
-                                           sensorDist * std::cos(rightAngle),
-                                           sensorDist * std::sin(rightAngle));
+    // calculate sensor positions by rotating the heading vector
+    sf::Vector2f forwardPos = position + heading() * sensorDist;
+    sf::Vector2f leftPos = position + rotatedHeading(sensorRotation, -1.0f) * sensorDist;
+    sf::Vector2f rightPos = position + rotatedHeading(sensorRotation, 1.0f) * sensorDist;
 
     // sample Chemoattractant at sensor positions
     float forward = sampleChemoattractant(chemoattractant,
@@ -826,7 +934,7 @@ void Agent::sense(const float *chemoattractant, int width, int height, const Sim
                                         static_cast<int>(rightPos.x), static_cast<int>(rightPos.y), width, height);
 
     // make movement decision
-    float turnSpeedRad = species.turnSpeed * M_PI / 180.0f;
+    turnRotation.set(species.turnSpeed * M_PIf / 180.0f);
 
     if (forward > left && forward > right)
     {
@@ -838,15 +946,15 @@ void Agent::sense(const float *chemoattractant, int width, int height, const Sim
         static std::random_device rd;
         static std::mt19937 gen(rd());
         static std::uniform_int_distribution<> dis(0, 1);
-        angle += (dis(gen) == 0 ? -1 : 1) * turnSpeedRad;
+        turnBy(turnRotation, dis(gen) == 0 ? -1.0f : 1.0f);
     }
     else if (left > right)
     {
-        angle -= turnSpeedRad;
+        turnBy(turnRotation, -1.0f);
     }
     else if (right > left)
     {
-        angle += turnSpeedRad;
+        turnBy(turnRotation, 1.0f);
     }
 }
 
@@ -858,22 +966,14 @@ void Agent::senseMultiSpecies(TrailMap &trailMap, const SimulationSettings &sett
 
     const auto &species = settings.speciesSettings[speciesIndex];
 
-    float sensorAngleRad = species.sensorAngleSpacing * (hasGenome ? genome.sensorAngleScale : 1.0f) * M_PI / 180.0f;
-    float leftAngle = angle - sensorAngleRad;
-    float rightAngle = angle + sensorAngleRad;
+    sensorRotation.set(species.sensorAngleSpacing * (hasGenome ? genome.sensorAngleScale : 1.0f) * M_PIf / 180.0f);
 
     float sensorDist = species.sensorOffsetDistance * (hasGenome ? genome.sensorDistScale : 1.0f);
 
-    // calculate sensor positions
-    sf::Vector2f forwardPos = position + sf::Vector2f(
-                                             sensorDist * std::cos(angle),
-                                             sensorDist * std::sin(angle));
-    sf::Vector2f leftPos = position + sf::Vector2f(
-                                          sensorDist * std::cos(leftAngle),
-                                          sensorDist * std::sin(leftAngle));
-    sf::Vector2f rightPos = position + sf::Vector2f(
-                                           sensorDist * std::cos(rightAngle),
-                                           sensorDist * std::sin(rightAngle));
+    // calculate sensor positions by rotating the heading vector
+    sf::Vector2f forwardPos = position + heading() * sensorDist;
+    sf::Vector2f leftPos = position + rotatedHeading(sensorRotation, -1.0f) * sensorDist;
+    sf::Vector2f rightPos = position + rotatedHeading(sensorRotation, 1.0f) * sensorDist;
 
 
     // yellow species: quantum alien - truly alien, incomprehensible behavior
@@ -950,13 +1050,10 @@ void Agent::senseMultiSpecies(TrailMap &trailMap, const SimulationSettings &sett
         {
             // continue forward - no turn needed
         }
-        else if (left > right)
-        {
-            angle -= species.turnSpeed * M_PI / 180.0f;
-        }
         else
         {
-            angle += species.turnSpeed * M_PI / 180.0f;
+            turnRotation.set(species.turnSpeed * M_PIf / 180.0f);
+            turnBy(turnRotation, left > right ? -1.0f : 1.0f);
         }
     }
     else
@@ -980,6 +1077,12 @@ void Agent::deposit(float *chemoattractant, int width, int height, const Simulat
     }
 }
 
+void Agent::deposit(TrailMap &trailMap, const SimulationSettings &settings)
+{
+    // through the map so the amount gets divided by the channel's pending decay scale
+    trailMap.deposit(static_cast<int>(position.x), static_cast<int>(position.y), settings.trailWeight, 0);
+}
+
 // a simple direct deposit for benchmark mode - creates THICK, visible trails.
 // uses a 7x7 deposit pattern with concentric rings of decreasing strength
 // so it can create smooth, visible trails that persist long enough for pathfinding comparison.
@@ -1081,7 +1184,7 @@ void Agent::depositMultiSpecies(TrailMap &trailMap, const SimulationSettings &se
         else if (isRedSpecies)
         {
             // red species: predators deposit thin trails, relying on hunting others' trails.
-            depositThickTrail(trailMap, x, y, baseTrailStrength * 0.7f, 1);
+            depositThickTrail(trailMap, x, y, baseTrailStrength * 0.7f, 1, settings.fastMath);
         }
         else if (isBlueSpecies)
         {
@@ -1112,8 +1215,9 @@ void Agent::depositMultiSpecies(TrailMap &trailMap, const SimulationSettings &se
 // helper method for thick arterial trails (red species).
 // creates a circular deposit with gaussian falloff - strongest at center, fading smoothly at edges.
 // radius controls the size of the deposit footprint.
-void Agent::depositThickTrail(TrailMap &trailMap, int centerX, int centerY, float strength, int radius)
+void Agent::depositThickTrail(TrailMap &trailMap, int centerX, int centerY, float strength, int radius, bool fastMath)
 {
+    const float invRadiusSq = 1.0f / static_cast<float>(radius * radius);
     // iterate over a square region centered on (centerX, centerY)
     for (int dy = -radius; dy <= radius; ++dy)
     {
@@ -1124,13 +1228,13 @@ void Agent::depositThickTrail(TrailMap &trailMap, int centerX, int centerY, floa
 
             if (x >= 0 && x < trailMap.getWidth() && y >= 0 && y < trailMap.getHeight())
             {
-                // only deposit within circular radius (skipping corners of square)
-                float distance = std::sqrt(dx * dx + dy * dy);
-                if (distance <= radius)
+                // only deposit within circular radius (skipping corners of square), squared so no sqrt
+                int distanceSq = dx * dx + dy * dy;
+                if (distanceSq <= radius * radius)
                 {
                     // gaussian falloff: e^(-d^2/r^2) gives smooth decay from center.
                     // center gets full strength, edge gets ~37%ish strength.
-                    float falloff = std::exp(-distance * distance / (radius * radius));
+                    float falloff = FastMath::exp(-distanceSq * invRadiusSq, fastMath);
                     trailMap.deposit(x, y, strength * falloff, speciesIndex);
                 }
             }
@@ -1152,13 +1256,13 @@ void Agent::depositNetworkPattern(TrailMap &trailMap, int centerX, int centerY,
 
     // extend connections in 8 directions: N, NE, E, SE, S, SW, W, NW.
     // each direction creates a short trail segment to build network connectivity.
+    const sf::Vector2f *directions = circleDirections(8);
     for (int i = 0; i < 8; ++i)
     {
-        float angle = i * M_PI / 4.0f;
         for (int dist = 1; dist <= 3; ++dist)
         {
-            int x = centerX + static_cast<int>(std::cos(angle) * dist);
-            int y = centerY + static_cast<int>(std::sin(angle) * dist);
+            int x = centerX + static_cast<int>(directions[i].x * dist);
+            int y = centerY + static_cast<int>(directions[i].y * dist);
 
             if (x >= 0 && x < trailMap.getWidth() && y >= 0 && y < trailMap.getHeight())
             {
@@ -1240,11 +1344,11 @@ void Agent::depositRadialPattern(TrailMap &trailMap, int centerX, int centerY, f
         {
             // more sample points for larger radii to maintain smooth circles
             int points = radius * 8;
+            const sf::Vector2f *directions = circleDirections(points);
             for (int i = 0; i < points; ++i)
             {
-                float angle = (2.0f * M_PI * i) / points;
-                int x = centerX + static_cast<int>(std::cos(angle) * radius);
-                int y = centerY + static_cast<int>(std::sin(angle) * radius);
+                int x = centerX + static_cast<int>(directions[i].x * radius);
+                int y = centerY + static_cast<int>(directions[i].y * radius);
 
                 if (x >= 0 && x < trailMap.getWidth() && y >= 0 && y < trailMap.getHeight())
                 {
@@ -1313,7 +1417,7 @@ void Agent::depositAlienPattern(TrailMap &trailMap, int centerX, int centerY, fl
     case 2: // phase shifting - periodic intense bursts
         if ((alienCounters[agentId] % 10) < 3)
         {
-            depositThickTrail(trailMap, centerX, centerY, strength * 3.0f, 3);
+            depositThickTrail(trailMap, centerX, centerY, strength * 3.0f, 3, settings.fastMath);
         }
         break;
 
@@ -1382,13 +1486,14 @@ void Agent::depositParasiticPattern(TrailMap &trailMap, int centerX, int centerY
         // create spreading tentacle-like patterns
         for (int i = 0; i < 6; ++i)
         {
-            float angle = (i * M_PI / 3.0f) + parasiticRand(gen) * 0.5f;
+            float angle = (i * M_PIf / 3.0f) + parasiticRand(gen) * 0.5f;
             int length = 2 + static_cast<int>(parasiticRand(gen) * 4);
+            const sf::Vector2f dir(std::cos(angle), std::sin(angle)); // once per tentacle, not per pixel
 
             for (int j = 1; j <= length; ++j)
             {
-                int x = centerX + static_cast<int>(std::cos(angle) * j);
-                int y = centerY + static_cast<int>(std::sin(angle) * j);
+                int x = centerX + static_cast<int>(dir.x * j);
+                int y = centerY + static_cast<int>(dir.y * j);
 
                 if (x >= 0 && x < trailMap.getWidth() && y >= 0 && y < trailMap.getHeight())
                 {
@@ -1537,15 +1642,25 @@ void Agent::depositDestructivePattern(TrailMap &trailMap, int centerX, int cente
         float spiralRadius = 4.0f;
         int numSpokes = 6;
 
+        // spiral twist of i * 0.3 rad per step, same for every spoke so it is a fixed table
+        static const std::array<sf::Vector2f, 5> twists = []
+        {
+            std::array<sf::Vector2f, 5> t{};
+            for (int i = 0; i < 5; ++i)
+                t[i] = sf::Vector2f(std::cos(i * 0.3f), std::sin(i * 0.3f));
+            return t;
+        }();
+        const sf::Vector2f *spokes = circleDirections(numSpokes);
+
         for (int spoke = 0; spoke < numSpokes; ++spoke)
         {
-            float baseAngle = (spoke * 2.0f * M_PI) / numSpokes;
+            const sf::Vector2f base = spokes[spoke];
 
             for (int i = 1; i <= 4; ++i)
             {
-                float angle = baseAngle + (i * 0.3f); // spiral twist
-                int x = centerX + static_cast<int>(std::cos(angle) * i);
-                int y = centerY + static_cast<int>(std::sin(angle) * i);
+                const sf::Vector2f &tw = twists[i];
+                int x = centerX + static_cast<int>((base.x * tw.x - base.y * tw.y) * i);
+                int y = centerY + static_cast<int>((base.x * tw.y + base.y * tw.x) * i);
 
                 if (x >= 0 && x < trailMap.getWidth() && y >= 0 && y < trailMap.getHeight())
                 {
@@ -1630,14 +1745,13 @@ void Agent::depositProtectivePattern(TrailMap &trailMap, int centerX, int center
         float nurtureRadius = 2.5f;
         int numFlows = 8;
 
+        const sf::Vector2f *flows = circleDirections(numFlows);
         for (int flow = 0; flow < numFlows; ++flow)
         {
-            float angle = (flow * 2.0f * M_PI) / numFlows;
-
             for (int i = 1; i <= 3; ++i)
             {
-                float x = centerX + std::cos(angle) * i * 0.8f;
-                float y = centerY + std::sin(angle) * i * 0.8f;
+                float x = centerX + flows[flow].x * i * 0.8f;
+                float y = centerY + flows[flow].y * i * 0.8f;
 
                 int pixelX = static_cast<int>(x);
                 int pixelY = static_cast<int>(y);
@@ -1714,7 +1828,7 @@ void Agent::wrapPosition(int width, int height)
 
 // the path following methods for algorithm "race" mode
 void Agent::setPath(const std::vector<GridCell>& path, SimulationSettings::Algos algo) {
-    currentPath = path;
+    currentPath.assign(path);
     pathIndex = 0;
     hasPath = !path.empty();
     reachedGoal = false;
@@ -1739,7 +1853,7 @@ bool Agent::followPath(const Pathfinder& pathfinder, float raceMoveSpeed, float
         return true;
     }
     
-    const GridCell& target = currentPath[pathIndex];
+    const GridCell target = currentPath[pathIndex];  // decoded as the agent walks
     auto [targetX, targetY] = pathfinder.gridToWorld(target);
     
     // calculates direction to target
@@ -1759,7 +1873,7 @@ bool Agent::followPath(const Pathfinder& pathfinder, float raceMoveSpeed, float
         }
         
         // and update target to next waypoint
-        const GridCell& nextTarget = currentPath[pathIndex];
+        const GridCell nextTarget = currentPath[pathIndex];
         auto [nextX, nextY] = pathfinder.gridToWorld(nextTarget);
         dx = nextX - position.x;
         dy = nextY - position.y;
@@ -1885,9 +1999,9 @@ bool Agent::exploreStep(const Pathfinder& pathfinder, const GridCell& goalCell,
     }
     
     // decision for which exploration state to use
-    std::deque<GridCell>* frontierPtr = sharedState ? &sharedState->frontier : nullptr;
-    std::unordered_set<GridCell, GridCellHash>* visitedPtr = sharedState ? &sharedState->visited : &visitedCells;
-    std::unordered_map<GridCell, GridCell, GridCellHash>* parentsPtr = sharedState ? &sharedState->parents : &explorationParents;
+    TrackedCellDeque<MemoryTag::Exploration>* frontierPtr = sharedState ? &sharedState->frontier : nullptr;
+    TrackedCellSet<MemoryTag::Exploration>* visitedPtr = sharedState ? &sharedState->visited : &visitedCells;
+    TrackedCellMap<GridCell, MemoryTag::Exploration>* parentsPtr = sharedState ? &sharedState->parents : &explorationParents;
     
     // if we're using shared state and it already found the goal then we're done
     if (sharedState && sharedState->foundGoal) {
@@ -1904,7 +2018,6 @@ bool Agent::exploreStep(const Pathfinder& pathfinder, const GridCell& goalCell,
         if (sharedState) {
             sharedState->foundGoal = true;
         }
-        std::cout << "EXPLORER FOUND GOAL! Agent " << agentId << " (" << SimulationSettings::algoNames(assignedAlgo) << ")" << std::endl;
         return true;
     }
     
@@ -2004,7 +2117,6 @@ bool Agent::exploreStep(const Pathfinder& pathfinder, const GridCell& goalCell,
             if (sharedState) {
                 sharedState->foundGoal = true;
             }
-            std::cout << "EXPLORER FOUND GOAL! Agent " << agentId << " (" << SimulationSettings::algoNames(assignedAlgo) << ")" << std::endl;
             return true;
         }
         
@@ -2027,8 +2139,8 @@ bool Agent::exploreStep(const Pathfinder& pathfinder, const GridCell& goalCell,
             auto neighbors = pathfinder.getNeighbors(targetCell);
             
             if (assignedAlgo == SimulationSettings::Algos::DFS) {
-                std::random_device rd;
-                std::mt19937 g(rd());
+                // thread_local so parallel benchmark workers dont hit random_device per expansion
+                static thread_local std::mt19937 g(std::random_device{}());
                 std::shuffle(neighbors.begin(), neighbors.end(), g);
             }
 
@@ -2063,9 +2175,6 @@ bool Agent::exploreStep(const Pathfinder& pathfinder, const GridCell& goalCell,
     
     float finalMaxX = static_cast<float>(pathfinder.getWorldWidth() - 1);
     float finalMaxY = static_cast<float>(pathfinder.getWorldHeight() - 1);
-    if (position.x < 0 || position.x > finalMaxX || position.y < 0 || position.y > finalMaxY) {
-        std::cout << "BOUNDS FIX: Agent " << agentId << " was at (" << position.x << "," << position.y << ")" << std::endl;
-    }
     position.x = std::clamp(position.x, 1.0f, finalMaxX);
     position.y = std::clamp(position.y, 1.0f, finalMaxY);
     
@@ -2092,7 +2201,6 @@ bool Agent::exploreStepDijkstra(const Pathfinder& pathfinder, const GridCell& go
     if (posCell == goalCell) {
         reachedGoal = true;
         isExploring = false;
-        std::cout << "DIJKSTRA FOUND GOAL! Agent " << agentId << std::endl;
         return true;
     }
     
@@ -2172,7 +2280,6 @@ bool Agent::exploreStepDijkstra(const Pathfinder& pathfinder, const GridCell& go
         if (targetCell == goalCell) {
             reachedGoal = true;
             isExploring = false;
-            std::cout << "WOW!!! DIJKSTRA FOUND GOAL! Agent " << agentId << std::endl;
             return true;
         }
         
@@ -2227,9 +2334,9 @@ bool Agent::exploreStepDijkstra(const Pathfinder& pathfinder, const GridCell& go
 // energy management drives exploration vs exploitation: low energy = more random wandering.
 
 //NOTE: this needs a rework its not at the level it should be (behavior wise)
-bool Agent::benchmarkSlimeStep(TrailMap& trailMap, const Pathfinder& pathfinder,
+bool Agent::benchmarkSlimeStep(const TrailMap& trailMap, const Pathfinder& pathfinder,
                                 const SimulationSettings &settings,
-                                float trailDepositStrength, float goalX, float goalY,
+                                float goalX, float goalY,
                                 int goalFieldChannel) {
 
     const int worldWidth = pathfinder.getWorldWidth();
@@ -2435,9 +2542,10 @@ bool Agent::benchmarkSlimeStep(TrailMap& trailMap, const Pathfinder& pathfinder,
 
         // THE 3 SENSOR CHEMOTAXIS: sample environment at forward, left, and right sensor positions.
         // each sensor is sensorDist pixels ahead at angle, angle - sensorAngleRad, angle + sensorAngleRad.
-        sf::Vector2f forwardPos = position + sf::Vector2f(std::cos(angle), std::sin(angle)) * sensorDist;
-        sf::Vector2f leftPos = position + sf::Vector2f(std::cos(angle - sensorAngleRad), std::sin(angle - sensorAngleRad)) * sensorDist;
-        sf::Vector2f rightPos = position + sf::Vector2f(std::cos(angle + sensorAngleRad), std::sin(angle + sensorAngleRad)) * sensorDist;
+        sensorRotation.set(sensorAngleRad);
+        sf::Vector2f forwardPos = position + heading() * sensorDist;
+        sf::Vector2f leftPos = position + rotatedHeading(sensorRotation, -1.0f) * sensorDist;
+        sf::Vector2f rightPos = position + rotatedHeading(sensorRotation, 1.0f) * sensorDist;
 
         SignalSample forward = sampleSignals(forwardPos);
         SignalSample left = sampleSignals(leftPos);
@@ -2558,8 +2666,7 @@ bool Agent::benchmarkSlimeStep(TrailMap& trailMap, const Pathfinder& pathfinder,
         float delta = std::clamp(desiredAngle - angle, -maxTurnPerStep, maxTurnPerStep);
         angle += delta;
 
-        position.x += std::cos(angle) * stepLength;
-        position.y += std::sin(angle) * stepLength;
+        position += heading() * stepLength;
     }
 
     // collision check: if we walked into a wall revert position and try to recover
@@ -2610,8 +2717,6 @@ bool Agent::benchmarkSlimeStep(TrailMap& trailMap, const Pathfinder& pathfinder,
     position.y = std::clamp(position.y, 5.0f, static_cast<float>(worldHeight - 5));
 
     // sample signals at new position for energy calculations
-    int px = std::clamp(static_cast<int>(position.x), 0, worldWidth - 1);
-    int py = std::clamp(static_cast<int>(position.y), 0, worldHeight - 1);
     float postStepGoalDistance = std::hypot(goalX - position.x, goalY - position.y);
     SignalSample localSignals = sampleSignals(position);
     float localFood = localSignals.goal;
@@ -2684,12 +2789,22 @@ bool Agent::benchmarkSlimeStep(TrailMap& trailMap, const Pathfinder& pathfinder,
     // record position in path memory (for trail reinforcement when goal is found)
     pushPathMemory(static_cast<int>(position.x), static_cast<int>(position.y));
 
-    // TRAIL DEPOSITION: leave pheromone trail for other agents to follow.
+    return true;  // agent survives to next frame
+}
+
+// TRAIL DEPOSITION: leave pheromone trail for other agents to follow.
+// split out of benchmarkSlimeStep so the step itself never writes the trail map,
+// the caller stamps every slime of a channel in one go once all steps are done
+void Agent::depositBenchmarkSlime(TrailMap& trailMap, float trailDepositStrength) const {
+    const int slimeChannel = std::clamp(speciesIndex, 0, trailMap.getNumSpecies() - 1);
+    int w = trailMap.getWidth();
+    int h = trailMap.getHeight();
+    int px = std::clamp(static_cast<int>(position.x), 0, w - 1);
+    int py = std::clamp(static_cast<int>(position.y), 0, h - 1);
+
     // higher energy = stronger trail (successful agents leave clearer paths).
     const float energyScale = std::clamp(0.4f + benchmarkEnergy, 0.2f, 2.5f);
     float baseStrength = trailDepositStrength * 10.0f * energyScale;
-    int w = trailMap.getWidth();
-    int h = trailMap.getHeight();
 
     // deposit in a 5x5 area with a manhattan distance falloff (center strongest)
     for (int dx = -2; dx <= 2; ++dx) {
@@ -2702,8 +2817,6 @@ bool Agent::benchmarkSlimeStep(TrailMap& trailMap, const Pathfinder& pathfinder,
             }
         }
     }
-
-    return true;  // agent survives to next frame
 }
 
 // Reinforce the recent path with bonus trail deposits when goal is found
@@ -2769,6 +2882,48 @@ void Agent::reinforceRecentPath(TrailMap& trailMap, float baseStrength) {
     pathMemoryCount = 0;
 }
 
+std::array<sf::Vector2f, 3> Agent::sensorPositions(const SimulationSettings &settings) const
+{
+    const auto &species = settings.speciesSettings[std::clamp(speciesIndex, 0, static_cast<int>(settings.speciesSettings.size()) - 1)];
+    const float sensorDist = species.sensorOffsetDistance * (hasGenome ? genome.sensorDistScale : 1.0f);
+    const sf::Vector2f h = headingDir;
+    const float c = sensorRotation.c;
+    const float s = sensorRotation.s;
+    return {position + h * sensorDist,
+            position + sf::Vector2f(h.x * c + h.y * s, -h.x * s + h.y * c) * sensorDist,
+            position + sf::Vector2f(h.x * c - h.y * s, h.x * s + h.y * c) * sensorDist};
+}
+
+void Agent::prefetchSensors(const TrailMap &trailMap, const SimulationSettings &settings) const
+{
+    if (settings.speciesSettings.empty())
+        return;
+    for (const sf::Vector2f &p : sensorPositions(settings))
+    {
+        trailMap.prefetch(static_cast<int>(p.x), static_cast<int>(p.y));
+    }
+}
+
+void Agent::prefetchSensors(const float *chemoattractant, int width, int height, const SimulationSettings &settings) const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (settings.speciesSettings.empty())
+        return;
+    for (const sf::Vector2f &p : sensorPositions(settings))
+    {
+        const int x = static_cast<int>(p.x);
+        const int y = static_cast<int>(p.y);
+        if (x >= 0 && x < width && y >= 0 && y < height)
+            __builtin_prefetch(chemoattractant + y * width + x, 0, 1);
+    }
+#else
+    (void)chemoattractant;
+    (void)width;
+    (void)height;
+    (void)settings;
+#endif
+}
+
 float Agent::sampleChemoattractant(const float *grid, int x, int y, int width, int height) const
 {
     if (x < 0 || x >= width || y < 0 || y >= height)
@@ -2778,139 +2933,296 @@ float Agent::sampleChemoattractant(const float *grid, int x, int y, int width, i
     return grid[y * width + x];
 }
 
-std::vector<Agent> AgentFactory::createAgents(const SimulationSettings &settings)
+namespace
+{
+    // counter based rng (splitmix64 finalizer over seed + counter). any agent index can be
+    // generated on its own so spawn chunks dont share or advance a generator, and the same
+    // seed gives the same world no matter how the work was split across threads
+    struct CounterRng
+    {
+        std::uint64_t seed;
+
+        static std::uint64_t mix(std::uint64_t z)
+        {
+            z += 0x9E3779B97F4A7C15ull;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        // uniform in [0, 1) for (counter, stream) - 24 bits is all a float can hold anyway
+        float uniform(std::uint64_t counter, std::uint32_t stream) const
+        {
+            std::uint64_t bits = mix(seed ^ mix(counter * 8 + stream));
+            return static_cast<float>(bits >> 40) * (1.0f / 16777216.0f);
+        }
+    };
+
+    // rng streams per agent
+    enum SpawnStream : std::uint32_t
+    {
+        STREAM_X = 0,
+        STREAM_Y = 1,
+        STREAM_ANGLE = 2,
+        STREAM_AGE = 3,
+        STREAM_PARENT = 4
+    };
+
+    // runs func(begin, end) over [0, count) on the pool when there is one
+    template <typename Function>
+    void runSpawnChunks(ParallelProcessor *pool, size_t count, Function &&func)
+    {
+        if (pool)
+            pool->processRangeParallel(count, func);
+        else
+            func(static_cast<size_t>(0), count);
+    }
+}
+
+AgentVector AgentFactory::createAgents(const SimulationSettings &settings)
 {
     // default behavior - no species reroll mapping
     return createAgents(settings, std::vector<int>());
 }
 
-std::vector<Agent> AgentFactory::createAgents(const SimulationSettings &settings, const std::vector<int> &activeSpeciesIndices)
+AgentVector AgentFactory::createAgents(const SimulationSettings &settings, const std::vector<int> &activeSpeciesIndices)
 {
-    std::vector<Agent> agents;
-    agents.reserve(settings.numAgents);
+    AgentVector agents;
+    spawnAgents(agents, settings, activeSpeciesIndices, nullptr);
+    return agents;
+}
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
+namespace
+{
+    // lays out colonies for every species in `speciesList` and writes their agents into
+    // agents[firstSlot..]. the vector is grown/shrunk to end right after them.
+    // returns the number of colonies created
+    size_t spawnColonies(AgentVector &agents, size_t firstSlot, const SimulationSettings &settings,
+                         const std::vector<int> &speciesList, const std::vector<int> &activeSpeciesIndices,
+                         ParallelProcessor *pool, std::mt19937 &gen)
+    {
+        sf::Vector2f center(settings.width / 2.0f, settings.height / 2.0f);
+        int numSpecies = std::max(1, static_cast<int>(settings.speciesSettings.size()));
+
+        // multi colony spawning: each species gets 1-3 separate "colonies" (clusters).
+        // this ensures species dont all start in one blob, and territorial/loner
+        // species have neighbors of their own kind to interact with at startup.
+        struct SpawnCluster {
+            sf::Vector2f center;
+            int speciesIndex;
+        };
+        std::vector<SpawnCluster> allClusters;
 
-    sf::Vector2f center(settings.width / 2.0f, settings.height / 2.0f);
-    int numSpecies = settings.speciesSettings.size();
+        // each species gets a random number of colonies (1-3)
+        std::uniform_int_distribution<int> clusterCountDist(1, 3);
+        // clusters spawn in the middle 80% of the world (10%-90% on each axis)
+        std::uniform_real_distribution<float> posDistX(settings.width * 0.1f, settings.width * 0.9f);
+        std::uniform_real_distribution<float> posDistY(settings.height * 0.1f, settings.height * 0.9f);
 
-    // multi colony spawning: each species gets 1-3 separate "colonies" (clusters).
-    // this ensures species dont all start in one blob, and territorial/loner
-    // species have neighbors of their own kind to interact with at startup.
-    struct SpawnCluster {
-        sf::Vector2f center;
-        int speciesIndex;
-    };
-    std::vector<SpawnCluster> allClusters;
-    
-    // each species gets a random number of colonies (1-3)
-    std::uniform_int_distribution<int> clusterCountDist(1, 3);
-    // clusters spawn in the middle 80% of the world (10%-90% on each axis)
-    std::uniform_real_distribution<float> posDistX(settings.width * 0.1f, settings.width * 0.9f);
-    std::uniform_real_distribution<float> posDistY(settings.height * 0.1f, settings.height * 0.9f);
-    
-    if (numSpecies > 1)
-    {
-        // multi species mode: create multiple clusters per species
-        for (int s = 0; s < numSpecies; ++s)
+        if (numSpecies > 1)
         {
-            int numClusters = clusterCountDist(gen);
-            for (int c = 0; c < numClusters; ++c)
+            // multi species mode: create multiple clusters per species
+            for (int s : speciesList)
             {
-                // random position for each cluster
-                sf::Vector2f clusterCenter(posDistX(gen), posDistY(gen));
-                allClusters.push_back({clusterCenter, s});
+                int numClusters = clusterCountDist(gen);
+                for (int c = 0; c < numClusters; ++c)
+                {
+                    // random position for each cluster
+                    sf::Vector2f clusterCenter(posDistX(gen), posDistY(gen));
+                    allClusters.push_back({clusterCenter, s});
+                }
             }
         }
-        std::cout << "Created " << allClusters.size() << " spawn clusters across " << numSpecies << " species" << std::endl;
-    }
-    else
-    {
-        // single species mode: using center
-        allClusters.push_back({center, 0});
-    }
-
-    // distribute agents evenly among clusters of their own species
-    // first count how many clusters each species has then divide agents accordingly
-    std::vector<int> agentsPerCluster(allClusters.size(), 0);
-    int agentsPerSpecies = settings.numAgents / numSpecies;
-    
-    // and for each species find its clusters and assign equal agent counts
-    for (int s = 0; s < numSpecies; ++s)
-    {
-        // and collect indices of all clusters belonging to this species
-        std::vector<size_t> speciesClusters;
-        for (size_t i = 0; i < allClusters.size(); ++i)
+        else
         {
-            if (allClusters[i].speciesIndex == s)
-                speciesClusters.push_back(i);
+            // single species mode: using center
+            allClusters.push_back({center, 0});
         }
-        
-        // divide this species agent quota among its clusters
-        if (!speciesClusters.empty())
+
+        // distribute agents evenly among clusters of their own species.
+        // clusterStart is a prefix sum so agent i belongs to the cluster whose range holds i
+        std::vector<int> agentsPerCluster(allClusters.size(), 0);
+        int agentsPerSpecies = settings.numAgents / numSpecies;
+        for (int s : speciesList)
         {
-            int agentsEach = agentsPerSpecies / speciesClusters.size();
-            for (size_t idx : speciesClusters)
+            int speciesClusters = 0;
+            for (const auto &cluster : allClusters)
             {
-                agentsPerCluster[idx] = agentsEach;
+                if (cluster.speciesIndex == s)
+                    speciesClusters++;
             }
-        }
-    }
+            if (speciesClusters == 0)
+                continue;
 
-    // spawn agents at their cluster centers with tight grouping (+/-30 pixels)
-    std::uniform_real_distribution<float> clusterSpread(-30.0f, 30.0f);
-    
-    // iterate through each cluster and spawn its assigned agents
-    for (size_t clusterIdx = 0; clusterIdx < allClusters.size(); ++clusterIdx)
-    {
-        const auto& cluster = allClusters[clusterIdx];
-        int agentCount = agentsPerCluster[clusterIdx];
-        
-        // get lifespan for this species to randomize starting age
-        float lifespan = 60.0f;  // default
-        if (cluster.speciesIndex < static_cast<int>(settings.speciesSettings.size())) {
-            lifespan = settings.speciesSettings[cluster.speciesIndex].lifespanSeconds;
-        }
-        // stagger starting ages across 0-90% of lifespan to prevent mass extinction waves.
-        // if all agents started at age 0 they'd all die at the same time! not good...
-        std::uniform_real_distribution<float> ageDist(0.0f, lifespan * 0.9f);
-        
-        // spawn each agent near the cluster center with random angle
-        for (int i = 0; i < agentCount; ++i)
+            // divide this species agent quota among its clusters
+            int agentsEach = agentsPerSpecies / speciesClusters;
+            for (size_t i = 0; i < allClusters.size(); ++i)
+            {
+                if (allClusters[i].speciesIndex == s)
+                    agentsPerCluster[i] = agentsEach;
+            }
+        }
+        std::vector<size_t> clusterStart(allClusters.size() + 1, firstSlot);
+        for (size_t i = 0; i < allClusters.size(); ++i)
         {
-            // spawn close to cluster center
-            sf::Vector2f spawnPos(
-                std::clamp(cluster.center.x + clusterSpread(gen), 0.0f, (float)settings.width),
-                std::clamp(cluster.center.y + clusterSpread(gen), 0.0f, (float)settings.height)
-            );
-            
-            // (random angle)
-            std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-            float spawnAngle = angleDist(gen);
-
-            agents.emplace_back(spawnPos.x, spawnPos.y, spawnAngle, cluster.speciesIndex);
-            
-            // randomize starting age so deaths are staggered
-            agents.back().ageSeconds = ageDist(gen);
+            clusterStart[i + 1] = clusterStart[i] + agentsPerCluster[i];
+        }
+        const size_t end = clusterStart.back();
 
+        // one fully constructed prototype per species. every spawned agent is a copy of its
+        // prototype so the constructor (and its mutex guarded bookkeeping) runs numSpecies times
+        AgentVector prototypes;
+        prototypes.reserve(numSpecies);
+        for (int s = 0; s < numSpecies; ++s)
+        {
+            prototypes.emplace_back(0.0f, 0.0f, 0.0f, s);
             // and set correct species mask
-            if (!activeSpeciesIndices.empty() && cluster.speciesIndex < (int)activeSpeciesIndices.size())
-            {
-                int originalSpeciesIndex = activeSpeciesIndices[cluster.speciesIndex];
-                agents.back().setSpeciesMaskFromOriginalIndex(originalSpeciesIndex);
-            }
+            if (!activeSpeciesIndices.empty() && s < static_cast<int>(activeSpeciesIndices.size()))
+                prototypes.back().setSpeciesMaskFromOriginalIndex(activeSpeciesIndices[s]);
             else
+                prototypes.back().setDefaultSpeciesMask(s);
+        }
+
+        // storage: reserve once and reuse whatever is already there. on a full respawn clearing
+        // before a reserve that has to grow avoids copying the old population into the new block
+        if (agents.capacity() < end)
+        {
+            if (firstSlot == 0)
+                agents.clear();
+            agents.reserve(end);
+        }
+        if (agents.size() > end)
+        {
+            agents.erase(agents.begin() + end, agents.end());
+        }
+        // every slot gets overwritten below, this just gives the tail something to assign over
+        agents.resize(end, prototypes[0]);
+
+        // lifespans per cluster so the age stagger matches the species
+        std::vector<float> clusterLifespan(allClusters.size(), 60.0f);
+        for (size_t i = 0; i < allClusters.size(); ++i)
+        {
+            int s = allClusters[i].speciesIndex;
+            if (s < static_cast<int>(settings.speciesSettings.size()))
+                clusterLifespan[i] = settings.speciesSettings[s].lifespanSeconds;
+        }
+
+        const CounterRng rng{(static_cast<std::uint64_t>(gen()) << 32) | gen()};
+        const float maxX = static_cast<float>(settings.width);
+        const float maxY = static_cast<float>(settings.height);
+
+        runSpawnChunks(pool, end - firstSlot, [&](size_t begin, size_t stop) {
+            begin += firstSlot;
+            stop += firstSlot;
+            // find the cluster for the first agent of the chunk, then walk forward
+            size_t clusterIdx = std::upper_bound(clusterStart.begin(), clusterStart.end(), begin) - clusterStart.begin() - 1;
+            for (size_t i = begin; i < stop; ++i)
             {
-                agents.back().setDefaultSpeciesMask(cluster.speciesIndex);
+                while (i >= clusterStart[clusterIdx + 1])
+                    clusterIdx++;
+                const auto &cluster = allClusters[clusterIdx];
+
+                Agent &agent = agents[i];
+                agent = prototypes[cluster.speciesIndex];
+
+                // spawn close to cluster center with tight grouping (+/-30 pixels) and a random angle
+                agent.position.x = std::clamp(cluster.center.x + (rng.uniform(i, STREAM_X) * 60.0f - 30.0f), 0.0f, maxX);
+                agent.position.y = std::clamp(cluster.center.y + (rng.uniform(i, STREAM_Y) * 60.0f - 30.0f), 0.0f, maxY);
+                agent.angle = rng.uniform(i, STREAM_ANGLE) * 2.0f * M_PIf;
+                agent.previousAngle = agent.angle;
+
+                // stagger starting ages across 0-90% of lifespan to prevent mass extinction waves.
+                // if all agents started at age 0 they'd all die at the same time! not good...
+                agent.ageSeconds = rng.uniform(i, STREAM_AGE) * clusterLifespan[clusterIdx] * 0.9f;
             }
-        }
+        });
+
+        return allClusters.size();
     }
+}
 
+void AgentFactory::spawnAgents(AgentVector &agents, const SimulationSettings &settings,
+                               const std::vector<int> &activeSpeciesIndices, ParallelProcessor *pool)
+{
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+
+    int numSpecies = std::max(1, static_cast<int>(settings.speciesSettings.size()));
+    std::vector<int> allSpecies(numSpecies);
+    for (int s = 0; s < numSpecies; ++s)
+        allSpecies[s] = s;
+
+    size_t numClusters = spawnColonies(agents, 0, settings, allSpecies, activeSpeciesIndices, pool, gen);
+
+    // reused slots keep their address so their entries in the per agent static maps are stale now
+    Agent::resetSharedBehaviorState();
+
+    if (numSpecies > 1)
+        std::cout << "Created " << numClusters << " spawn clusters across " << numSpecies << " species" << std::endl;
     std::cout << "Created " << agents.size() << " agents across " << numSpecies
-              << " species with CLUSTERED spawning (" << allClusters.size() << " colonies)" << std::endl;
+              << " species with CLUSTERED spawning (" << numClusters << " colonies)" << std::endl;
+}
 
-    return agents;
+void AgentFactory::spawnSpecies(AgentVector &agents, const SimulationSettings &settings,
+                                const std::vector<int> &speciesToSpawn, ParallelProcessor *pool)
+{
+    if (speciesToSpawn.empty())
+        return;
+
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+
+    size_t before = agents.size();
+    size_t numClusters = spawnColonies(agents, before, settings, speciesToSpawn, {}, pool, gen);
+
+    std::cout << "Spawned " << (agents.size() - before) << " agents for " << speciesToSpawn.size()
+              << " new species (" << numClusters << " colonies)" << std::endl;
+}
+
+void AgentFactory::spawnClones(AgentVector &agents, size_t count, const SimulationSettings &settings,
+                               ParallelProcessor *pool)
+{
+    if (count == 0 || agents.empty())
+        return;
+
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+
+    // a prototype per species with the cached movement params already applied
+    int numSpecies = std::max(1, static_cast<int>(settings.speciesSettings.size()));
+    AgentVector prototypes;
+    prototypes.reserve(numSpecies);
+    for (int s = 0; s < numSpecies; ++s)
+    {
+        prototypes.emplace_back(0.0f, 0.0f, 0.0f, s);
+        prototypes.back().setDefaultSpeciesMask(s);
+        prototypes.back().applyGenomeToCachedParams(settings);  // initialize moveSpeed etc
+    }
+
+    const size_t originalSize = agents.size();
+    agents.resize(originalSize + count, prototypes[0]);
+
+    const CounterRng rng{(static_cast<std::uint64_t>(gen()) << 32) | gen()};
+    const float maxX = static_cast<float>(settings.width - 1);
+    const float maxY = static_cast<float>(settings.height - 1);
+
+    runSpawnChunks(pool, count, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            // random existing agent to spawn from (only from original agents)
+            size_t parentIdx = std::min(static_cast<size_t>(rng.uniform(k, STREAM_PARENT) * originalSize), originalSize - 1);
+            const Agent &parent = agents[parentIdx];
+            int species = std::clamp(parent.speciesIndex, 0, numSpecies - 1);
+
+            // spawns very close to the parent agent
+            Agent &agent = agents[originalSize + k];
+            agent = prototypes[species];
+            agent.position.x = std::clamp(parent.position.x + (rng.uniform(k, STREAM_X) * 10.0f - 5.0f), 0.0f, maxX);
+            agent.position.y = std::clamp(parent.position.y + (rng.uniform(k, STREAM_Y) * 10.0f - 5.0f), 0.0f, maxY);
+            agent.angle = rng.uniform(k, STREAM_ANGLE) * 2.0f * M_PIf;
+            agent.previousAngle = agent.angle;
+        }
+    });
 }
 
 sf::Vector2f AgentFactory::getSpawnPosition(SimulationSettings::SpawnMode mode,
@@ -3653,7 +3965,7 @@ void Agent::applyDevourerConsumptionTurning(float front, float left, float right
 
 // optimized methods for high performance systems
 
-void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vector<Agent> &allAgents,
+void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const AgentVector &allAgents,
                                  OptimizedTrailMap &trailMap, const SimulationSettings &settings)
 {
     if (settings.speciesSettings.empty())
@@ -3662,21 +3974,17 @@ void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vect
 
     // cache frequently used values for performance with genome scaling
     const float sensorDist = species.sensorOffsetDistance * (hasGenome ? genome.sensorDistScale : 1.0f);
-    const float sensorAngleRad = species.sensorAngleSpacing * (hasGenome ? genome.sensorAngleScale : 1.0f) * M_PIf / 180.0f;
-    const float leftAngle = angle - sensorAngleRad;
-    const float rightAngle = angle + sensorAngleRad;
-
-    // calculate sensor positions using simd-friendly math
-    float cosAngle = std::cos(angle);
-    float sinAngle = std::sin(angle);
-    float cosLeft = std::cos(leftAngle);
-    float sinLeft = std::sin(leftAngle);
-    float cosRight = std::cos(rightAngle);
-    float sinRight = std::sin(rightAngle);
-
-    sf::Vector2f frontPos(position.x + cosAngle * sensorDist, position.y + sinAngle * sensorDist);
-    sf::Vector2f leftPos(position.x + cosLeft * sensorDist, position.y + sinLeft * sensorDist);
-    sf::Vector2f rightPos(position.x + cosRight * sensorDist, position.y + sinRight * sensorDist);
+    sensorRotation.set(species.sensorAngleSpacing * (hasGenome ? genome.sensorAngleScale : 1.0f) * M_PIf / 180.0f);
+
+    // calculate sensor positions by rotating the heading vector (no trig unless the angle was set directly)
+    const sf::Vector2f forwardDir = heading();
+    sf::Vector2f frontPos = position + forwardDir * sensorDist;
+    sf::Vector2f leftPos = position + rotatedHeading(sensorRotation, -1.0f) * sensorDist;
+    sf::Vector2f rightPos = position + rotatedHeading(sensorRotation, 1.0f) * sensorDist;
+    // half the sensor spread as a cosine, for the front cone test below (half angle identity, spread <= 180)
+    const float frontConeCos = (sensorRotation.radians <= M_PIf)
+                                   ? std::sqrt(std::max(0.0f, 0.5f * (1.0f + sensorRotation.c)))
+                                   : std::cos(sensorRotation.radians * 0.5f);
 
     // effective per agent parameters with genome scaling
     const float alignW = species.alignmentWeight * (hasGenome ? genome.alignWScale : 1.0f);
@@ -3693,7 +4001,7 @@ void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vect
 
     // use spatial grid for ultra-fast neighbor detection
     // spatial grid divides world into cells so we only check nearby agents, not all agents
-    std::vector<size_t> nearbyAgents = spatialGrid.getNearbyAgents(position.x, position.y, sensorDist * 2.0f);
+    auto nearbyAgents = spatialGrid.getNearbyAgents(position.x, position.y, sensorDist * 2.0f);
 
     // aggregates for boids-like emergent behavior (Reynolds 1987):
     // alignSum: running total of neighbor velocity directions for flocking alignment
@@ -3724,17 +4032,15 @@ void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vect
             // base interaction mapped into sensors
             float interaction = calculateAgentInteraction(other, distance, species);
 
-            float angleToOther = std::atan2(dy, dx);
-            float angleDiff = angleToOther - angle;
-            // normalize angle difference to [-π, π]
-            while (angleDiff > M_PIf)
-                angleDiff -= 2.0f * M_PIf;
-            while (angleDiff < -M_PIf)
-                angleDiff += 2.0f * M_PIf;
+            // bearing relative to the heading from dot/cross instead of atan2:
+            // ahead = cos(bearing), side = sin(bearing) (> 0 means to the right)
+            float invDist = 1.0f / distance;
+            float ahead = (forwardDir.x * dx + forwardDir.y * dy) * invDist;
+            float side = (forwardDir.x * dy - forwardDir.y * dx) * invDist;
 
-            if (std::abs(angleDiff) < sensorAngleRad * 0.5f)
+            if (ahead > frontConeCos)
                 front += interaction;
-            else if (angleDiff < 0)
+            else if (side < 0)
                 left += interaction;
             else
                 right += interaction;
@@ -3812,13 +4118,6 @@ void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vect
             // quorum factor: flocking influence scales with neighbor count up to threshold.
             // more neighbors = stronger social influence on direction choice.
             float quorumFactor = std::min(1.5f, static_cast<float>(neighborCount) / std::max(1.0f, species.quorumThreshold));
-            float desiredAngle = std::atan2(desired.y, desired.x);
-            float ang = desiredAngle - angle;
-            while (ang > M_PIf)
-                ang -= 2.0f * M_PIf;
-            while (ang < -M_PIf)
-                ang += 2.0f * M_PIf;
-
             // project the desired boids heading onto the 3-sensor array.
             // cosv > 0 means desired is ahead -> boost front sensor.
             // sinv < 0 means desired is to the left -> boost left sensor.
@@ -3826,8 +4125,9 @@ void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vect
             // this translates the abstract "desired direction" into sensor weights
             // that the existing chemotaxis turning logic can use.
             float magnitude = std::min(1.0f, dLen) * quorumFactor;
-            float cosv = std::cos(ang);
-            float sinv = std::sin(ang);
+            // cos/sin of the angle between heading and desired, straight from dot and cross
+            float cosv = (forwardDir.x * desired.x + forwardDir.y * desired.y) / dLen;
+            float sinv = (forwardDir.x * desired.y - forwardDir.y * desired.x) / dLen;
             front += std::max(0.0f, cosv) * magnitude;
             if (sinv < 0)
                 left += -sinv * magnitude;
@@ -3856,7 +4156,7 @@ void Agent::senseWithSpatialGrid(const SpatialGrid &spatialGrid, const std::vect
     if (oscStr > 0.0f)
     {
         float oscPhase = stateTimer * oscHz * 2.0f * M_PIf;
-        float osc = std::sin(oscPhase) * oscStr;
+        float osc = FastMath::sin(oscPhase, settings.fastMath) * oscStr;
         left += -osc;
         right += osc;
     }
@@ -3923,7 +4223,8 @@ void Agent::depositOptimized(OptimizedTrailMap &trailMap, const SimulationSettin
         {
             float sigmaPar = settings.splatSigmaParallel * (1.0f + 0.15f * (species.behaviorIntensity - 2));
             float sigmaPerp = settings.splatSigmaPerp * (1.0f + 0.10f * (species.behaviorIntensity - 2));
-            trailMap.depositAnisotropic(px, py, angle, sigmaPar, sigmaPerp, amount * settings.splatIntensityScale, speciesIndex, width, height);
+            trailMap.depositAnisotropic(px, py, heading(), sigmaPar, sigmaPerp, amount * settings.splatIntensityScale, speciesIndex,
+                                        settings.fastMath);
         }
         else
         {
@@ -4248,9 +4549,10 @@ void Agent::moveWithPelletSeeking(const SimulationSettings &settings, const std:
         applyInertia(settings);
 
         // very slight speed boost when moving toward attractive pellets (only 10% max)
-        if (pelletInfluence > species.moveSpeed * 0.5f && pelletForce.x * std::cos(angle) + pelletForce.y * std::sin(angle) > 0)
+        const sf::Vector2f &dir = heading();
+        if (pelletInfluence > species.moveSpeed * 0.5f && pelletForce.x * dir.x + pelletForce.y * dir.y > 0)
         {
-            sf::Vector2f gentleMovement(std::cos(angle) * species.moveSpeed * 0.3f, std::sin(angle) * species.moveSpeed * 0.3f);
+            sf::Vector2f gentleMovement(dir.x * species.moveSpeed * 0.3f, dir.y * species.moveSpeed * 0.3f);
             // sf::vector2f gentlemovement(std::cos(angle) * species.movespeed * 0.1f, std::sin(angle) * species.movespeed * 0.1f);
 
             position += gentleMovement;
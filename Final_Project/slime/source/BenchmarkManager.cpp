@@ -1,8 +1,13 @@
 #include "BenchmarkManager.h"
+#include "MemoryTracker.h"
+#include "Log.h"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <ctime>
+#include <iostream>
+#include <set>
 
 // static lists of algorithms for the benchmark
 // grouped by "explorers (uninformed) first" then the pathfinders (informed/heuristic)
@@ -155,6 +160,49 @@ void BenchmarkManager::initializeStats()
         stat.totalAgents = agentsPerAlgorithm_;
         stats_.push_back(stat);
     }
+
+    // one arrival tracker per algorithm, sized for the default population up front
+    arrivals_.clear();
+    for (size_t i = 0; i < BENCHMARK_ALGORITHMS.size(); i++)
+    {
+        arrivals_.push_back(std::make_unique<SpeciesArrivals>());
+    }
+    arrivalSlots_ = 0;
+    reserveArrivalSlots(agentsPerAlgorithm_ * static_cast<int>(BENCHMARK_ALGORITHMS.size()));
+}
+
+void BenchmarkManager::reserveArrivalSlots(int slotCount)
+{
+    if (slotCount <= arrivalSlots_)
+        return;
+
+    // grows every species bitset, keeping bits that are already set
+    size_t words = (static_cast<size_t>(slotCount) + 63) / 64;
+    for (auto &arrival : arrivals_)
+    {
+        auto grown = std::make_unique<std::atomic<std::uint64_t>[]>(words);
+        for (size_t w = 0; w < words; w++)
+        {
+            std::uint64_t old = (w < arrival->bitWords) ? arrival->arrivedBits[w].load(std::memory_order_relaxed) : 0;
+            grown[w].store(old, std::memory_order_relaxed);
+        }
+        arrival->arrivedBits = std::move(grown);
+        arrival->bitWords = words;
+    }
+    arrivalSlots_ = static_cast<int>(words * 64);
+}
+
+void BenchmarkManager::clearArrivals()
+{
+    for (auto &arrival : arrivals_)
+    {
+        for (size_t w = 0; w < arrival->bitWords; w++)
+        {
+            arrival->arrivedBits[w].store(0, std::memory_order_relaxed);
+        }
+        arrival->arrivedCount.store(0, std::memory_order_relaxed);
+        arrival->histogram.clear();
+    }
 }
 
 void BenchmarkManager::setAlgorithmEnabled(size_t index, bool enabled) {
@@ -187,8 +235,12 @@ void BenchmarkManager::reset()
     benchmarkComplete_ = false;
     benchmarkPaused_ = false;
     totalPausedTimeMs_ = 0.0;
+    raceTicks_ = 0;
+    raceTimeMs_ = 0.0;
     nextRank_ = 1;
-    arrivedAgents_.clear();
+    clearArrivals();
+    EventLog::close();
+    pendingPaths_.clear();
 
     sharedExplorationStates_.clear();
 
@@ -206,6 +258,8 @@ void BenchmarkManager::reset()
         stat.firstArrivalTimeMs = -1.0;
         stat.lastArrivalTimeMs = -1.0;
         stat.avgArrivalTimeMs = 0.0;
+        stat.p50ArrivalTimeMs = -1.0;
+        stat.p95ArrivalTimeMs = -1.0;
         stat.rank = 0;
     }
 }
@@ -231,9 +285,38 @@ void BenchmarkManager::startBenchmark()
         benchmarkPaused_ = false;
         benchmarkStartTime_ = std::chrono::high_resolution_clock::now();
         totalPausedTimeMs_ = 0.0;
+        raceTicks_ = 0;
+        raceTimeMs_ = 0.0;
+        openEventLog();
     }
 }
 
+void BenchmarkManager::openEventLog()
+{
+    if (!eventLogEnabled_)
+    {
+        pendingPaths_.clear();
+        return;
+    }
+
+    // one file per race, named after when it started
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    const std::string path = std::string("benchmark_events_") + stamp + ".csv";
+
+    if (!EventLog::open(path))
+    {
+        SLIME_LOG(Log::Level::Warn, "[BENCHMARK] could not create event log " << path);
+        pendingPaths_.clear();
+        return;
+    }
+    for (const auto &[agent, event] : pendingPaths_)
+        EventLog::record(event);
+    pendingPaths_.clear();
+    std::cout << "[BENCHMARK] logging events to " << path << std::endl;
+}
+
 void BenchmarkManager::pauseBenchmark()
 {
     // for recording when the pause began so elapsed time stays accurate
@@ -255,13 +338,19 @@ void BenchmarkManager::resumeBenchmark()
     }
 }
 
-void BenchmarkManager::update(float deltaTime)
+void BenchmarkManager::update(float tickSeconds)
 {
-    (void)deltaTime; // unused for now
-
-    if (!benchmarkActive_ || benchmarkPaused_)
+    if (!benchmarkActive_ || benchmarkPaused_ || benchmarkComplete_)
         return;
 
+    // the race clock moves by whole ticks, so arrival times dont depend on the frame rate or on
+    // how many race ticks a frame runs (headless races give the same times as watched ones).
+    // ticks times the tick length, not a running sum, so no rounding piles up over a long race
+    raceTicks_++;
+    raceTimeMs_ = static_cast<double>(raceTicks_) * static_cast<double>(tickSeconds) * 1000.0;
+
+    flushArrivals();
+
     // check if the benchmark is complete (ie all algorithms finished)
     bool allFinished = true;
     for (const auto &stat : stats_)
@@ -275,7 +364,13 @@ void BenchmarkManager::update(float deltaTime)
 
     if (allFinished)
     {
+        completedWallMs_ = getBenchmarkWallMs();
         benchmarkComplete_ = true;
+        if (EventLog::isOpen())
+        {
+            EventLog::close();
+            std::cout << "[BENCHMARK] event log closed, " << EventLog::written() << " events" << std::endl;
+        }
     }
 }
 
@@ -283,37 +378,224 @@ void BenchmarkManager::recordArrival(int speciesIndex, int agentId)
 {
     if (!benchmarkActive_ || benchmarkPaused_)
         return;
-    if (speciesIndex < 0 || speciesIndex >= static_cast<int>(stats_.size()))
+    if (speciesIndex < 0 || speciesIndex >= static_cast<int>(arrivals_.size()))
         return;
+    if (agentId < 0 || agentId >= arrivalSlots_)
+        return;
+
+    auto &arrival = *arrivals_[speciesIndex];
 
-    // check for if already arrived
-    auto &arrivedSet = arrivedAgents_[speciesIndex];
-    if (arrivedSet.find(agentId) != arrivedSet.end())
+    // check for if already arrived - fetch_or tells us whether we were the one to set the bit
+    std::uint64_t mask = std::uint64_t(1) << (agentId & 63);
+    std::uint64_t previous = arrival.arrivedBits[agentId >> 6].fetch_or(mask, std::memory_order_relaxed);
+    if (previous & mask)
     {
         return; // already recorded then
     }
-    arrivedSet.insert(agentId);
 
-    auto &stat = stats_[speciesIndex];
-    double elapsedMs = getBenchmarkElapsedMs();
+    arrival.histogram.record(getBenchmarkElapsedMs());
+    arrival.arrivedCount.fetch_add(1, std::memory_order_relaxed);
+
+    EventLog::record(makeEvent(EventLog::Type::Arrival, speciesIndex, agentId));
+}
+
+EventLog::Event BenchmarkManager::makeEvent(EventLog::Type type, int speciesIndex, int agentId) const
+{
+    EventLog::Event event;
+    event.type = type;
+    event.species = static_cast<std::int16_t>(speciesIndex);
+    if (speciesIndex >= 0 && speciesIndex < static_cast<int>(BENCHMARK_ALGORITHMS.size()))
+        event.algorithm = getAlgorithmName(BENCHMARK_ALGORITHMS[speciesIndex]);
+    event.agentId = agentId;
+    event.tick = raceTicks_;
+    event.raceMs = raceTimeMs_;
+    return event;
+}
+
+void BenchmarkManager::recordPathComputed(int speciesIndex, int agentId, const PathResult &result, bool cached)
+{
+    if (!eventLogEnabled_)
+        return;
+    EventLog::Event event = makeEvent(EventLog::Type::PathComputed, speciesIndex, agentId);
+    if (!result.path.empty())
+    {
+        event.cellX = result.path.front().x;
+        event.cellY = result.path.front().y;
+    }
+    event.nodes = result.nodesExpanded;
+    event.pathLength = result.pathLength;
+    event.computeMs = static_cast<float>(result.computeTimeMs);
+    event.cached = cached;
+
+    // setup runs before the race starts, so hold those until startBenchmark opens the log. an agent
+    // set up again (repacked, respawned) replaces its earlier path
+    if (!benchmarkActive_)
+        pendingPaths_[{speciesIndex, agentId}] = event;
+    else
+        EventLog::record(event);
+}
 
-    stat.arrivedAgents++;
+void BenchmarkManager::keepPendingPaths(const std::vector<std::pair<int, int>> &raceAgents)
+{
+    std::set<std::pair<int, int>> inRace(raceAgents.begin(), raceAgents.end());
+    for (auto it = pendingPaths_.begin(); it != pendingPaths_.end();)
+        it = inRace.count(it->first) ? std::next(it) : pendingPaths_.erase(it);
+}
 
-    if (stat.firstArrivalTimeMs < 0)
+void BenchmarkManager::recordExplorationStep(int speciesIndex, int agentId, GridCell cell, int visitedCells)
+{
+    if (!EventLog::isOpen())
+        return;
+    EventLog::Event event = makeEvent(EventLog::Type::ExplorationStep, speciesIndex, agentId);
+    event.cellX = cell.x;
+    event.cellY = cell.y;
+    event.nodes = visitedCells;
+    EventLog::record(event);
+}
+
+void BenchmarkManager::recordRespawn(int speciesIndex, int agentId, GridCell cell)
+{
+    if (!EventLog::isOpen())
+        return;
+    EventLog::Event event = makeEvent(EventLog::Type::Respawn, speciesIndex, agentId);
+    event.cellX = cell.x;
+    event.cellY = cell.y;
+    EventLog::record(event);
+}
+
+void BenchmarkManager::flushArrivals()
+{
+    for (size_t i = 0; i < stats_.size() && i < arrivals_.size(); i++)
+    {
+        const auto &arrival = *arrivals_[i];
+        auto &stat = stats_[i];
+
+        stat.arrivedAgents = arrival.arrivedCount.load(std::memory_order_relaxed);
+        if (arrival.histogram.count() == 0)
+            continue;
+
+        stat.firstArrivalTimeMs = arrival.histogram.minMs();
+        stat.lastArrivalTimeMs = arrival.histogram.maxMs();
+        stat.avgArrivalTimeMs = arrival.histogram.mean();
+        stat.p50ArrivalTimeMs = arrival.histogram.percentile(0.50);
+        stat.p95ArrivalTimeMs = arrival.histogram.percentile(0.95);
+    }
+
+    // rank the algorithms that finished since the last flush, earliest last arrival first.
+    // only a handful of algorithms so a repeated min scan is fine
+    while (true)
+    {
+        AlgorithmStats *next = nullptr;
+        for (auto &stat : stats_)
+        {
+            if (stat.finished || stat.arrivedAgents < stat.totalAgents)
+                continue;
+            if (!next || stat.lastArrivalTimeMs < next->lastArrivalTimeMs)
+                next = &stat;
+        }
+        if (!next)
+            break;
+        next->finished = true;
+        next->rank = nextRank_++;
+    }
+}
+
+void ArrivalTimeHistogram::clear()
+{
+    for (auto &bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sumMicros_.store(0, std::memory_order_relaxed);
+    minMicros_.store(UINT64_MAX, std::memory_order_relaxed);
+    maxMicros_.store(0, std::memory_order_relaxed);
+}
+
+int ArrivalTimeHistogram::bucketFor(double ms)
+{
+    if (!(ms >= 1.0))
+        return 0;
+    // ms = frac * 2^exp with frac in [0.5, 1) -> octave = exp - 1, position in octave = 2*frac - 1
+    int exp = 0;
+    double frac = std::frexp(ms, &exp);
+    int octave = exp - 1;
+    if (octave >= OCTAVES)
+        return NUM_BUCKETS - 1;
+    int sub = static_cast<int>((frac * 2.0 - 1.0) * SUB_BUCKETS);
+    return 1 + octave * SUB_BUCKETS + std::min(sub, SUB_BUCKETS - 1);
+}
+
+double ArrivalTimeHistogram::bucketLowerMs(int bucket)
+{
+    if (bucket <= 0)
+        return 0.0;
+    int octave = (bucket - 1) / SUB_BUCKETS;
+    int sub = (bucket - 1) % SUB_BUCKETS;
+    return std::ldexp(1.0 + static_cast<double>(sub) / SUB_BUCKETS, octave);
+}
+
+void ArrivalTimeHistogram::record(double ms)
+{
+    ms = std::max(ms, 0.0);
+    buckets_[bucketFor(ms)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    // sum/min/max in whole microseconds so they fit plain integer atomics
+    std::uint64_t micros = static_cast<std::uint64_t>(ms * 1000.0);
+    sumMicros_.fetch_add(micros, std::memory_order_relaxed);
+
+    std::uint64_t seen = minMicros_.load(std::memory_order_relaxed);
+    while (micros < seen && !minMicros_.compare_exchange_weak(seen, micros, std::memory_order_relaxed))
+    {
+    }
+    seen = maxMicros_.load(std::memory_order_relaxed);
+    while (micros > seen && !maxMicros_.compare_exchange_weak(seen, micros, std::memory_order_relaxed))
     {
-        stat.firstArrivalTimeMs = elapsedMs;
     }
-    stat.lastArrivalTimeMs = elapsedMs;
+}
+
+double ArrivalTimeHistogram::mean() const
+{
+    std::uint64_t n = count();
+    return n > 0 ? sumMicros_.load(std::memory_order_relaxed) / 1000.0 / static_cast<double>(n) : 0.0;
+}
+
+double ArrivalTimeHistogram::minMs() const
+{
+    return count() > 0 ? minMicros_.load(std::memory_order_relaxed) / 1000.0 : -1.0;
+}
 
-    // updating average
-    stat.avgArrivalTimeMs = (stat.avgArrivalTimeMs * (stat.arrivedAgents - 1) + elapsedMs) / stat.arrivedAgents;
+double ArrivalTimeHistogram::maxMs() const
+{
+    return count() > 0 ? maxMicros_.load(std::memory_order_relaxed) / 1000.0 : -1.0;
+}
 
-    // check if it finished
-    if (stat.arrivedAgents >= stat.totalAgents && !stat.finished)
+double ArrivalTimeHistogram::percentile(double p) const
+{
+    std::uint64_t n = count();
+    if (n == 0)
+        return -1.0;
+
+    // walk the buckets until we pass the target rank then interpolate inside that bucket.
+    // result is clamped to the exact min/max so p0/p100 are never off by a bucket width
+    double target = std::clamp(p, 0.0, 1.0) * static_cast<double>(n);
+    double seen = 0.0;
+    for (int b = 0; b < NUM_BUCKETS; b++)
     {
-        stat.finished = true;
-        stat.rank = nextRank_++;
+        double inBucket = static_cast<double>(buckets_[b].load(std::memory_order_relaxed));
+        if (inBucket <= 0.0)
+            continue;
+        if (seen + inBucket >= target)
+        {
+            double lower = bucketLowerMs(b);
+            double upper = (b + 1 < NUM_BUCKETS) ? bucketLowerMs(b + 1) : maxMs();
+            double t = (target - seen) / inBucket;
+            return std::clamp(lower + (upper - lower) * t, minMs(), maxMs());
+        }
+        seen += inBucket;
     }
+    return maxMs();
 }
 
 AlgorithmStats &BenchmarkManager::getStatsMutable(int speciesIndex)
@@ -323,9 +605,16 @@ AlgorithmStats &BenchmarkManager::getStatsMutable(int speciesIndex)
 }
 
 double BenchmarkManager::getBenchmarkElapsedMs() const
+{
+    return benchmarkActive_ ? raceTimeMs_ : 0.0;
+}
+
+double BenchmarkManager::getBenchmarkWallMs() const
 {
     if (!benchmarkActive_)
         return 0.0;
+    if (benchmarkComplete_)
+        return completedWallMs_;
 
     auto now = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(now - benchmarkStartTime_).count();
@@ -388,28 +677,6 @@ std::pair<float, float> BenchmarkManager::getSpawnPosition(int speciesIndex, int
     return {x, y};
 }
 
-void BenchmarkManager::updateRankings()
-{
-    // display ordering without mutating the authoritative stats array
-    // and sorting by arrival count (descending in this case) then by first arrival time
-    std::vector<size_t> indices(stats_.size());
-    for (size_t i = 0; i < indices.size(); i++)
-        indices[i] = i;
-
-    std::sort(indices.begin(), indices.end(), [this](size_t a, size_t b)
-              {
-        if (stats_[a].finished != stats_[b].finished) {
-            return stats_[a].finished; // finished comes first
-        }
-        if (stats_[a].finished && stats_[b].finished) {
-            return stats_[a].lastArrivalTimeMs < stats_[b].lastArrivalTimeMs;
-        }
-        if (stats_[a].arrivedAgents != stats_[b].arrivedAgents) {
-            return stats_[a].arrivedAgents > stats_[b].arrivedAgents;
-        }
-        return stats_[a].firstArrivalTimeMs < stats_[b].firstArrivalTimeMs; });
-}
-
 std::string BenchmarkManager::estimateBigO(double ratio) const
 {
     // empirical doubling method: if T(2N)/T(N) = r then:
@@ -461,20 +728,76 @@ void BenchmarkManager::runDoublingExperiment()
             GridCell goal{exitX, exitY};
             GridCell start = pathfinder_.worldToGrid(spawnMargin_ * 0.5f, height_ * 0.5f);
             double totalMs = 0.0;
+            // the workspace peak over the trials, on top of what the pathfinder holds anyway (obstacle grid)
+            const size_t baselineBytes = MemoryTracker::live(MemoryTag::Pathfinder);
+            MemoryTracker::resetPeak(MemoryTag::Pathfinder);
             for (int t = 0; t < trials; ++t)
             {
                 PathResult res = pathfinder_.findPath(algo, start, goal);
                 totalMs += res.computeTimeMs;
             }
+            const size_t workspaceBytes = MemoryTracker::peak(MemoryTag::Pathfinder) - baselineBytes;
             double avgMs = totalMs / trials;
             int problemSize = pathfinder_.getMazeCellCount();
             double ratio = (level == 1 || prevTime <= 0.0) ? 0.0 : avgMs / prevTime;
             std::string est = (level == 1) ? "--" : estimateBigO(ratio);
-            doublingResults_.push_back({algo, getAlgorithmName(algo), problemSize, avgMs, ratio, est});
+            doublingResults_.push_back({algo, getAlgorithmName(algo), problemSize, avgMs, ratio, est, workspaceBytes});
             prevTime = avgMs;
         }
     }
 
+    // bidirectional bfs, the one thread version against the concurrent one on the same mazes
+    bidirectionalTimings_.clear();
+    for (int level = 1; level <= 6; ++level)
+    {
+        pathfinder_.generateTrueMaze(level);
+        auto [exitX, exitY] = pathfinder_.getMazeExit();
+        GridCell goal{exitX, exitY};
+        GridCell start = pathfinder_.worldToGrid(spawnMargin_ * 0.5f, height_ * 0.5f);
+        BidirectionalTiming timing{pathfinder_.getMazeCellCount(), 0.0, 0.0, 0, 0};
+        for (int t = 0; t < trials; ++t)
+        {
+            PathResult sequential = pathfinder_.findPathBidirectional(start, goal);
+            PathResult parallel = pathfinder_.findPathBidirectionalParallel(start, goal);
+            timing.sequentialMs += sequential.computeTimeMs / trials;
+            timing.parallelMs += parallel.computeTimeMs / trials;
+            timing.sequentialHops = static_cast<int>(sequential.path.size());
+            timing.parallelHops = static_cast<int>(parallel.path.size());
+        }
+        bidirectionalTimings_.push_back(timing);
+    }
+
+    // whole maze distance fields from the spawn: delta stepping timed against dijkstra, and checked against it
+    distanceFieldTimings_.clear();
+    for (int level = 1; level <= 6; ++level)
+    {
+        pathfinder_.generateTrueMaze(level);
+        GridCell start = pathfinder_.worldToGrid(spawnMargin_ * 0.5f, height_ * 0.5f);
+        DistanceFieldTiming timing{pathfinder_.getMazeCellCount(), 0.0, 0.0, true};
+        for (int t = 0; t < trials; ++t)
+        {
+            auto sequentialStart = std::chrono::high_resolution_clock::now();
+            Pathfinder::DistanceField sequential = pathfinder_.computeDistanceField(start);
+            auto parallelStart = std::chrono::high_resolution_clock::now();
+            Pathfinder::DistanceField parallel = pathfinder_.computeDistanceFieldParallel(start);
+            auto parallelEnd = std::chrono::high_resolution_clock::now();
+            timing.sequentialMs += std::chrono::duration<double, std::milli>(parallelStart - sequentialStart).count() / trials;
+            timing.parallelMs += std::chrono::duration<double, std::milli>(parallelEnd - parallelStart).count() / trials;
+
+            // same edges either way, a cell only differs by float rounding of the summed costs
+            for (size_t i = 0; i < sequential.size() && timing.matches; ++i)
+            {
+                if (sequential[i] != parallel[i] && !(std::abs(sequential[i] - parallel[i]) < 1e-3f))
+                {
+                    timing.matches = false;
+                    SLIME_LOG(Log::Level::Warn, "[DOUBLING] delta stepping field differs from dijkstra at cell " << i
+                              << " (" << sequential[i] << " vs " << parallel[i] << "), N=" << timing.problemSize);
+                }
+            }
+        }
+        distanceFieldTimings_.push_back(timing);
+    }
+
     // restoration of maze state
     pathfinder_ = originalPathfinder;
     mazeDifficulty_ = savedDifficulty;
@@ -520,12 +843,28 @@ void BenchmarkManager::drawGoal(sf::RenderTarget &target) const
     target.draw(inner);
 }
 
-void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font) const
+void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font)
 {
-    // HUD shows all the timing, standings, doubling results, and control hints
+    // HUD shows all the timing, standings, doubling results, and control hints.
+    // retained: every line keeps its glyph geometry and only gets relaid out when its values change
     float hudX = 10.0f;
     float hudY = 10.0f;
     float lineHeight = 22.0f;
+    hud_.beginFrame(font);
+
+    auto style = [](unsigned characterSize, sf::Color color, float refreshSeconds = 0.0f)
+    {
+        RetainedHud::TextStyle textStyle;
+        textStyle.characterSize = characterSize;
+        textStyle.fillColor = color;
+        textStyle.refreshSeconds = refreshSeconds;
+        return textStyle;
+    };
+    auto staticLine = [&](int id, unsigned characterSize, sf::Color color, const char *text, sf::Vector2f position)
+    {
+        hud_.text(id, style(characterSize, color), [&](HudWriter &out) { out << text; });
+        hud_.place(id, position);
+    };
 
     // count enabled algorithms for background sizing
     size_t enabledCount = 0;
@@ -535,38 +874,30 @@ void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font) c
     if (enabledCount == 0) enabledCount = stats_.size();  // fallback if not initialized
 
     // the background
-    sf::RectangleShape bg;
-    bg.setPosition(sf::Vector2f(hudX - 5.0f, hudY - 5.0f));
-    bg.setSize(sf::Vector2f(320.0f, 30.0f + enabledCount * lineHeight + 60.0f));
-    bg.setFillColor(sf::Color(0, 0, 0, 180));
-    target.draw(bg);
-
-    sf::Text title(font);
-    title.setString("Benchmark");
-    title.setCharacterSize(18);
-    title.setFillColor(sf::Color::White);
-    title.setStyle(sf::Text::Bold);
-    title.setPosition(sf::Vector2f(hudX, hudY));
-    target.draw(title);
+    hud_.rect(HUD_BACKGROUND, sf::FloatRect({hudX - 5.0f, hudY - 5.0f}, {450.0f, 30.0f + enabledCount * lineHeight + 76.0f}),
+              sf::Color(0, 0, 0, 180));
+
+    RetainedHud::TextStyle titleStyle = style(18, sf::Color::White);
+    titleStyle.bold = true;
+    hud_.text(HUD_TITLE, titleStyle, [](HudWriter &out) { out << "Benchmark"; });
+    hud_.place(HUD_TITLE, {hudX, hudY});
 
     hudY += 28.0f;
 
-    // elapsed times
-    std::ostringstream timeStr;
-    timeStr << std::fixed << std::setprecision(1) << "Time: " << getBenchmarkElapsedMs() / 1000.0 << "s";
-    if (benchmarkComplete_)
-        timeStr << " [COMPLETE]";
-    else if (benchmarkPaused_)
-        timeStr << " [PAUSED]";
-    else if (!benchmarkActive_)
-        timeStr << " [READY]";
-
-    sf::Text timeText(font);
-    timeText.setString(timeStr.str());
-    timeText.setCharacterSize(14);
-    timeText.setFillColor(sf::Color(200, 200, 200));
-    timeText.setPosition(sf::Vector2f(hudX, hudY));
-    target.draw(timeText);
+    // elapsed times (ticks every frame while running, so relaid out 10x a second at most)
+    const double elapsedMs = getBenchmarkElapsedMs();
+    const double wallMs = getBenchmarkWallMs();
+    hud_.text(HUD_TIME, style(14, sf::Color(200, 200, 200), 0.1f), [&](HudWriter &out)
+    {
+        out << std::fixed << std::setprecision(1) << "Time: " << elapsedMs / 1000.0 << "s (wall " << wallMs / 1000.0 << "s)";
+        if (benchmarkComplete_)
+            out << " [COMPLETE]";
+        else if (benchmarkPaused_)
+            out << " [PAUSED]";
+        else if (!benchmarkActive_)
+            out << " [READY]";
+    });
+    hud_.place(HUD_TIME, {hudX, hudY});
 
     hudY += 24.0f;
 
@@ -585,47 +916,50 @@ void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font) c
         return a.second->firstArrivalTimeMs < b.second->firstArrivalTimeMs; 
     });
 
-    // stats for each algorithm
+    // stats for each algorithm (one widget per row, arrivals change often while racing)
     int displayRank = 1;
     for (const auto& [idx, stat] : sortedWithIndex)
     {
-        std::ostringstream ss;
-
-        // ranking indicator
-        if (stat->finished)
+        const int rowId = HUD_ALGORITHM_ROWS + displayRank - 1;
+        hud_.text(rowId, style(13, stat->color, 0.1f), [&](HudWriter &out)
         {
-            ss << "#" << stat->rank << " ";
-        }
-        else
-        {
-            ss << "   ";
-        }
+            // ranking indicator
+            if (stat->finished)
+            {
+                out << "#" << stat->rank << " ";
+            }
+            else
+            {
+                out << "   ";
+            }
 
-        // progress bar
-        int barWidth = 10;
-        int filled = static_cast<int>(stat->getArrivalPercent() / 100.0f * barWidth);
-        ss << "[";
-        for (int i = 0; i < barWidth; i++)
-        {
-            ss << (i < filled ? "=" : " ");
-        }
-        ss << "] ";
+            // progress bar
+            int barWidth = 10;
+            int filled = static_cast<int>(stat->getArrivalPercent() / 100.0f * barWidth);
+            out << "[";
+            for (int i = 0; i < barWidth; i++)
+            {
+                out << (i < filled ? "=" : " ");
+            }
+            out << "] ";
 
-        // the name and stats
-        ss << std::setw(14) << std::left << stat->name << " ";
-        ss << std::setw(4) << std::right << stat->arrivedAgents << "/" << stat->totalAgents;
+            // the name and stats
+            out << std::setw(14) << std::left << stat->name << " ";
+            out << std::setw(4) << std::right << stat->arrivedAgents << "/" << stat->totalAgents;
 
-        if (stat->firstArrivalTimeMs > 0)
-        {
-            ss << " (" << std::fixed << std::setprecision(1) << stat->firstArrivalTimeMs / 1000.0 << "s)";
-        }
-
-        sf::Text line(font);
-        line.setString(ss.str());
-        line.setCharacterSize(13);
-        line.setFillColor(stat->color);
-        line.setPosition(sf::Vector2f(hudX, hudY));
-        target.draw(line);
+            if (stat->firstArrivalTimeMs > 0)
+            {
+                out << " (" << std::fixed << std::setprecision(1) << stat->firstArrivalTimeMs / 1000.0 << "s";
+                // p50/p95 come from the arrival histogram so they cost nothing per sample
+                if (stat->p50ArrivalTimeMs >= 0.0)
+                {
+                    out << " p50 " << stat->p50ArrivalTimeMs / 1000.0 << "s"
+                        << " p95 " << stat->p95ArrivalTimeMs / 1000.0 << "s";
+                }
+                out << ")";
+            }
+        });
+        hud_.place(rowId, {hudX, hudY});
 
         hudY += lineHeight;
         displayRank++;
@@ -633,17 +967,25 @@ void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font) c
 
     // all the complexity info for empirical doubling
     hudY += 8.0f;
-    std::ostringstream mazeStr;
     int level = 1 + static_cast<int>(mazeDifficulty_ * 5.0f);
     level = std::clamp(level, 1, 6);
     int cells = pathfinder_.getMazeCellCount();
-    mazeStr << "True Maze - Level " << level << " (N = " << cells << " cells)";
-    sf::Text mazeText(font);
-    mazeText.setString(mazeStr.str());
-    mazeText.setCharacterSize(12);
-    mazeText.setFillColor(sf::Color(180, 180, 255));
-    mazeText.setPosition(sf::Vector2f(hudX, hudY));
-    target.draw(mazeText);
+    hud_.text(HUD_MAZE, style(12, sf::Color(180, 180, 255)), [&](HudWriter &out)
+              { out << "True Maze - Level " << level << " (N = " << cells << " cells)"; });
+    hud_.place(HUD_MAZE, {hudX, hudY});
+
+    // what the race is costing: explorer state (per agent and shared), pathfinder workspaces, agents
+    hudY += 16.0f;
+    hud_.text(HUD_MEMORY, style(12, sf::Color(180, 220, 180), 0.25f), [&](HudWriter &out)
+    {
+        out << std::fixed << std::setprecision(1) << "Memory MB: ";
+        for (MemoryTag tag : {MemoryTag::Exploration, MemoryTag::Pathfinder, MemoryTag::Agents})
+        {
+            out << MemoryTracker::name(tag) << " " << MemoryTracker::displayMB(MemoryTracker::live(tag))
+                << " (peak " << MemoryTracker::displayMB(MemoryTracker::peak(tag)) << ")  ";
+        }
+    });
+    hud_.place(HUD_MEMORY, {hudX, hudY});
 
     // doubling results summary - draw on RIGHT SIDE of screen
     if (!doublingResults_.empty())
@@ -652,33 +994,19 @@ void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font) c
         float rightHudY = 10.0f;
 
         // background for right panel
-        sf::RectangleShape rightBg;
-        rightBg.setPosition(sf::Vector2f(rightHudX - 5.0f, rightHudY - 5.0f));
-        rightBg.setSize(sf::Vector2f(330.0f, 260.0f));
-        rightBg.setFillColor(sf::Color(0, 0, 0, 180));
-        target.draw(rightBg);
-
-        sf::Text dblTitle(font);
-        dblTitle.setString("Empirical Doubling");
-        dblTitle.setCharacterSize(18);
-        title.setFillColor(sf::Color::White);
-        title.setStyle(sf::Text::Bold);
-        dblTitle.setFillColor(sf::Color(200, 200, 200));
-        dblTitle.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(dblTitle);
+        hud_.rect(HUD_DOUBLING_BACKGROUND, sf::FloatRect({rightHudX - 5.0f, rightHudY - 5.0f}, {330.0f, 292.0f}),
+                  sf::Color(0, 0, 0, 180));
+
+        staticLine(HUD_DOUBLING_TITLE, 18, sf::Color(200, 200, 200), "Empirical Doubling", {rightHudX, rightHudY});
         rightHudY += 22.0f;
 
-        sf::Text dblsubTitle(font);
-        dblsubTitle.setString("(pathfind compute time)");
-        dblsubTitle.setCharacterSize(12);
-        dblsubTitle.setFillColor(sf::Color(200, 200, 200));
-        dblsubTitle.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(dblsubTitle);
+        staticLine(HUD_DOUBLING_SUBTITLE, 12, sf::Color(200, 200, 200), "(pathfind compute time)", {rightHudX, rightHudY});
         rightHudY += 16.0f;
 
         // compute average ratio across all 5 transitions (levels 2-6) for each algorithm
         // results are stored as: [algo1_lvl1, algo1_lvl2, ..., algo1_lvl6, algo2_lvl1, ...]
         std::string lastAlgo;
+        int doublingRow = 0;
         for (size_t algoStart = 0; algoStart < doublingResults_.size(); algoStart += 6)
         {
             const auto &dr = doublingResults_[algoStart]; // use first result for name/color
@@ -696,100 +1024,77 @@ void BenchmarkManager::drawHUD(sf::RenderTarget &target, const sf::Font &font) c
                 }
             }
             double avgRatio = (ratioCount > 0) ? sumRatio / ratioCount : 0.0;
-            std::string avgEstimate = estimateBigO(avgRatio);
-            
-            std::ostringstream ds;
-            ds << std::setw(8) << std::left << dr.algoName
-               << " r=" << std::fixed << std::setprecision(2) << avgRatio
-               << " " << avgEstimate;
-            sf::Text dblLine(font);
-            dblLine.setString(ds.str());
-            dblLine.setCharacterSize(13);
-            dblLine.setFillColor(getAlgorithmColor(dr.algorithm));
-            dblLine.setPosition(sf::Vector2f(rightHudX, rightHudY));
-            target.draw(dblLine);
+
+            // workspace of the biggest maze
+            const size_t largestLevel = std::min(algoStart + 5, doublingResults_.size() - 1);
+            const size_t workspaceKB = doublingResults_[largestLevel].peakWorkspaceBytes / 1024;
+
+            const int rowId = HUD_DOUBLING_ROWS + doublingRow++;
+            hud_.text(rowId, style(13, getAlgorithmColor(dr.algorithm)), [&](HudWriter &out)
+            {
+                out << std::setw(8) << std::left << dr.algoName
+                    << " r=" << std::fixed << std::setprecision(2) << avgRatio
+                    << " " << estimateBigO(avgRatio)
+                    << " ws " << workspaceKB << "KB";
+            });
+            hud_.place(rowId, {rightHudX, rightHudY});
+            rightHudY += 16.0f;
+        }
+
+        // concurrent vs sequential bidirectional at the largest N
+        if (!bidirectionalTimings_.empty())
+        {
+            const BidirectionalTiming &largest = bidirectionalTimings_.back();
+            hud_.text(HUD_DOUBLING_BIDIRECTIONAL, style(13, sf::Color(200, 200, 200)), [&](HudWriter &out)
+            {
+                out << std::setw(8) << std::left << "BiBFS" << std::fixed << std::setprecision(2)
+                    << " seq " << largest.sequentialMs << "ms par " << largest.parallelMs << "ms";
+                if (largest.parallelMs > 0.0)
+                    out << " " << std::setprecision(1) << largest.sequentialMs / largest.parallelMs << "x";
+            });
+            hud_.place(HUD_DOUBLING_BIDIRECTIONAL, {rightHudX, rightHudY});
+            rightHudY += 16.0f;
+        }
+
+        // delta stepping vs dijkstra distance field at the largest N
+        if (!distanceFieldTimings_.empty())
+        {
+            const DistanceFieldTiming &largest = distanceFieldTimings_.back();
+            const sf::Color fieldColor = largest.matches ? sf::Color(200, 200, 200) : sf::Color(255, 90, 90);
+            hud_.text(HUD_DOUBLING_FIELD, style(13, fieldColor), [&](HudWriter &out)
+            {
+                out << std::setw(8) << std::left << "Field" << std::fixed << std::setprecision(2)
+                    << " dij " << largest.sequentialMs << "ms ds " << largest.parallelMs << "ms"
+                    << (largest.matches ? " ok" : " DIFF");
+            });
+            hud_.place(HUD_DOUBLING_FIELD, {rightHudX, rightHudY});
             rightHudY += 16.0f;
         }
 
         // note explaining the approximation
+        const sf::Color noteColor(130, 130, 130);
         rightHudY += 6.0f;
-        sf::Text noteText(font);
-        noteText.setString("N = maze cells (48 -> 108 -> 192 -> 432 -> 768 -> 1728)");
-        noteText.setCharacterSize(10);
-        noteText.setFillColor(sf::Color(130, 130, 130));
-        noteText.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(noteText);
+        staticLine(HUD_DOUBLING_NOTES + 0, 10, noteColor, "N = maze cells (48 -> 108 -> 192 -> 432 -> 768 -> 1728)", {rightHudX, rightHudY});
         rightHudY += 12.0f;
-        
-        sf::Text noteText2(font);
-        noteText2.setString("r = avg T(2N)/T(N) ratio across all 5 doublings");
-        noteText2.setCharacterSize(10);
-        noteText2.setFillColor(sf::Color(130, 130, 130));
-        noteText2.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(noteText2);
+        staticLine(HUD_DOUBLING_NOTES + 1, 10, noteColor, "r = avg T(2N)/T(N) ratio, ws = workspace at the largest N", {rightHudX, rightHudY});
         rightHudY += 16.0f;
-
-        sf::Text note2(font);
-        note2.setString("Scaling ~2x avg (1.78x-2.25x) due to pixel grid limits.");
-        note2.setCharacterSize(10);
-        note2.setFillColor(sf::Color(130, 130, 130));
-        note2.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(note2);
+        staticLine(HUD_DOUBLING_NOTES + 2, 10, noteColor, "Scaling ~2x avg (1.78x-2.25x) due to pixel grid limits.", {rightHudX, rightHudY});
         rightHudY += 12.0f;
-
-        sf::Text note3(font);
-        note3.setString("Mazes stress heuristics better than random graphs.");
-        note3.setCharacterSize(10);
-        note3.setFillColor(sf::Color(130, 130, 130));
-        note3.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(note3);
+        staticLine(HUD_DOUBLING_NOTES + 3, 10, noteColor, "Mazes stress heuristics better than random graphs.", {rightHudX, rightHudY});
         rightHudY += 14.0f;
-
-        sf::Text note4(font);
-        note4.setString("Computed instantly (not from the race) by calling");
-        note4.setCharacterSize(10);
-        note4.setFillColor(sf::Color(130, 130, 130));
-        note4.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(note4);
+        staticLine(HUD_DOUBLING_NOTES + 4, 10, noteColor, "Computed instantly (not from the race) by calling", {rightHudX, rightHudY});
         rightHudY += 12.0f;
-
-        sf::Text note5(font);
-        note5.setString("each algorithm directly on maze gen/reload.");
-        note5.setCharacterSize(10);
-        note5.setFillColor(sf::Color(130, 130, 130));
-        note5.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(note5);
+        staticLine(HUD_DOUBLING_NOTES + 5, 10, noteColor, "each algorithm directly on maze gen/reload.", {rightHudX, rightHudY});
         rightHudY += 14.0f;
-
-        sf::Text note6(font);
-        note6.setString("Explorers (DFS/Dijkstra/Slime) not in doubling - no");
-        note6.setCharacterSize(10);
-        note6.setFillColor(sf::Color(130, 130, 130));
-        note6.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(note6);
+        staticLine(HUD_DOUBLING_NOTES + 6, 10, noteColor, "Explorers (DFS/Dijkstra/Slime) not in doubling - no", {rightHudX, rightHudY});
         rightHudY += 12.0f;
-
-        sf::Text note7(font);
-        note7.setString("path to time; they roam until they find the goal.");
-        note7.setCharacterSize(10);
-        note7.setFillColor(sf::Color(130, 130, 130));
-        note7.setPosition(sf::Vector2f(rightHudX, rightHudY));
-        target.draw(note7);
+        staticLine(HUD_DOUBLING_NOTES + 7, 10, noteColor, "path to time; they roam until they find the goal.", {rightHudX, rightHudY});
     }
 
     hudY += 18.0f;
-    sf::Text hint(font);
-    hint.setString("SPACE: Start | R: Regen | D: Doubling | +/-: Agents");
-    hint.setCharacterSize(11);
-    hint.setFillColor(sf::Color(150, 150, 150));
-    hint.setPosition(sf::Vector2f(hudX, hudY));
-    target.draw(hint);
-    
+    staticLine(HUD_HINTS + 0, 11, sf::Color(150, 150, 150), "SPACE: Start | R: Regen | D: Doubling | +/-: Agents", {hudX, hudY});
     hudY += 14.0f;
-    sf::Text hint2(font);
-    hint2.setString("P: Pack agents | Shift+1-7: Toggle algorithm");
-    hint2.setCharacterSize(11);
-    hint2.setFillColor(sf::Color(150, 150, 150));
-    hint2.setPosition(sf::Vector2f(hudX, hudY));
-    target.draw(hint2);
+    staticLine(HUD_HINTS + 1, 11, sf::Color(150, 150, 150), "P: Pack | Shift+1-7: Toggle algorithm | Shift+SPACE: Headless", {hudX, hudY});
+
+    hud_.draw(target);
 }
@@ -0,0 +1,401 @@
+#include "EventLog.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t CHUNK_EVENTS = 4096; // events a thread collects before handing them over
+
+    const char *CSV_HEADER = "type,tick,race_ms,species,algorithm,agent,cell_x,cell_y,nodes,path_length,compute_ms,cached\n";
+
+    // log the events belong to (0 = none open), a chunk of an older log is dropped by the writer
+    std::atomic<std::uint64_t> currentLog{0};
+
+    struct Chunk
+    {
+        std::vector<EventLog::Event> events;
+        std::uint64_t log = 0;
+    };
+
+    // a thread's chunk. record() only takes its own (uncontended) mutex, flush() takes them all to
+    // sweep the chunks of threads that stay alive (the worker pool)
+    struct ThreadChunk
+    {
+        ThreadChunk();
+        ~ThreadChunk();
+        void handOverLocked();
+
+        std::mutex mutex;
+        std::unique_ptr<Chunk> chunk;
+    };
+
+    class Writer
+    {
+    public:
+        Writer() : thread_([this] { run(); }) {}
+
+        ~Writer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            thread_.join();
+        }
+
+        std::unique_ptr<Chunk> takeChunk(std::uint64_t log)
+        {
+            std::unique_ptr<Chunk> chunk;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!spare_.empty())
+                {
+                    chunk = std::move(spare_.back());
+                    spare_.pop_back();
+                }
+            }
+            if (!chunk)
+            {
+                chunk = std::make_unique<Chunk>();
+                chunk->events.reserve(CHUNK_EVENTS);
+            }
+            chunk->log = log;
+            return chunk;
+        }
+
+        void handOver(std::unique_ptr<Chunk> chunk)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(std::move(chunk));
+            }
+            wake_.notify_one();
+        }
+
+        void registerThread(ThreadChunk *local)
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            threads_.push_back(local);
+        }
+
+        void unregisterThread(ThreadChunk *local)
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            threads_.erase(std::remove(threads_.begin(), threads_.end(), local), threads_.end());
+            std::lock_guard<std::mutex> chunkLock(local->mutex);
+            local->handOverLocked();
+        }
+
+        // hands over the partly filled chunk of every thread
+        void sweepThreads()
+        {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            for (ThreadChunk *local : threads_)
+            {
+                std::lock_guard<std::mutex> chunkLock(local->mutex);
+                local->handOverLocked();
+            }
+        }
+
+        // waits until every chunk handed over so far is written
+        void drain()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            drained_.wait(lock, [&] { return queue_.empty() && !busy_; });
+            std::lock_guard<std::mutex> fileLock(fileMutex_);
+            if (file_.is_open())
+                file_.flush();
+        }
+
+        bool openFile(const std::string &path, std::uint64_t log)
+        {
+            std::lock_guard<std::mutex> lock(fileMutex_);
+            if (file_.is_open())
+                file_.close();
+            file_.open(path, std::ios::out | std::ios::trunc);
+            if (!file_)
+            {
+                fileLog_ = 0;
+                return false;
+            }
+            file_ << CSV_HEADER;
+            fileLog_ = log;
+            written_.store(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        void closeFile()
+        {
+            std::lock_guard<std::mutex> lock(fileMutex_);
+            if (file_.is_open())
+                file_.close();
+            fileLog_ = 0;
+        }
+
+        std::uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+
+    private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true)
+            {
+                wake_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+                if (queue_.empty())
+                    break; // stopping and nothing left
+                std::unique_ptr<Chunk> chunk = std::move(queue_.front());
+                queue_.pop_front();
+                busy_ = true;
+                lock.unlock();
+
+                write(*chunk);
+                chunk->events.clear();
+
+                lock.lock();
+                spare_.push_back(std::move(chunk));
+                busy_ = false;
+                drained_.notify_all();
+            }
+        }
+
+        void write(const Chunk &chunk)
+        {
+            std::lock_guard<std::mutex> lock(fileMutex_);
+            if (chunk.log != fileLog_ || !file_.is_open())
+                return; // events of a log that was closed in the meantime
+
+            text_.clear();
+            char row[256];
+            for (const EventLog::Event &event : chunk.events)
+            {
+                const int length = std::snprintf(row, sizeof(row), "%s,%llu,%.3f,%d,%s,%d,%d,%d,%d,%.3f,%.4f,%d\n",
+                                                 EventLog::typeName(event.type), static_cast<unsigned long long>(event.tick),
+                                                 event.raceMs, event.species, event.algorithm, event.agentId,
+                                                 event.cellX, event.cellY, event.nodes, static_cast<double>(event.pathLength),
+                                                 static_cast<double>(event.computeMs),
+                                                 event.cached ? 1 : 0);
+                text_.append(row, static_cast<std::size_t>(std::clamp(length, 0, static_cast<int>(sizeof(row)) - 1)));
+            }
+            file_.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+            written_.fetch_add(chunk.events.size(), std::memory_order_relaxed);
+        }
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::condition_variable drained_;
+        std::deque<std::unique_ptr<Chunk>> queue_;
+        std::vector<std::unique_ptr<Chunk>> spare_;
+        bool busy_ = false;
+        bool stop_ = false;
+
+        std::mutex registryMutex_;
+        std::vector<ThreadChunk *> threads_;
+
+        std::mutex fileMutex_;
+        std::ofstream file_;
+        std::uint64_t fileLog_ = 0;
+        std::string text_;
+        std::atomic<std::uint64_t> written_{0};
+
+        std::thread thread_;
+    };
+
+    Writer &writer()
+    {
+        static Writer instance;
+        return instance;
+    }
+
+    ThreadChunk::ThreadChunk() { writer().registerThread(this); }
+
+    ThreadChunk::~ThreadChunk() { writer().unregisterThread(this); }
+
+    void ThreadChunk::handOverLocked()
+    {
+        if (chunk && !chunk->events.empty())
+            writer().handOver(std::move(chunk));
+        chunk.reset();
+    }
+
+    thread_local ThreadChunk threadChunk;
+
+    std::uint64_t nextLog = 0; // open / close come from the main thread
+}
+
+namespace EventLog
+{
+    const char *typeName(Type type)
+    {
+        switch (type)
+        {
+        case Type::Arrival:
+            return "arrival";
+        case Type::PathComputed:
+            return "path";
+        case Type::ExplorationStep:
+            return "explore";
+        case Type::Respawn:
+            return "respawn";
+        default:
+            return "?";
+        }
+    }
+
+    bool open(const std::string &path)
+    {
+        close();
+        const std::uint64_t log = ++nextLog;
+        if (!writer().openFile(path, log))
+            return false;
+        currentLog.store(log, std::memory_order_release);
+        return true;
+    }
+
+    void close()
+    {
+        if (currentLog.load(std::memory_order_acquire) == 0)
+            return;
+        flush();
+        currentLog.store(0, std::memory_order_release);
+        writer().closeFile();
+    }
+
+    bool isOpen() { return currentLog.load(std::memory_order_relaxed) != 0; }
+
+    void record(const Event &event)
+    {
+        const std::uint64_t log = currentLog.load(std::memory_order_relaxed);
+        if (log == 0)
+            return;
+
+        ThreadChunk &local = threadChunk;
+        std::lock_guard<std::mutex> lock(local.mutex);
+        if (local.chunk && local.chunk->log != log)
+            local.handOverLocked(); // left over from an earlier log, the writer drops it
+        if (!local.chunk)
+            local.chunk = writer().takeChunk(log);
+
+        local.chunk->events.push_back(event);
+        if (local.chunk->events.size() >= CHUNK_EVENTS)
+            local.handOverLocked();
+    }
+
+    void flush()
+    {
+        writer().sweepThreads();
+        writer().drain();
+    }
+
+    std::uint64_t written() { return writer().written(); }
+
+    std::vector<SummaryRow> summarize(const std::string &path)
+    {
+        std::ifstream in(path);
+        std::string line;
+        if (!std::getline(in, line))
+            return {};
+
+        // per algorithm, per metric samples. explorer steps and respawns are counted per agent first
+        std::map<std::string, std::map<std::string, std::vector<double>>> samples;
+        std::map<std::pair<std::string, int>, double> stepsPerAgent, respawnsPerAgent;
+
+        std::vector<std::string> fields;
+        while (std::getline(in, line))
+        {
+            fields.clear();
+            std::stringstream row(line);
+            std::string field;
+            while (std::getline(row, field, ','))
+                fields.push_back(field);
+            if (fields.size() < 12)
+                continue;
+
+            const std::string &type = fields[0];
+            const std::string &algorithm = fields[4];
+            const int agent = std::atoi(fields[5].c_str());
+            if (type == "arrival")
+            {
+                samples[algorithm]["arrival ms"].push_back(std::atof(fields[2].c_str()));
+            }
+            else if (type == "path")
+            {
+                samples[algorithm]["path length"].push_back(std::atof(fields[9].c_str()));
+                if (fields[11] == "0")
+                {
+                    // search cost only for paths that were actually searched
+                    samples[algorithm]["path nodes"].push_back(std::atof(fields[8].c_str()));
+                    samples[algorithm]["path compute ms"].push_back(std::atof(fields[10].c_str()));
+                }
+            }
+            else if (type == "explore")
+            {
+                stepsPerAgent[{algorithm, agent}] += 1.0;
+            }
+            else if (type == "respawn")
+            {
+                respawnsPerAgent[{algorithm, agent}] += 1.0;
+            }
+        }
+        for (const auto &[key, steps] : stepsPerAgent)
+            samples[key.first]["explore steps/agent"].push_back(steps);
+        for (const auto &[key, respawns] : respawnsPerAgent)
+            samples[key.first]["respawns/agent"].push_back(respawns);
+
+        std::vector<SummaryRow> rows;
+        for (auto &[algorithm, metrics] : samples)
+        {
+            for (auto &[metric, values] : metrics)
+            {
+                if (values.empty())
+                    continue;
+                std::sort(values.begin(), values.end());
+                SummaryRow summary;
+                summary.algorithm = algorithm;
+                summary.metric = metric;
+                summary.count = values.size();
+                double sum = 0.0;
+                for (double value : values)
+                    sum += value;
+                summary.mean = sum / values.size();
+                // nearest rank percentiles
+                auto percentile = [&](double p)
+                {
+                    const std::size_t rank = static_cast<std::size_t>(std::ceil(p * values.size()));
+                    return values[std::clamp<std::size_t>(rank, 1, values.size()) - 1];
+                };
+                summary.p50 = percentile(0.50);
+                summary.p95 = percentile(0.95);
+                summary.max = values.back();
+                rows.push_back(summary);
+            }
+        }
+        return rows;
+    }
+
+    void printSummary(const std::vector<SummaryRow> &rows, std::ostream &out)
+    {
+        out << std::left << std::setw(10) << "algorithm" << std::setw(22) << "metric" << std::right
+            << std::setw(9) << "n" << std::setw(12) << "mean" << std::setw(12) << "p50"
+            << std::setw(12) << "p95" << std::setw(12) << "max" << '\n';
+        out << std::fixed << std::setprecision(2);
+        for (const SummaryRow &row : rows)
+        {
+            out << std::left << std::setw(10) << row.algorithm << std::setw(22) << row.metric << std::right
+                << std::setw(9) << row.count << std::setw(12) << row.mean << std::setw(12) << row.p50
+                << std::setw(12) << row.p95 << std::setw(12) << row.max << '\n';
+        }
+    }
+}
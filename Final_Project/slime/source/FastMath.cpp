@@ -0,0 +1,218 @@
+#include "FastMath.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// same as the header: the kernels stay out of -ffast-math and contraction (see FastMath.h)
+#if defined(__clang__)
+#pragma float_control(precise, on, push)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC optimize("no-fast-math", "fp-contract=off")
+#endif
+
+namespace
+{
+    using namespace FastMath::detail;
+
+#if defined(__AVX2__)
+    constexpr size_t LANES = 8;
+
+    inline __m256 expPoly8(__m256 r)
+    {
+        __m256 p = _mm256_set1_ps(1.0f / 720.0f);
+        p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 120.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 24.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f / 6.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(0.5f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f));
+        return _mm256_add_ps(_mm256_mul_ps(p, r), _mm256_set1_ps(1.0f));
+    }
+
+    // 2^n for n already rounded to an integer in [-126, 127]
+    inline __m256 pow2i8(__m256 n)
+    {
+        __m256i bits = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+        return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 23));
+    }
+
+    inline __m256 exp8(__m256 x)
+    {
+        const __m256 underflow = _mm256_cmp_ps(x, _mm256_set1_ps(-87.3f), _CMP_GE_OQ);
+        x = _mm256_min_ps(x, _mm256_set1_ps(88.0f));
+        x = _mm256_max_ps(x, _mm256_set1_ps(-87.3f));
+        const __m256 n = _mm256_floor_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(LOG2E)), _mm256_set1_ps(0.5f)));
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(n, _mm256_set1_ps(LN2_HI)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(n, _mm256_set1_ps(LN2_LO)));
+        return _mm256_and_ps(_mm256_mul_ps(expPoly8(r), pow2i8(n)), underflow);
+    }
+
+    inline __m256 exp2_8(__m256 x)
+    {
+        const __m256 underflow = _mm256_cmp_ps(x, _mm256_set1_ps(-126.0f), _CMP_GE_OQ);
+        x = _mm256_min_ps(x, _mm256_set1_ps(127.0f));
+        x = _mm256_max_ps(x, _mm256_set1_ps(-126.0f));
+        const __m256 n = _mm256_floor_ps(_mm256_add_ps(x, _mm256_set1_ps(0.5f)));
+        const __m256 r = _mm256_mul_ps(_mm256_sub_ps(x, n), _mm256_set1_ps(LN2));
+        return _mm256_and_ps(_mm256_mul_ps(expPoly8(r), pow2i8(n)), underflow);
+    }
+
+    inline __m256 log2_8(__m256 x)
+    {
+        const __m256i bits = _mm256_castps_si256(x);
+        __m256 e = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xff)),
+                                                       _mm256_set1_epi32(127)));
+        __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)),
+                                                       _mm256_set1_epi32(0x3f800000)));
+        // fold the top half of the mantissa range down so |t| stays small
+        const __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+        m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+        e = _mm256_add_ps(e, _mm256_and_ps(big, _mm256_set1_ps(1.0f)));
+
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 t = _mm256_div_ps(_mm256_sub_ps(m, one), _mm256_add_ps(m, one));
+        const __m256 t2 = _mm256_mul_ps(t, t);
+        __m256 p = _mm256_set1_ps(1.0f / 9.0f);
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 7.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 5.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), _mm256_set1_ps(1.0f / 3.0f));
+        p = _mm256_add_ps(_mm256_mul_ps(p, t2), one);
+        return _mm256_add_ps(e, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, p), _mm256_set1_ps(2.0f)), _mm256_set1_ps(LOG2E)));
+    }
+
+    void expBlock(const float *in, float *out)
+    {
+        _mm256_storeu_ps(out, exp8(_mm256_loadu_ps(in)));
+    }
+
+    void powBlock(const float *in, float exponent, float *out)
+    {
+        const __m256 x = _mm256_loadu_ps(in);
+        const __m256 positive = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ);
+        const __m256 y = exp2_8(_mm256_mul_ps(_mm256_set1_ps(exponent), log2_8(x)));
+        _mm256_storeu_ps(out, _mm256_and_ps(y, positive));
+    }
+
+#elif defined(__ARM_NEON)
+    constexpr size_t LANES = 4;
+
+    inline float32x4_t expPoly4(float32x4_t r)
+    {
+        float32x4_t p = vdupq_n_f32(1.0f / 720.0f);
+        p = vmlaq_f32(vdupq_n_f32(1.0f / 120.0f), p, r);
+        p = vmlaq_f32(vdupq_n_f32(1.0f / 24.0f), p, r);
+        p = vmlaq_f32(vdupq_n_f32(1.0f / 6.0f), p, r);
+        p = vmlaq_f32(vdupq_n_f32(0.5f), p, r);
+        p = vmlaq_f32(vdupq_n_f32(1.0f), p, r);
+        return vmlaq_f32(vdupq_n_f32(1.0f), p, r);
+    }
+
+    inline float32x4_t pow2i4(float32x4_t n)
+    {
+        int32x4_t bits = vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127));
+        return vreinterpretq_f32_s32(vshlq_n_s32(bits, 23));
+    }
+
+    inline float32x4_t exp4(float32x4_t x)
+    {
+        const uint32x4_t underflow = vcgeq_f32(x, vdupq_n_f32(-87.3f));
+        x = vminq_f32(x, vdupq_n_f32(88.0f));
+        x = vmaxq_f32(x, vdupq_n_f32(-87.3f));
+        const float32x4_t n = vrndmq_f32(vmlaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(LOG2E)));
+        float32x4_t r = vmlsq_f32(x, n, vdupq_n_f32(LN2_HI));
+        r = vmlsq_f32(r, n, vdupq_n_f32(LN2_LO));
+        const float32x4_t y = vmulq_f32(expPoly4(r), pow2i4(n));
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), underflow));
+    }
+
+    inline float32x4_t exp2_4(float32x4_t x)
+    {
+        const uint32x4_t underflow = vcgeq_f32(x, vdupq_n_f32(-126.0f));
+        x = vminq_f32(x, vdupq_n_f32(127.0f));
+        x = vmaxq_f32(x, vdupq_n_f32(-126.0f));
+        const float32x4_t n = vrndmq_f32(vaddq_f32(x, vdupq_n_f32(0.5f)));
+        const float32x4_t r = vmulq_f32(vsubq_f32(x, n), vdupq_n_f32(LN2));
+        const float32x4_t y = vmulq_f32(expPoly4(r), pow2i4(n));
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), underflow));
+    }
+
+    inline float32x4_t log2_4(float32x4_t x)
+    {
+        const uint32x4_t bits = vreinterpretq_u32_f32(x);
+        float32x4_t e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vandq_u32(vshrq_n_u32(bits, 23), vdupq_n_u32(0xff))),
+                                                vdupq_n_s32(127)));
+        float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f800000)));
+        const uint32x4_t big = vcgtq_f32(m, vdupq_n_f32(1.41421356f));
+        m = vbslq_f32(big, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+        e = vaddq_f32(e, vreinterpretq_f32_u32(vandq_u32(big, vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t t = vdivq_f32(vsubq_f32(m, one), vaddq_f32(m, one));
+        const float32x4_t t2 = vmulq_f32(t, t);
+        float32x4_t p = vdupq_n_f32(1.0f / 9.0f);
+        p = vmlaq_f32(vdupq_n_f32(1.0f / 7.0f), p, t2);
+        p = vmlaq_f32(vdupq_n_f32(1.0f / 5.0f), p, t2);
+        p = vmlaq_f32(vdupq_n_f32(1.0f / 3.0f), p, t2);
+        p = vmlaq_f32(one, p, t2);
+        return vmlaq_f32(e, vmulq_f32(t, p), vdupq_n_f32(2.0f * LOG2E));
+    }
+
+    void expBlock(const float *in, float *out)
+    {
+        vst1q_f32(out, exp4(vld1q_f32(in)));
+    }
+
+    void powBlock(const float *in, float exponent, float *out)
+    {
+        const float32x4_t x = vld1q_f32(in);
+        const uint32x4_t positive = vcgtq_f32(x, vdupq_n_f32(0.0f));
+        const float32x4_t y = exp2_4(vmulq_n_f32(log2_4(x), exponent));
+        vst1q_f32(out, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), positive)));
+    }
+
+#else
+    constexpr size_t LANES = 1;
+
+    void expBlock(const float *in, float *out) { *out = FastMath::exp(*in); }
+    void powBlock(const float *in, float exponent, float *out) { *out = FastMath::pow(*in, exponent); }
+#endif
+}
+
+namespace FastMath
+{
+    void expArray(const float *in, float *out, size_t count)
+    {
+        size_t i = 0;
+        for (; i + LANES <= count; i += LANES)
+        {
+            expBlock(in + i, out + i);
+        }
+        for (; i < count; ++i)
+        {
+            out[i] = FastMath::exp(in[i]);
+        }
+    }
+
+    void powArray(const float *in, float exponent, float *out, size_t count)
+    {
+        size_t i = 0;
+        for (; i + LANES <= count; i += LANES)
+        {
+            powBlock(in + i, exponent, out + i);
+        }
+        for (; i < count; ++i)
+        {
+            out[i] = FastMath::pow(in[i], exponent);
+        }
+    }
+}
+
+#if defined(__clang__)
+#pragma float_control(pop)
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
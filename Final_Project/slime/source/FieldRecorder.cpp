@@ -0,0 +1,760 @@
+#include "FieldRecorder.h"
+#include "TrailMap.h"
+#include "Log.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    // file layout (little endian):
+    //  header: "SLFR" version width height channels bits stepInterval keyframeInterval (u32 each after the magic)
+    //  frame:  "FRME" step(u64) keyframe(u32) payloadSize(u32), then per channel lo(f32) hi(f32) predictor(u32)
+    //          and per byte plane blockSize(u32, top bit = stored) block
+    //  index:  per frame step(u64) offset(u64, top bit = keyframe)
+    //  footer: frameCount(u64) indexOffset(u64) "SLFI"
+    constexpr char FILE_MAGIC[4] = {'S', 'L', 'F', 'R'};
+    constexpr char FRAME_MAGIC[4] = {'F', 'R', 'M', 'E'};
+    constexpr char INDEX_MAGIC[4] = {'S', 'L', 'F', 'I'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr size_t HEADER_BYTES = 4 + 7 * 4;
+    constexpr size_t FRAME_HEADER_BYTES = 4 + 8 + 4 + 4;
+    constexpr size_t FOOTER_BYTES = 8 + 8 + 4;
+    constexpr std::uint64_t KEYFRAME_BIT = std::uint64_t(1) << 63;
+    constexpr std::uint32_t STORED_BIT = 1u << 31; // block size flag: residual bytes without entropy coding
+
+    // a keyframe's range leaves this much room above its max, so growing trails dont force a keyframe every frame
+    constexpr float RANGE_HEADROOM = 0.25f;
+
+    template <typename T>
+    void put(std::string &out, T value)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.append(bytes, sizeof(T));
+    }
+
+    template <typename T>
+    bool get(const std::string &in, size_t &pos, T &value)
+    {
+        if (pos + sizeof(T) > in.size())
+            return false;
+        std::memcpy(&value, in.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+
+    // static rANS over bytes (one frequency table per channel block). residuals are heavily skewed
+    // towards 0, which rANS codes in a fraction of a bit where a byte oriented scheme needs a whole one
+    constexpr std::uint32_t PROB_BITS = 12;
+    constexpr std::uint32_t PROB_SCALE = 1u << PROB_BITS;
+    constexpr std::uint32_t RANS_L = 1u << 23;
+
+    // counts -> frequencies summing to PROB_SCALE, every symbol that occurs keeps at least 1
+    void normalizeFrequencies(const std::array<std::uint32_t, 256> &counts, size_t total, std::array<std::uint32_t, 256> &freq)
+    {
+        std::uint32_t sum = 0;
+        for (int s = 0; s < 256; ++s)
+        {
+            freq[s] = counts[s] ? std::max<std::uint32_t>(1, static_cast<std::uint32_t>(
+                                                                 static_cast<std::uint64_t>(counts[s]) * PROB_SCALE / total))
+                                : 0;
+            sum += freq[s];
+        }
+        while (sum != PROB_SCALE)
+        {
+            // the rounding error goes to (or comes from) the most frequent symbol
+            int largest = 0;
+            for (int s = 1; s < 256; ++s)
+                if (freq[s] > freq[largest])
+                    largest = s;
+            if (sum < PROB_SCALE)
+            {
+                freq[largest] += PROB_SCALE - sum;
+                sum = PROB_SCALE;
+            }
+            else
+            {
+                const std::uint32_t take = std::min(sum - PROB_SCALE, freq[largest] - 1);
+                freq[largest] -= take;
+                sum -= take;
+                if (take == 0)
+                    break; // cant happen with at most 256 symbols in 4096 slots
+            }
+        }
+    }
+
+    // block: symbolCount(u16), (symbol u8, freq u16) per symbol, then the rans stream
+    void ransEncode(const std::vector<std::uint8_t> &in, std::vector<std::uint8_t> &out)
+    {
+        out.clear();
+        std::array<std::uint32_t, 256> counts{}, freq{}, cum{};
+        for (std::uint8_t b : in)
+            counts[b]++;
+        normalizeFrequencies(counts, in.size(), freq);
+
+        std::uint16_t symbols = 0;
+        for (int s = 0, c = 0; s < 256; ++s)
+        {
+            cum[s] = c;
+            c += freq[s];
+            symbols += freq[s] ? 1 : 0;
+        }
+        out.push_back(static_cast<std::uint8_t>(symbols));
+        out.push_back(static_cast<std::uint8_t>(symbols >> 8));
+        for (int s = 0; s < 256; ++s)
+        {
+            if (!freq[s])
+                continue;
+            out.push_back(static_cast<std::uint8_t>(s));
+            out.push_back(static_cast<std::uint8_t>(freq[s]));
+            out.push_back(static_cast<std::uint8_t>(freq[s] >> 8));
+        }
+        const size_t tableBytes = out.size();
+
+        // encoded back to front so the decoder reads front to back, the bytes are reversed at the end
+        std::uint32_t x = RANS_L;
+        for (size_t i = in.size(); i-- > 0;)
+        {
+            const std::uint32_t f = freq[in[i]];
+            const std::uint32_t xMax = ((RANS_L >> PROB_BITS) << 8) * f;
+            while (x >= xMax)
+            {
+                out.push_back(static_cast<std::uint8_t>(x));
+                x >>= 8;
+            }
+            x = ((x / f) << PROB_BITS) + (x % f) + cum[in[i]];
+        }
+        for (int shift = 24; shift >= 0; shift -= 8)
+            out.push_back(static_cast<std::uint8_t>(x >> shift));
+        std::reverse(out.begin() + tableBytes, out.end());
+    }
+
+    bool ransDecode(const std::uint8_t *in, size_t size, std::uint8_t *out, size_t count)
+    {
+        const std::uint8_t *end = in + size;
+        if (size < 2)
+            return false;
+        const size_t symbols = in[0] | (in[1] << 8);
+        in += 2;
+        if (symbols == 0 || symbols > 256 || static_cast<size_t>(end - in) < symbols * 3 + 4)
+            return false;
+
+        std::array<std::uint32_t, 256> freq{}, cum{};
+        std::vector<std::uint8_t> slotSymbol(PROB_SCALE);
+        std::uint32_t total = 0;
+        for (size_t i = 0; i < symbols; ++i, in += 3)
+        {
+            const std::uint32_t f = in[1] | (in[2] << 8);
+            if (f == 0 || total + f > PROB_SCALE)
+                return false;
+            freq[in[0]] = f;
+            cum[in[0]] = total;
+            std::fill(slotSymbol.begin() + total, slotSymbol.begin() + total + f, in[0]);
+            total += f;
+        }
+        if (total != PROB_SCALE)
+            return false;
+
+        std::uint32_t x = in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+        in += 4;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const std::uint32_t slot = x & (PROB_SCALE - 1);
+            const std::uint8_t s = slotSymbol[slot];
+            out[i] = s;
+            x = freq[s] * (x >> PROB_BITS) + slot - cum[s];
+            while (x < RANS_L)
+            {
+                if (in == end)
+                    return false;
+                x = (x << 8) | *in++;
+            }
+        }
+        return in == end;
+    }
+
+    // residuals are modular in the code width, zigzag keeps small negative ones small
+    inline std::uint32_t zigzag(std::uint32_t residual, int bits)
+    {
+        const std::uint32_t mask = (1u << bits) - 1;
+        residual &= mask;
+        const std::int32_t s = (residual & (1u << (bits - 1))) ? static_cast<std::int32_t>(residual) - (1 << bits)
+                                                                : static_cast<std::int32_t>(residual);
+        return s >= 0 ? static_cast<std::uint32_t>(s) << 1 : (static_cast<std::uint32_t>(-s) << 1) - 1;
+    }
+
+    inline std::uint32_t unzigzag(std::uint32_t z)
+    {
+        return (z & 1) ? ~(z >> 1) : (z >> 1);
+    }
+
+    // how a channel block is predicted. keyframes are always spatial, the frames between pick
+    // whichever codes smaller (a stable network predicts well from the keyframe, a moving one doesnt)
+    enum Predictor : std::uint8_t
+    {
+        PREDICT_SPATIAL = 0,  // med of the left, up and up-left codes
+        PREDICT_KEYFRAME = 1, // keyframe code + med of the neighbours' difference from the keyframe
+    };
+
+    // med / LOCO-I predictor: picks the left or up neighbour at an edge, the plane through the three otherwise
+    inline int medPredict(int left, int up, int upLeft)
+    {
+        if (upLeft >= std::max(left, up))
+            return std::min(left, up);
+        if (upLeft <= std::min(left, up))
+            return std::max(left, up);
+        return left + up - upLeft;
+    }
+
+    // walks a channel in raster order with the prediction of every cell. key = nullptr for spatial,
+    // otherwise neighbours are seen as their difference from the keyframe. codes[i] must be known
+    // (encoder) or filled in by visit (decoder) before the walk moves past it
+    template <typename Visit>
+    void predictChannel(const std::uint16_t *codes, const std::uint16_t *key, int width, int height, Visit &&visit)
+    {
+        auto sample = [&](size_t i) { return key ? static_cast<int>(codes[i]) - key[i] : static_cast<int>(codes[i]); };
+        for (int y = 0; y < height; ++y)
+        {
+            const size_t row = static_cast<size_t>(y) * width;
+            for (int x = 0; x < width; ++x)
+            {
+                const size_t i = row + x;
+                const int up = y ? sample(i - width) : (x ? sample(i - 1) : 0);
+                const int left = x ? sample(i - 1) : up;
+                const int upLeft = (x && y) ? sample(i - width - 1) : up;
+                const int base = key ? key[i] : 0;
+                visit(i, static_cast<std::uint32_t>(base + medPredict(left, up, upLeft)));
+            }
+        }
+    }
+
+    // residual byte planes of one channel: zigzagged low bytes, then high bytes for 16 bit
+    void computeResiduals(const std::uint16_t *codes, const std::uint16_t *key, int width, int height, int bits,
+                          std::vector<std::uint8_t> &out)
+    {
+        const size_t cells = static_cast<size_t>(width) * height;
+        out.resize(cells * (bits / 8));
+        predictChannel(codes, key, width, height, [&](size_t i, std::uint32_t predicted)
+        {
+            const std::uint32_t z = zigzag(static_cast<std::uint32_t>(codes[i]) - predicted, bits);
+            out[i] = static_cast<std::uint8_t>(z);
+            if (bits == 16)
+                out[cells + i] = static_cast<std::uint8_t>(z >> 8);
+        });
+    }
+
+    void reconstructCodes(const std::uint8_t *residual, const std::uint16_t *key, int width, int height, int bits,
+                          std::uint16_t *codes)
+    {
+        const size_t cells = static_cast<size_t>(width) * height;
+        const std::uint32_t mask = (1u << bits) - 1;
+        predictChannel(codes, key, width, height, [&](size_t i, std::uint32_t predicted)
+        {
+            const std::uint32_t z = bits == 8 ? residual[i] : (residual[i] | (static_cast<std::uint32_t>(residual[cells + i]) << 8));
+            codes[i] = static_cast<std::uint16_t>((predicted + unzigzag(z)) & mask);
+        });
+    }
+
+    // order 0 entropy of a byte block, to pick the predictor without coding both
+    double estimateBits(const std::uint8_t *data, size_t count)
+    {
+        std::array<std::uint32_t, 256> counts{};
+        for (size_t i = 0; i < count; ++i)
+            counts[data[i]]++;
+        double bits = 0.0;
+        for (std::uint32_t n : counts)
+            if (n)
+                bits -= n * std::log2(static_cast<double>(n) / count);
+        return bits;
+    }
+}
+
+FieldRecorder::~FieldRecorder()
+{
+    stop();
+}
+
+bool FieldRecorder::start(const std::string &path, const Options &options, int width, int height, int channels)
+{
+    if (recording_ || width <= 0 || height <= 0 || channels <= 0)
+        return false;
+
+    options_ = options;
+    options_.stepInterval = std::max(1, options_.stepInterval);
+    options_.bits = options_.bits > 8 ? 16 : 8;
+    options_.keyframeInterval = std::max(1, options_.keyframeInterval);
+
+    file_.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!file_)
+        return false;
+
+    width_ = width;
+    height_ = height;
+    channels_ = channels;
+
+    std::string header;
+    header.append(FILE_MAGIC, 4);
+    put<std::uint32_t>(header, VERSION);
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(width_));
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(height_));
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(channels_));
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(options_.bits));
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(options_.stepInterval));
+    put<std::uint32_t>(header, static_cast<std::uint32_t>(options_.keyframeInterval));
+    file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+    offset_ = header.size();
+
+    index_.clear();
+    keyCodes_.clear();
+    framesSinceKey_ = 0;
+    step_ = 0;
+    stepsSinceFrame_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = false;
+        framesWritten_ = 0;
+        bytesWritten_ = offset_;
+    }
+    thread_ = std::thread([this] { run(); });
+    recording_ = true;
+    return true;
+}
+
+void FieldRecorder::stop()
+{
+    if (!recording_)
+        return;
+    recording_ = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    thread_.join();
+
+    // index + footer, the writer is done so the file is ours again
+    std::string tail;
+    const std::uint64_t indexOffset = offset_;
+    for (const IndexEntry &entry : index_)
+    {
+        put<std::uint64_t>(tail, entry.step);
+        put<std::uint64_t>(tail, entry.offset | (entry.keyframe ? KEYFRAME_BIT : 0));
+    }
+    put<std::uint64_t>(tail, index_.size());
+    put<std::uint64_t>(tail, indexOffset);
+    tail.append(INDEX_MAGIC, 4);
+    file_.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    file_.close();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytesWritten_ += tail.size();
+    spare_.clear();
+    keyCodes_ = {};
+}
+
+void FieldRecorder::onSteps(const TrailMap &trails, int steps)
+{
+    if (!recording_)
+        return;
+    step_ += static_cast<std::uint64_t>(steps);
+    stepsSinceFrame_ += steps;
+    if (stepsSinceFrame_ < options_.stepInterval)
+        return;
+    stepsSinceFrame_ = 0;
+
+    if (trails.getWidth() != width_ || trails.getHeight() != height_ || trails.getNumSpecies() != channels_)
+    {
+        // the world was resized or the species changed, a recording keeps one shape
+        SLIME_LOG(Log::Level::Warn, "[RECORD] trail map changed shape, field recording stopped");
+        stop();
+        return;
+    }
+    capture(trails);
+}
+
+void FieldRecorder::capture(const TrailMap &trails)
+{
+    std::unique_ptr<Frame> frame;
+    {
+        // backpressure: the recording keeps every frame, so a slow disk slows the simulation down
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_.wait(lock, [&] { return queue_.size() < MAX_QUEUED; });
+        if (!spare_.empty())
+        {
+            frame = std::move(spare_.back());
+            spare_.pop_back();
+        }
+    }
+    if (!frame)
+        frame = std::make_unique<Frame>();
+
+    // stored values + the lazy decay scale, the scale is applied on the writer
+    const size_t cells = static_cast<size_t>(width_) * height_;
+    frame->step = step_;
+    frame->values.resize(cells * channels_);
+    frame->scales.resize(channels_);
+    for (int c = 0; c < channels_; ++c)
+    {
+        std::memcpy(frame->values.data() + c * cells, trails.getData(c), cells * sizeof(float));
+        frame->scales[c] = trails.getChannelScale(c);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(frame));
+    }
+    wake_.notify_one();
+}
+
+void FieldRecorder::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        wake_.wait(lock, [&] { return stop_ || !queue_.empty(); });
+        if (queue_.empty())
+            break; // stopping and everything is written
+        std::unique_ptr<Frame> frame = std::move(queue_.front());
+        queue_.pop_front();
+        lock.unlock();
+
+        encodeFrame(*frame);
+
+        lock.lock();
+        spare_.push_back(std::move(frame));
+        framesWritten_++;
+        bytesWritten_ = offset_;
+        space_.notify_one();
+    }
+}
+
+void FieldRecorder::encodeFrame(const Frame &frame)
+{
+    const size_t cells = static_cast<size_t>(width_) * height_;
+    const int bits = options_.bits;
+    const std::uint32_t maxCode = (1u << bits) - 1;
+
+    // real range of every channel
+    std::vector<float> lo(channels_), hi(channels_);
+    for (int c = 0; c < channels_; ++c)
+    {
+        const float *values = frame.values.data() + c * cells;
+        const auto [minIt, maxIt] = std::minmax_element(values, values + cells);
+        const float scale = frame.scales[c];
+        lo[c] = std::min(*minIt * scale, *maxIt * scale);
+        hi[c] = std::max(*minIt * scale, *maxIt * scale);
+    }
+
+    bool keyframe = keyCodes_.empty() || framesSinceKey_ >= options_.keyframeInterval;
+    for (int c = 0; c < channels_ && !keyframe; ++c)
+        keyframe = lo[c] < keyLo_[c] || hi[c] > keyHi_[c];
+
+    if (keyframe)
+    {
+        for (int c = 0; c < channels_; ++c)
+        {
+            const float span = hi[c] - lo[c];
+            hi[c] = span > 0.0f ? hi[c] + span * RANGE_HEADROOM : lo[c] + 1.0f;
+        }
+        keyLo_ = lo;
+        keyHi_ = hi;
+        framesSinceKey_ = 0;
+    }
+    framesSinceKey_++;
+
+    codes_.resize(cells * channels_);
+    const size_t planes = bits / 8;
+
+    frameBytes_.clear();
+    frameBytes_.append(FRAME_MAGIC, 4);
+    put<std::uint64_t>(frameBytes_, frame.step);
+    put<std::uint32_t>(frameBytes_, keyframe ? 1u : 0u);
+    put<std::uint32_t>(frameBytes_, 0u); // payload size, patched below
+
+    for (int c = 0; c < channels_; ++c)
+    {
+        // quantize over the keyframe's range
+        const float *values = frame.values.data() + c * cells;
+        std::uint16_t *codes = codes_.data() + c * cells;
+        const float scale = frame.scales[c];
+        const float toCode = maxCode / (keyHi_[c] - keyLo_[c]);
+        for (size_t i = 0; i < cells; ++i)
+        {
+            const float code = std::round((values[i] * scale - keyLo_[c]) * toCode);
+            codes[i] = static_cast<std::uint16_t>(std::clamp(code, 0.0f, static_cast<float>(maxCode)));
+        }
+
+        Predictor predictor = PREDICT_SPATIAL;
+        computeResiduals(codes, nullptr, width_, height_, bits, residual_);
+        if (!keyframe)
+        {
+            computeResiduals(codes, keyCodes_.data() + c * cells, width_, height_, bits, residualAlt_);
+            if (estimateBits(residualAlt_.data(), residualAlt_.size()) < estimateBits(residual_.data(), residual_.size()))
+            {
+                predictor = PREDICT_KEYFRAME;
+                residual_.swap(residualAlt_);
+            }
+        }
+
+        put<float>(frameBytes_, keyLo_[c]);
+        put<float>(frameBytes_, keyHi_[c]);
+        put<std::uint32_t>(frameBytes_, predictor);
+
+        // every byte plane entropy coded on its own (the high plane is mostly zeros), or stored
+        // as is in the rare case that doesnt pay off
+        for (size_t plane = 0; plane < planes; ++plane)
+        {
+            planeBytes_.assign(residual_.begin() + plane * cells, residual_.begin() + (plane + 1) * cells);
+            ransEncode(planeBytes_, packed_);
+            const bool stored = packed_.size() >= planeBytes_.size();
+            const std::vector<std::uint8_t> &block = stored ? planeBytes_ : packed_;
+            put<std::uint32_t>(frameBytes_, static_cast<std::uint32_t>(block.size()) | (stored ? STORED_BIT : 0u));
+            frameBytes_.append(reinterpret_cast<const char *>(block.data()), block.size());
+        }
+    }
+
+    if (keyframe)
+        keyCodes_.assign(codes_.begin(), codes_.end());
+
+    const std::uint32_t payload = static_cast<std::uint32_t>(frameBytes_.size() - FRAME_HEADER_BYTES);
+    std::memcpy(frameBytes_.data() + FRAME_HEADER_BYTES - 4, &payload, 4);
+
+    index_.push_back({frame.step, offset_, keyframe});
+    file_.write(frameBytes_.data(), static_cast<std::streamsize>(frameBytes_.size()));
+    offset_ += frameBytes_.size();
+}
+
+std::uint64_t FieldRecorder::framesWritten() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return framesWritten_;
+}
+
+std::uint64_t FieldRecorder::bytesWritten() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytesWritten_;
+}
+
+std::uint64_t FieldRecorder::rawBytes() const
+{
+    return framesWritten() * static_cast<std::uint64_t>(width_) * height_ * channels_ * sizeof(float);
+}
+
+bool FieldReader::open(const std::string &path)
+{
+    file_.close();
+    file_.clear();
+    frames_.clear();
+    cachedKey_ = SIZE_MAX;
+
+    file_.open(path, std::ios::binary);
+    if (!file_)
+        return false;
+    file_.seekg(0, std::ios::end);
+    fileSize_ = static_cast<std::uint64_t>(file_.tellg());
+    file_.seekg(0);
+
+    bytes_.resize(HEADER_BYTES);
+    if (fileSize_ < HEADER_BYTES || !file_.read(bytes_.data(), HEADER_BYTES) || std::memcmp(bytes_.data(), FILE_MAGIC, 4) != 0)
+        return false;
+
+    size_t pos = 4;
+    std::uint32_t version = 0, width = 0, height = 0, channels = 0, bits = 0, stepInterval = 0, keyframeInterval = 0;
+    get(bytes_, pos, version);
+    get(bytes_, pos, width);
+    get(bytes_, pos, height);
+    get(bytes_, pos, channels);
+    get(bytes_, pos, bits);
+    get(bytes_, pos, stepInterval);
+    get(bytes_, pos, keyframeInterval);
+    if (version != VERSION || (bits != 8 && bits != 16) || width == 0 || height == 0 || channels == 0)
+        return false;
+    width_ = static_cast<int>(width);
+    height_ = static_cast<int>(height);
+    channels_ = static_cast<int>(channels);
+    bits_ = static_cast<int>(bits);
+    stepInterval_ = static_cast<int>(stepInterval);
+    dataStart_ = HEADER_BYTES;
+
+    // a recording that stopped early has no index, walk the frames instead
+    return loadIndex() || scanFrames();
+}
+
+bool FieldReader::loadIndex()
+{
+    if (fileSize_ < dataStart_ + FOOTER_BYTES)
+        return false;
+    bytes_.resize(FOOTER_BYTES);
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(fileSize_ - FOOTER_BYTES));
+    if (!file_.read(bytes_.data(), FOOTER_BYTES) || std::memcmp(bytes_.data() + 16, INDEX_MAGIC, 4) != 0)
+        return false;
+
+    size_t pos = 0;
+    std::uint64_t count = 0, indexOffset = 0;
+    get(bytes_, pos, count);
+    get(bytes_, pos, indexOffset);
+    if (indexOffset < dataStart_ || indexOffset + count * 16 + FOOTER_BYTES != fileSize_)
+        return false;
+
+    bytes_.resize(count * 16);
+    file_.seekg(static_cast<std::streamoff>(indexOffset));
+    if (count > 0 && !file_.read(bytes_.data(), static_cast<std::streamsize>(bytes_.size())))
+        return false;
+
+    frames_.clear();
+    frames_.reserve(count);
+    pos = 0;
+    size_t lastKey = SIZE_MAX;
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        std::uint64_t step = 0, offset = 0;
+        get(bytes_, pos, step);
+        get(bytes_, pos, offset);
+        const bool keyframe = (offset & KEYFRAME_BIT) != 0;
+        if (keyframe)
+            lastKey = frames_.size();
+        if (lastKey == SIZE_MAX)
+            return false; // a delta frame before any keyframe
+        frames_.push_back({step, offset & ~KEYFRAME_BIT, keyframe, lastKey});
+    }
+    return true;
+}
+
+bool FieldReader::scanFrames()
+{
+    frames_.clear();
+    std::uint64_t offset = dataStart_;
+    size_t lastKey = SIZE_MAX;
+    char header[FRAME_HEADER_BYTES];
+    file_.clear();
+    while (offset + FRAME_HEADER_BYTES <= fileSize_)
+    {
+        file_.seekg(static_cast<std::streamoff>(offset));
+        if (!file_.read(header, FRAME_HEADER_BYTES) || std::memcmp(header, FRAME_MAGIC, 4) != 0)
+            break;
+        std::uint64_t step;
+        std::uint32_t keyframe, payload;
+        std::memcpy(&step, header + 4, 8);
+        std::memcpy(&keyframe, header + 12, 4);
+        std::memcpy(&payload, header + 16, 4);
+        if (offset + FRAME_HEADER_BYTES + payload > fileSize_)
+            break; // the last frame was cut off
+        if (keyframe)
+            lastKey = frames_.size();
+        if (lastKey != SIZE_MAX)
+            frames_.push_back({step, offset, keyframe != 0, lastKey});
+        offset += FRAME_HEADER_BYTES + payload;
+    }
+    file_.clear();
+    std::cout << "[RECORD] no index (recording was cut short), found " << frames_.size() << " frames" << std::endl;
+    return !frames_.empty();
+}
+
+size_t FieldReader::findFrame(std::uint64_t step) const
+{
+    auto it = std::upper_bound(frames_.begin(), frames_.end(), step,
+                               [](std::uint64_t s, const FrameInfo &info) { return s < info.step; });
+    return it == frames_.begin() ? 0 : static_cast<size_t>(it - frames_.begin()) - 1;
+}
+
+bool FieldReader::decode(size_t frame, const DecodedFrame *key, DecodedFrame &out)
+{
+    const FrameInfo &info = frames_[frame];
+    char header[FRAME_HEADER_BYTES];
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(info.offset));
+    if (!file_.read(header, FRAME_HEADER_BYTES) || std::memcmp(header, FRAME_MAGIC, 4) != 0)
+        return false;
+    std::uint32_t payload;
+    std::memcpy(&payload, header + 16, 4);
+    bytes_.resize(payload);
+    if (!file_.read(bytes_.data(), payload))
+        return false;
+
+    const size_t cells = static_cast<size_t>(width_) * height_;
+    const size_t planes = bits_ / 8;
+    residual_.resize(cells * planes);
+
+    out.keyframe = info.keyframe;
+    out.lo.resize(channels_);
+    out.hi.resize(channels_);
+    out.codes.resize(cells * channels_);
+
+    size_t pos = 0;
+    for (int c = 0; c < channels_; ++c)
+    {
+        std::uint32_t predictor;
+        if (!get(bytes_, pos, out.lo[c]) || !get(bytes_, pos, out.hi[c]) || !get(bytes_, pos, predictor))
+            return false;
+        if (predictor == PREDICT_KEYFRAME && (info.keyframe || !key))
+            return false;
+
+        for (size_t plane = 0; plane < planes; ++plane)
+        {
+            std::uint32_t blockSize;
+            if (!get(bytes_, pos, blockSize))
+                return false;
+            const bool stored = (blockSize & STORED_BIT) != 0;
+            blockSize &= ~STORED_BIT;
+            if (pos + blockSize > bytes_.size())
+                return false;
+            const std::uint8_t *block = reinterpret_cast<const std::uint8_t *>(bytes_.data()) + pos;
+            std::uint8_t *target = residual_.data() + plane * cells;
+            if (stored)
+            {
+                if (blockSize != cells)
+                    return false;
+                std::memcpy(target, block, cells);
+            }
+            else if (!ransDecode(block, blockSize, target, cells))
+            {
+                return false;
+            }
+            pos += blockSize;
+        }
+
+        const std::uint16_t *reference = predictor == PREDICT_KEYFRAME ? key->codes.data() + c * cells : nullptr;
+        reconstructCodes(residual_.data(), reference, width_, height_, bits_, out.codes.data() + c * cells);
+    }
+    return true;
+}
+
+bool FieldReader::readFrame(size_t frame, std::vector<float> &out)
+{
+    if (frame >= frames_.size())
+        return false;
+    const FrameInfo &info = frames_[frame];
+    if (cachedKey_ != info.keyframeIndex)
+    {
+        cachedKey_ = SIZE_MAX;
+        if (!decode(info.keyframeIndex, nullptr, key_))
+            return false;
+        cachedKey_ = info.keyframeIndex;
+    }
+    const DecodedFrame *decoded = &key_;
+    if (!info.keyframe)
+    {
+        if (!decode(frame, &key_, scratch_))
+            return false;
+        decoded = &scratch_;
+    }
+
+    const size_t cells = static_cast<size_t>(width_) * height_;
+    const float maxCode = static_cast<float>((1u << bits_) - 1);
+    out.resize(cells * channels_);
+    for (int c = 0; c < channels_; ++c)
+    {
+        const float lo = decoded->lo[c];
+        const float step = (decoded->hi[c] - lo) / maxCode;
+        const std::uint16_t *codes = decoded->codes.data() + c * cells;
+        float *values = out.data() + c * cells;
+        for (size_t i = 0; i < cells; ++i)
+            values[i] = lo + codes[i] * step;
+    }
+    return true;
+}
@@ -0,0 +1,212 @@
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+namespace
+{
+    constexpr std::size_t BLOCK_SIZE = 64 * 1024;
+
+    std::atomic<std::uint64_t> heapAllocationCount{0};
+    std::atomic<std::uint64_t> frameEpoch{1};
+    std::atomic<std::uint64_t> heapAtFrameStart{0};
+    std::atomic<std::uint64_t> heapLastFrame{0};
+
+    // header in front of every block, the usable bytes follow it
+    struct alignas(alignof(std::max_align_t)) Block
+    {
+        Block *next;
+        std::size_t size;     // usable bytes
+        std::uint64_t freedIn; // pool only: the frame the block was handed back in
+
+        std::byte *begin() { return reinterpret_cast<std::byte *>(this + 1); }
+        std::byte *end() { return begin() + size; }
+    };
+
+    Block *newBlock(std::size_t minSize)
+    {
+        const std::size_t size = std::max(BLOCK_SIZE, minSize);
+        void *memory = std::malloc(sizeof(Block) + size);
+        if (!memory)
+            throw std::bad_alloc();
+        heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        MemoryTracker::acquire(MemoryTag::FrameArena, sizeof(Block) + size); // blocks are never freed
+        return new (memory) Block{nullptr, size, 0};
+    }
+
+    // blocks of threads that exited (std::async runs every job on a fresh thread, without this each
+    // job would malloc its own block). a block only goes out again in a later frame than the one it
+    // came back in, containers a job made could still be read by the thread that joined it
+    class BlockPool
+    {
+    public:
+        void give(Block *chain, std::uint64_t frame)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while (chain)
+            {
+                Block *next = chain->next;
+                chain->freedIn = frame;
+                chain->next = head_;
+                head_ = chain;
+                chain = next;
+            }
+        }
+
+        Block *take(std::size_t minSize, std::uint64_t frame)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (Block **link = &head_; *link; link = &(*link)->next)
+            {
+                Block *block = *link;
+                if (block->freedIn < frame && block->size >= minSize)
+                {
+                    *link = block->next;
+                    block->next = nullptr;
+                    return block;
+                }
+            }
+            return nullptr;
+        }
+
+    private:
+        std::mutex mutex_;
+        Block *head_ = nullptr;
+    };
+
+    BlockPool &pool()
+    {
+        static BlockPool instance;
+        return instance;
+    }
+
+    class ThreadArena
+    {
+    public:
+        ~ThreadArena()
+        {
+            if (first_)
+                pool().give(first_, frameEpoch.load(std::memory_order_acquire));
+        }
+
+        void *allocate(std::size_t bytes, std::size_t alignment)
+        {
+            const std::uint64_t frame = frameEpoch.load(std::memory_order_acquire);
+            if (frame != frame_)
+                rewind(frame);
+
+            if (current_)
+            {
+                if (void *pointer = bump(bytes, alignment))
+                    return pointer;
+            }
+
+            // move on to the next block of the chain (kept from earlier frames), or put a new one in
+            // front of it when it is missing or too small for this request
+            const std::size_t needed = bytes + alignment;
+            Block *next = current_ ? current_->next : first_;
+            if (!next || next->size < needed)
+            {
+                Block *fresh = pool().take(needed, frame);
+                if (!fresh)
+                    fresh = newBlock(needed);
+                fresh->next = next;
+                (current_ ? current_->next : first_) = fresh;
+                next = fresh;
+            }
+            current_ = next;
+            top_ = current_->begin();
+            return bump(bytes, alignment);
+        }
+
+        void deallocate(void *pointer, std::size_t bytes)
+        {
+            // only the newest allocation can be given back (loops that make and drop one list per
+            // iteration), the rest waits for the frame boundary
+            auto *start = static_cast<std::byte *>(pointer);
+            if (current_ && start + bytes == top_ && start >= current_->begin())
+            {
+                top_ = start;
+                used_ -= bytes;
+            }
+        }
+
+        std::size_t used() const
+        {
+            return frame_ == frameEpoch.load(std::memory_order_relaxed) ? used_ : 0;
+        }
+
+    private:
+        void rewind(std::uint64_t frame)
+        {
+            frame_ = frame;
+            current_ = first_;
+            top_ = first_ ? first_->begin() : nullptr;
+            used_ = 0;
+        }
+
+        void *bump(std::size_t bytes, std::size_t alignment)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(top_);
+            const auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            if (aligned + bytes > reinterpret_cast<std::uintptr_t>(current_->end()))
+                return nullptr;
+            top_ = reinterpret_cast<std::byte *>(aligned + bytes);
+            used_ += bytes;
+            return reinterpret_cast<void *>(aligned);
+        }
+
+        Block *first_ = nullptr;
+        Block *current_ = nullptr;
+        std::byte *top_ = nullptr;
+        std::size_t used_ = 0;
+        std::uint64_t frame_ = 0;
+    };
+
+    thread_local ThreadArena threadArena;
+}
+
+namespace FrameArena
+{
+    void beginFrame()
+    {
+        const std::uint64_t heap = heapAllocationCount.load(std::memory_order_relaxed);
+        heapLastFrame.store(heap - heapAtFrameStart.exchange(heap, std::memory_order_relaxed), std::memory_order_relaxed);
+        frameEpoch.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void *allocate(std::size_t bytes, std::size_t alignment) { return threadArena.allocate(bytes, alignment); }
+
+    void deallocate(void *pointer, std::size_t bytes) noexcept { threadArena.deallocate(pointer, bytes); }
+
+    std::size_t threadBytesUsed() { return threadArena.used(); }
+
+    std::uint64_t heapAllocations() { return heapAllocationCount.load(std::memory_order_relaxed); }
+
+    std::uint64_t lastFrameHeapAllocations() { return heapLastFrame.load(std::memory_order_relaxed); }
+}
+
+// counting global allocator: same behavior as the default one (malloc, new handler, bad_alloc), it
+// just counts. the array, nothrow and sized forms of the default library forward to these
+void *operator new(std::size_t size)
+{
+    heapAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0)
+        size = 1;
+    while (true)
+    {
+        if (void *pointer = std::malloc(size))
+            return pointer;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler)
+            throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept { std::free(pointer); }
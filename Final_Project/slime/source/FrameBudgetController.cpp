@@ -0,0 +1,136 @@
+#include "FrameBudgetController.h"
+#include "Log.h"
+#include <algorithm>
+
+namespace
+{
+    // consecutive frames over/under budget before the quality level moves
+    constexpr int FRAMES_TO_DEGRADE = 10;
+    constexpr int FRAMES_TO_RECOVER = 90;
+    // recover only with real headroom, otherwise we just bounce back over budget
+    constexpr float RECOVER_FRACTION = 0.7f;
+    constexpr float REPORT_INTERVAL_SECONDS = 5.0f;
+}
+
+FrameBudgetController::FrameBudgetController(const SimulationSettings::FrameBudgetSettings &settings)
+{
+    configure(settings);
+}
+
+void FrameBudgetController::configure(const SimulationSettings::FrameBudgetSettings &settings)
+{
+    settings_ = settings;
+    tickSeconds_ = 1.0f / std::max(1.0f, settings_.tickRate);
+    accumulator_ = std::min(accumulator_, tickSeconds_);
+    if (!settings_.adaptiveQuality)
+    {
+        stats_.qualityLevel = 0;
+    }
+}
+
+int FrameBudgetController::beginFrame(float realDeltaSeconds)
+{
+    reportTimer_ += std::max(0.0f, realDeltaSeconds);
+
+    if (!settings_.fixedTimestep)
+    {
+        // old behavior: one tick per rendered frame
+        return 1;
+    }
+
+    accumulator_ += std::max(0.0f, realDeltaSeconds);
+    int ticks = static_cast<int>(accumulator_ / tickSeconds_);
+    accumulator_ -= ticks * tickSeconds_;
+
+    // catch up limit: whatever doesnt fit is dropped so the next frame isnt even slower
+    if (ticks > settings_.maxTicksPerFrame)
+    {
+        stats_.droppedTicks += ticks - settings_.maxTicksPerFrame;
+        ticks = settings_.maxTicksPerFrame;
+    }
+    return ticks;
+}
+
+void FrameBudgetController::endFrame(float workMs)
+{
+    stats_.frames++;
+    reportFrames_++;
+    stats_.avgFrameMs = (stats_.frames == 1) ? workMs : stats_.avgFrameMs * 0.9f + workMs * 0.1f;
+
+    const float target = settings_.targetFrameMs;
+    if (workMs > target)
+    {
+        stats_.missedBudgets++;
+    }
+
+    if (settings_.adaptiveQuality)
+    {
+        if (stats_.avgFrameMs > target)
+        {
+            overBudgetFrames_++;
+            underBudgetFrames_ = 0;
+        }
+        else if (stats_.avgFrameMs < target * RECOVER_FRACTION)
+        {
+            underBudgetFrames_++;
+            overBudgetFrames_ = 0;
+        }
+        else
+        {
+            overBudgetFrames_ = 0;
+            underBudgetFrames_ = 0;
+        }
+
+        if (overBudgetFrames_ >= FRAMES_TO_DEGRADE && stats_.qualityLevel < MAX_QUALITY_LEVEL)
+        {
+            stats_.qualityLevel++;
+            overBudgetFrames_ = 0;
+            SLIME_LOG(Log::Level::Info, "Frame budget: " << stats_.avgFrameMs << "ms over " << target
+                      << "ms target, quality level -> " << stats_.qualityLevel);
+        }
+        else if (underBudgetFrames_ >= FRAMES_TO_RECOVER && stats_.qualityLevel > 0)
+        {
+            stats_.qualityLevel--;
+            underBudgetFrames_ = 0;
+            SLIME_LOG(Log::Level::Info, "Frame budget: headroom at " << stats_.avgFrameMs << "ms, quality level -> "
+                      << stats_.qualityLevel);
+        }
+    }
+
+    // report missed budgets every few seconds (only when something was actually missed)
+    if (reportTimer_ >= REPORT_INTERVAL_SECONDS)
+    {
+        std::uint64_t misses = stats_.missedBudgets - reportedMisses_;
+        std::uint64_t drops = stats_.droppedTicks - reportedDrops_;
+        if (misses > 0 || drops > 0)
+        {
+            SLIME_LOG(Log::Level::Info, "Frame budget: " << misses << "/" << reportFrames_ << " frames over "
+                      << target << "ms, " << drops << " ticks dropped (avg " << stats_.avgFrameMs
+                      << "ms, quality level " << stats_.qualityLevel << ")");
+        }
+        reportTimer_ = 0.0f;
+        reportedMisses_ = stats_.missedBudgets;
+        reportedDrops_ = stats_.droppedTicks;
+        reportFrames_ = 0;
+    }
+}
+
+FrameBudgetController::Quality FrameBudgetController::getQuality(int requestedSteps) const
+{
+    // quality ladder, cheapest visual losses first:
+    // 1 = blur every 4th update, 2 = no shading, 3 = no agent overlay,
+    // 4+ = halve the steps per tick each level (world runs slower but stays responsive)
+    Quality quality;
+    const int level = stats_.qualityLevel;
+    quality.blurInterval = (level >= 1) ? 4 : 2;
+    quality.allowShading = (level < 2);
+    quality.allowOverlay = (level < 3);
+
+    int steps = std::max(1, requestedSteps);
+    if (level >= 4)
+    {
+        steps = std::max(1, steps >> (level - 3));
+    }
+    quality.stepsPerTick = steps;
+    return quality;
+}
@@ -0,0 +1,254 @@
+#include "Log.h"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr size_t RING_CAPACITY = 256; // lines per thread before new ones get dropped
+    constexpr size_t MAX_LINE = 240;      // longer lines are cut off
+    constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(10);
+
+    std::int64_t nowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    struct Entry
+    {
+        std::int64_t timeNs;
+        Log::Level level;
+        std::uint32_t suppressed;
+        std::uint32_t length;
+        char text[MAX_LINE];
+    };
+
+    // single producer (the owning thread) / single consumer (the writer) ring
+    struct Ring
+    {
+        std::array<Entry, RING_CAPACITY> entries;
+        std::atomic<std::uint64_t> head{0}; // next slot the producer writes
+        std::atomic<std::uint64_t> tail{0}; // next slot the writer reads
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<bool> retired{false};   // owning thread exited, the ring can be handed to a new one
+    };
+
+    // fixed size put area, the stream goes bad when it is full so the rest of the line is just cut
+    class LineBuffer : public std::streambuf
+    {
+    public:
+        void reset() { setp(data_, data_ + MAX_LINE); }
+        size_t size() const { return static_cast<size_t>(pptr() - pbase()); }
+        const char *data() const { return data_; }
+
+    private:
+        char data_[MAX_LINE];
+    };
+
+    struct ThreadStream
+    {
+        LineBuffer buffer;
+        std::ostream stream{&buffer};
+    };
+
+    class Writer
+    {
+    public:
+        Writer() : thread_([this] { run(); }) {}
+
+        ~Writer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            thread_.join();
+        }
+
+        Ring *acquireRing()
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex_);
+            for (auto &ring : rings_)
+            {
+                // reuse rings of threads that are gone (std::async spins up fresh threads)
+                if (ring->retired.load(std::memory_order_acquire) &&
+                    ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_relaxed))
+                {
+                    ring->retired.store(false, std::memory_order_relaxed);
+                    return ring.get();
+                }
+            }
+            rings_.push_back(std::make_unique<Ring>());
+            return rings_.back().get();
+        }
+
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            const std::uint64_t ticket = ++flushRequested_;
+            wake_.notify_all();
+            flushed_.wait(lock, [&] { return flushDone_ >= ticket || stop_; });
+        }
+
+        std::atomic<int> level{SLIME_LOG_LEVEL};
+
+    private:
+        void run()
+        {
+            std::vector<Entry> batch;
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            while (true)
+            {
+                wake_.wait_for(lock, WRITER_INTERVAL, [&] { return stop_ || flushRequested_ > flushDone_; });
+                const bool stopping = stop_;
+                const std::uint64_t ticket = flushRequested_;
+                lock.unlock();
+
+                drain(batch);
+                write(batch);
+
+                lock.lock();
+                flushDone_ = ticket;
+                flushed_.notify_all();
+                if (stopping)
+                    break;
+            }
+        }
+
+        void drain(std::vector<Entry> &batch)
+        {
+            batch.clear();
+            std::lock_guard<std::mutex> lock(ringsMutex_);
+            for (auto &ring : rings_)
+            {
+                const std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+                for (std::uint64_t i = tail; i < head; ++i)
+                    batch.push_back(ring->entries[i % RING_CAPACITY]);
+                ring->tail.store(head, std::memory_order_release);
+
+                const std::uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+                if (dropped > 0)
+                {
+                    Entry note{nowNs(), Log::Level::Warn, 0, 0, {}};
+                    const int n = std::snprintf(note.text, MAX_LINE, "[log] %llu lines dropped (ring full)",
+                                                static_cast<unsigned long long>(dropped));
+                    note.length = static_cast<std::uint32_t>(std::clamp(n, 0, static_cast<int>(MAX_LINE) - 1));
+                    batch.push_back(note);
+                }
+            }
+        }
+
+        void write(std::vector<Entry> &batch)
+        {
+            if (batch.empty())
+                return;
+            // rings are per thread, put the lines back in the order they were logged
+            std::stable_sort(batch.begin(), batch.end(), [](const Entry &a, const Entry &b)
+                             { return a.timeNs < b.timeNs; });
+            bool wroteOut = false;
+            bool wroteErr = false;
+            for (const Entry &entry : batch)
+            {
+                const bool toErr = entry.level >= Log::Level::Warn;
+                std::ostream &out = toErr ? std::cerr : std::cout;
+                out.write(entry.text, entry.length);
+                if (entry.suppressed > 0)
+                    out << " (+" << entry.suppressed << " similar suppressed)";
+                out << '\n';
+                (toErr ? wroteErr : wroteOut) = true;
+            }
+            if (wroteOut)
+                std::cout.flush();
+            if (wroteErr)
+                std::cerr.flush();
+        }
+
+        std::mutex ringsMutex_;
+        std::vector<std::unique_ptr<Ring>> rings_;
+
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+        std::condition_variable flushed_;
+        bool stop_ = false;
+        std::uint64_t flushRequested_ = 0;
+        std::uint64_t flushDone_ = 0;
+
+        std::thread thread_;
+    };
+
+    Writer &writer()
+    {
+        static Writer instance;
+        return instance;
+    }
+
+    struct ThreadRing
+    {
+        Ring *ring = nullptr;
+        ~ThreadRing()
+        {
+            if (ring)
+                ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadRing threadRing;
+    thread_local ThreadStream threadStream;
+
+    Ring &localRing()
+    {
+        if (!threadRing.ring)
+            threadRing.ring = writer().acquireRing();
+        return *threadRing.ring;
+    }
+}
+
+namespace Log
+{
+    void setLevel(Level level) { writer().level.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    bool enabled(Level level) { return static_cast<int>(level) >= writer().level.load(std::memory_order_relaxed); }
+
+    void flush() { writer().flush(); }
+
+    Line::Line(Level level, std::uint32_t suppressed)
+        : level_(level), suppressed_(suppressed), stream_(threadStream.stream)
+    {
+        threadStream.buffer.reset();
+        stream_.clear();
+        stream_.flags(std::ios_base::dec | std::ios_base::skipws);
+        stream_.precision(6);
+        stream_.width(0);
+        stream_.fill(' ');
+    }
+
+    Line::~Line()
+    {
+        Ring &ring = localRing();
+        const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+        if (head - ring.tail.load(std::memory_order_acquire) >= RING_CAPACITY)
+        {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        Entry &entry = ring.entries[head % RING_CAPACITY];
+        entry.timeNs = nowNs();
+        entry.level = level_;
+        entry.suppressed = suppressed_;
+        entry.length = static_cast<std::uint32_t>(threadStream.buffer.size());
+        std::memcpy(entry.text, threadStream.buffer.data(), entry.length);
+        ring.head.store(head + 1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,99 @@
+#include "MemoryTracker.h"
+#include <array>
+#include <atomic>
+#include <limits>
+
+namespace
+{
+    struct Counter
+    {
+        std::atomic<std::size_t> live{0};
+        std::atomic<std::size_t> peak{0};
+    };
+
+    std::array<Counter, MemoryTracker::TAG_COUNT> counters;
+    Counter total;
+    std::atomic<std::size_t> budgetBytes{0};
+
+    void raisePeak(Counter &counter, std::size_t value)
+    {
+        std::size_t peak = counter.peak.load(std::memory_order_relaxed);
+        while (value > peak && !counter.peak.compare_exchange_weak(peak, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Counter &counterFor(MemoryTag tag) { return counters[static_cast<int>(tag)]; }
+}
+
+namespace MemoryTracker
+{
+    void acquire(MemoryTag tag, std::size_t bytes)
+    {
+        Counter &counter = counterFor(tag);
+        raisePeak(counter, counter.live.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+        raisePeak(total, total.live.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    }
+
+    void release(MemoryTag tag, std::size_t bytes)
+    {
+        counterFor(tag).live.fetch_sub(bytes, std::memory_order_relaxed);
+        total.live.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    std::size_t live(MemoryTag tag) { return counterFor(tag).live.load(std::memory_order_relaxed); }
+
+    std::size_t peak(MemoryTag tag) { return counterFor(tag).peak.load(std::memory_order_relaxed); }
+
+    void resetPeak(MemoryTag tag)
+    {
+        Counter &counter = counterFor(tag);
+        counter.peak.store(counter.live.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    std::size_t totalLive() { return total.live.load(std::memory_order_relaxed); }
+
+    std::size_t totalPeak() { return total.peak.load(std::memory_order_relaxed); }
+
+    const char *name(MemoryTag tag)
+    {
+        switch (tag)
+        {
+        case MemoryTag::Agents:
+            return "agents";
+        case MemoryTag::Exploration:
+            return "explore";
+        case MemoryTag::SpatialGrid:
+            return "grid";
+        case MemoryTag::Pathfinder:
+            return "pathfinder";
+        case MemoryTag::Trails:
+            return "trails";
+        case MemoryTag::FrameArena:
+            return "arena";
+        case MemoryTag::Recording:
+            return "record";
+        default:
+            return "?";
+        }
+    }
+
+    void setBudget(std::size_t bytes) { budgetBytes.store(bytes, std::memory_order_relaxed); }
+
+    std::size_t budget() { return budgetBytes.load(std::memory_order_relaxed); }
+
+    bool overBudget()
+    {
+        const std::size_t limit = budget();
+        return limit > 0 && totalLive() > limit;
+    }
+
+    std::size_t headroom()
+    {
+        const std::size_t limit = budget();
+        if (limit == 0)
+            return std::numeric_limits<std::size_t>::max();
+        const std::size_t used = totalLive();
+        return used < limit ? limit - used : 0;
+    }
+}
@@ -1,5 +1,6 @@
 #include "OptimizedTrailMap.h"
 #include "TrailMap.h"
+#include "FastMath.h"
 #include <algorithm>
 #include <cstring>
 #include <cmath>
@@ -498,8 +499,8 @@ void OptimizedTrailMap::depositOptimized(int x, int y, float amount, int species
     }
 }
 
-void OptimizedTrailMap::depositAnisotropic(int centerX, int centerY, float angle, float sigmaParallel,
-                                           float sigmaPerp, float amount, int species, int widthLimit, int heightLimit)
+void OptimizedTrailMap::depositAnisotropic(int centerX, int centerY, sf::Vector2f direction, float sigmaParallel,
+                                           float sigmaPerp, float amount, int species, bool fastMath)
 {
     if (species < 0 || species >= numSpecies_ || amount <= 0.0f)
         return;
@@ -508,9 +509,9 @@ void OptimizedTrailMap::depositAnisotropic(int centerX, int centerY, float angle
     sigmaParallel = std::max(0.1f, sigmaParallel);
     sigmaPerp = std::max(0.1f, sigmaPerp);
 
-    // compute rotation matrix terms
-    float ca = std::cos(angle);
-    float sa = std::sin(angle);
+    // rotation matrix terms straight from the (unit) heading vector
+    float ca = direction.x;
+    float sa = direction.y;
 
     // determine bounding box roughly within 3 sigma extents
     int radiusX = static_cast<int>(std::ceil(3.0f * std::max(sigmaParallel * std::abs(ca), sigmaPerp * std::abs(sa))));
@@ -525,23 +526,41 @@ void OptimizedTrailMap::depositAnisotropic(int centerX, int centerY, float angle
     float norm = 1.0f / (2.0f * static_cast<float>(M_PI) * sigmaParallel * sigmaPerp);
 
     float *dst = speciesData_[species].get();
+    const float invParSq = 1.0f / (sigmaParallel * sigmaParallel);
+    const float invPerpSq = 1.0f / (sigmaPerp * sigmaPerp);
+
+    // exponents for a whole row first so the exp runs as one batch (simd when fastMath is on)
+    static thread_local std::vector<float> exponents;
+    static thread_local std::vector<float> weights;
+    const int rowLength = maxX - minX + 1;
+    if (rowLength <= 0)
+        return;
+    if (static_cast<int>(exponents.size()) < rowLength)
+    {
+        exponents.resize(rowLength);
+        weights.resize(rowLength);
+    }
 
     for (int y = minY; y <= maxY; ++y)
     {
+        float dy = static_cast<float>(y - centerY);
         for (int x = minX; x <= maxX; ++x)
         {
             float dx = static_cast<float>(x - centerX);
-            float dy = static_cast<float>(y - centerY);
             // rotate coordinates into agent frame: u along angle, v perpendicular
             float u = ca * dx + sa * dy;  // parallel to motion
             float v = -sa * dx + ca * dy; // perpendicular
 
-            float exponent = -0.5f * ((u * u) / (sigmaParallel * sigmaParallel) + (v * v) / (sigmaPerp * sigmaPerp));
-            if (exponent < -10.0f) // negligible
+            exponents[x - minX] = -0.5f * (u * u * invParSq + v * v * invPerpSq);
+        }
+        FastMath::expArray(exponents.data(), weights.data(), rowLength, fastMath);
+
+        for (int x = minX; x <= maxX; ++x)
+        {
+            if (exponents[x - minX] < -10.0f) // negligible
                 continue;
 
-            float w = std::exp(exponent) * norm;
-            float contrib = amount * w;
+            float contrib = amount * weights[x - minX] * norm;
             int idx = getIndex(x, y);
             dst[idx] = std::min(1000.0f, dst[idx] + contrib);
         }
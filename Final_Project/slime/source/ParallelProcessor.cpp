@@ -57,7 +57,7 @@ void ParallelProcessor::parallelForImpl(Iterator begin, Iterator end, Function &
     auto startTime = std::chrono::high_resolution_clock::now();
 
     const size_t chunkSize = calculateChunkSize(totalWork, policy);
-    std::vector<std::future<void>> futures;
+    FrameVector<std::future<void>> futures;
     futures.reserve(numThreads_);
 
     // distribute work across threads
@@ -95,19 +95,19 @@ void ParallelProcessor::parallelForImpl(Iterator begin, Iterator end, Function &
     metrics_.minExecutionTime = (metrics_.minExecutionTime == 0.0) ? duration : std::min(metrics_.minExecutionTime, duration);
 }
 
-void ParallelProcessor::parallelAgentUpdate(std::vector<Agent> &agents, const SimulationSettings &settings)
+void ParallelProcessor::parallelAgentUpdate(AgentVector &agents, const SimulationSettings &settings)
 {
     parallelFor(agents, [&settings](Agent &agent)
                 { agent.move(settings); });
 }
 
-void ParallelProcessor::parallelAgentSensing(std::vector<Agent> &agents, TrailMap &trailMap, const SimulationSettings &settings)
+void ParallelProcessor::parallelAgentSensing(AgentVector &agents, TrailMap &trailMap, const SimulationSettings &settings)
 {
     parallelFor(agents, [&trailMap, &settings](Agent &agent)
                 { agent.senseMultiSpecies(trailMap, settings); });
 }
 
-void ParallelProcessor::parallelAgentMovement(std::vector<Agent> &agents, const SimulationSettings &settings)
+void ParallelProcessor::parallelAgentMovement(AgentVector &agents, const SimulationSettings &settings)
 {
     parallelFor(agents, [&settings](Agent &agent)
                 {
@@ -115,7 +115,7 @@ void ParallelProcessor::parallelAgentMovement(std::vector<Agent> &agents, const
         agent.wrapPosition(settings.width, settings.height); });
 }
 
-void ParallelProcessor::parallelAgentDeposition(std::vector<Agent> &agents, TrailMap &trailMap, const SimulationSettings &settings)
+void ParallelProcessor::parallelAgentDeposition(AgentVector &agents, TrailMap &trailMap, const SimulationSettings &settings)
 {
     // NOTE: trail deposition needs synchronization - this is just a simplified version for now
     // in practice need to actually set u[] atomic operations or per thread buffers?
@@ -154,8 +154,8 @@ size_t ParallelProcessor::calculateChunkSize(size_t totalWork, SchedulingPolicy
 }
 
 // explicit template instantiations for common use cases
-template void ParallelProcessor::parallelFor<std::vector<Agent>>(std::vector<Agent> &, std::function<void(Agent &)> &&);
-template void ParallelProcessor::parallelFor<std::vector<Agent>::iterator>(std::vector<Agent>::iterator, std::vector<Agent>::iterator, std::function<void(Agent &)> &&);
+template void ParallelProcessor::parallelFor<AgentVector>(AgentVector &, std::function<void(Agent &)> &&);
+template void ParallelProcessor::parallelFor<AgentVector::iterator>(AgentVector::iterator, AgentVector::iterator, std::function<void(Agent &)> &&);
 
 
 void ParallelProcessor::processTrailsParallel(OptimizedTrailMap &trailMap, float diffuseRate, float decayRate)
@@ -166,7 +166,7 @@ void ParallelProcessor::processTrailsParallel(OptimizedTrailMap &trailMap, float
     const size_t chunkSize = calculateChunkSize(numSpecies, policy_);
 
     // parallel diffusion
-    std::vector<std::future<void>> diffuseFutures;
+    FrameVector<std::future<void>> diffuseFutures;
     diffuseFutures.reserve(numThreads_);
 
     for (size_t threadId = 0; threadId < numThreads_; ++threadId)
@@ -194,7 +194,7 @@ void ParallelProcessor::processTrailsParallel(OptimizedTrailMap &trailMap, float
     }
 
     // parallel decay (can be done simultaneously as its like a per pixel operation)
-    std::vector<std::future<void>> decayFutures;
+    FrameVector<std::future<void>> decayFutures;
     decayFutures.reserve(numThreads_);
 
     for (size_t threadId = 0; threadId < numThreads_; ++threadId)
@@ -1,8 +1,13 @@
 #include "Pathfinder.h"
+#include "Log.h"
 #include <limits>
 #include <random>
 #include <iostream>
 #include <set>
+#include <atomic>
+#include <future>
+#include <barrier>
+#include <thread>
 
 Pathfinder::Pathfinder(int width, int height, int cellSize)
     : worldWidth_(width), worldHeight_(height), cellSize_(cellSize) {
@@ -1491,8 +1496,8 @@ float Pathfinder::manhattanDistance(const GridCell& a, const GridCell& b) const
     return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
 }
 
-std::vector<GridCell> Pathfinder::getNeighbors(const GridCell& cell, bool allowDiagonal) const {
-    std::vector<GridCell> neighbors;
+FrameVector<GridCell> Pathfinder::getNeighbors(const GridCell& cell, bool allowDiagonal) const {
+    FrameVector<GridCell> neighbors;
     neighbors.reserve(8);  // max 8 directions
     
     // direction offsets: first 4 are cardinal (N, E, S, W). and next 4 are diagonals
@@ -1519,8 +1524,80 @@ std::vector<GridCell> Pathfinder::getNeighbors(const GridCell& cell, bool allowD
     return neighbors;
 }
 
+bool Pathfinder::overMemoryBudget(int nodesExpanded) const {
+    // checked every 256 expansions, the searches give up (no path) once the tracked total is past the budget
+    if ((nodesExpanded & 255) != 0 || !MemoryTracker::overBudget()) return false;
+    SLIME_LOG_EVERY(Log::Level::Warn, 2000, "[PATH] search stopped after " << nodesExpanded
+                    << " expansions, over the memory budget (" << MemoryTracker::totalLive() / (1024 * 1024) << " MB)");
+    return true;
+}
+
+void CompactPath::push_back(const GridCell& cell) {
+    if (size_ == 0) {
+        first_ = last_ = cell;
+        size_ = 1;
+        rewind();
+        return;
+    }
+
+    const int dx = cell.x - last_.x;
+    const int dy = cell.y - last_.y;
+    last_ = cell;
+    ++size_;
+
+    int code = -1;
+    if (std::abs(dx) <= 1 && std::abs(dy) <= 1) {
+        for (int d = 0; d < 8; d++) {
+            if (DIR_X[d] == dx && DIR_Y[d] == dy) code = d;
+        }
+    }
+    if (code < 0) {
+        // not a unit step (or a repeated cell): absolute cell
+        words_.push_back(CELL | (static_cast<uint32_t>(cell.x & 0x7fff) << 15) | static_cast<uint32_t>(cell.y & 0x7fff));
+        return;
+    }
+
+    const uint32_t direction = static_cast<uint32_t>(code);
+    if (!words_.empty()) {
+        uint32_t& word = words_.back();
+        if ((word & KIND_MASK) == RUN && ((word >> 27) & 7u) == direction && (word & MAX_RUN) < MAX_RUN) {
+            ++word;  // the length is in the low bits
+            return;
+        }
+        if ((word & KIND_MASK) == STEPS) {
+            const uint32_t count = ((word >> 27) & 7u) + 1;
+            if (count < 8) {
+                // a word that is all this direction turns into a run once it is 3 long
+                const uint32_t codeBits = (1u << (3 * count)) - 1;
+                if (count >= 2 && (word & codeBits) == ((direction * 0x249249u) & codeBits)) {
+                    word = RUN | (direction << 27) | (count + 1);
+                } else {
+                    word = (word & ~(7u << 27)) | (count << 27) | (direction << (3 * count));
+                }
+                return;
+            }
+        }
+    }
+    words_.push_back(STEPS | direction);
+}
+
+void CompactPath::assign(const std::vector<GridCell>& cells) {
+    clear();
+    for (const auto& cell : cells) {
+        push_back(cell);
+    }
+    words_.shrink_to_fit();  // agents keep their path for the whole race, dont keep the growth slack
+}
+
+void CompactPath::clear() {
+    words_.clear();
+    size_ = 0;
+    first_ = last_ = {0, 0};
+    rewind();
+}
+
 std::vector<GridCell> Pathfinder::reconstructPath(
-    const std::unordered_map<GridCell, GridCell, GridCellHash>& cameFrom,
+    const TrackedCellMap<GridCell, MemoryTag::Pathfinder>& cameFrom,
     const GridCell& start, const GridCell& goal) {
     
     std::vector<GridCell> path;
@@ -1542,11 +1619,10 @@ std::vector<GridCell> Pathfinder::reconstructPath(
 
 // simplify path by removing unnecessary waypoints using line of sight checks
 // this produces a smoother path with fewer turns.
-std::vector<GridCell> Pathfinder::simplifyPath(const std::vector<GridCell>& path) const {
-    if (path.size() <= 2) return path;  // nothing to simplify.
-    
-    std::vector<GridCell> simplified;
-    simplified.push_back(path[0]);  // always keep start.
+void Pathfinder::simplifyPath(const std::vector<GridCell>& path, CompactPath& out) const {
+    out.clear();
+    if (path.empty()) return;
+    out.push_back(path[0]);  // always keep start.
     
     size_t current = 0;
     while (current < path.size() - 1) {
@@ -1559,11 +1635,9 @@ std::vector<GridCell> Pathfinder::simplifyPath(const std::vector<GridCell>& path
                 break;
             }
         }
-        simplified.push_back(path[furthest]);
+        out.push_back(path[furthest]);
         current = furthest;  // jump ahead
     }
-    
-    return simplified;
 }
 
 float Pathfinder::calculatePathLength(const std::vector<GridCell>& path) const {
@@ -1620,9 +1694,9 @@ PathResult Pathfinder::findPathAStar(const GridCell& start, const GridCell& goal
     
     // priority queue holds (f score, cell) pairs and smallest f first.
     using PQElement = std::pair<float, GridCell>;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> frontier;
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFrom;   // parent pointers.
-    std::unordered_map<GridCell, float, GridCellHash> costSoFar;     // g score per cell.
+    std::priority_queue<PQElement, TrackedVector<PQElement, MemoryTag::Pathfinder>, std::greater<PQElement>> frontier;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFrom;   // parent pointers.
+    TrackedCellMap<float, MemoryTag::Pathfinder> costSoFar;     // g score per cell.
     
     frontier.push({0.0f, start});
     costSoFar[start] = 0.0f;
@@ -1632,6 +1706,7 @@ PathResult Pathfinder::findPathAStar(const GridCell& start, const GridCell& goal
         GridCell current = frontier.top().second;
         frontier.pop();
         result.nodesExpanded++;
+        if (overMemoryBudget(result.nodesExpanded)) break;
         
         if (current == goal) {
             // reconstructs path by walking parent pointers back to start
@@ -1683,9 +1758,9 @@ PathResult Pathfinder::findPathGreedy(const GridCell& start, const GridCell& goa
     
     // greedy uses only h (heuristic) as priority which ignores path cost (g)
     using PQElement = std::pair<float, GridCell>;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> frontier;
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFrom;
-    std::unordered_set<GridCell, GridCellHash> visited;
+    std::priority_queue<PQElement, TrackedVector<PQElement, MemoryTag::Pathfinder>, std::greater<PQElement>> frontier;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFrom;
+    TrackedCellSet<MemoryTag::Pathfinder> visited;
     
     frontier.push({heuristic(start, goal), start});
     
@@ -1697,6 +1772,7 @@ PathResult Pathfinder::findPathGreedy(const GridCell& start, const GridCell& goa
         if (visited.find(current) != visited.end()) continue;  // already processed
         visited.insert(current);
         result.nodesExpanded++;
+        if (overMemoryBudget(result.nodesExpanded)) break;
         
         if (current == goal) {
             result.found = true;
@@ -1743,9 +1819,9 @@ PathResult Pathfinder::findPathBidirectional(const GridCell& start, const GridCe
         return result;
     }
     
-    std::queue<GridCell> frontierForward, frontierBackward;
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFromForward, cameFromBackward;
-    std::unordered_set<GridCell, GridCellHash> visitedForward, visitedBackward;
+    std::queue<GridCell, TrackedCellDeque<MemoryTag::Pathfinder>> frontierForward, frontierBackward;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFromForward, cameFromBackward;
+    TrackedCellSet<MemoryTag::Pathfinder> visitedForward, visitedBackward;
     
     frontierForward.push(start);
     frontierBackward.push(goal);
@@ -1764,6 +1840,7 @@ PathResult Pathfinder::findPathBidirectional(const GridCell& start, const GridCe
             GridCell current = frontierForward.front();
             frontierForward.pop();
             result.nodesExpanded++;
+            if (overMemoryBudget(result.nodesExpanded)) break;
             
             // checking if backward search already visited this cell (meeting point)
             if (visitedBackward.find(current) != visitedBackward.end()) {
@@ -1786,6 +1863,7 @@ PathResult Pathfinder::findPathBidirectional(const GridCell& start, const GridCe
             GridCell current = frontierBackward.front();
             frontierBackward.pop();
             result.nodesExpanded++;
+            if (overMemoryBudget(result.nodesExpanded)) break;
             
             // and check if forward search already visited this cell
             if (visitedForward.find(current) != visitedForward.end()) {
@@ -1836,6 +1914,175 @@ PathResult Pathfinder::findPathBidirectional(const GridCell& start, const GridCe
 }
 
 
+// Concurrent bidirectional BFS
+// the forward search runs on the calling thread and the backward one on a second thread, each
+// over flat per cell arrays. a cell's tag holds one bit per side, whichever side claims a cell
+// second sees the other bit and offers dF + dB as a meeting. after every layer a side publishes
+// how deep it has tagged, once depthF + depthB >= best meeting every shortest path has a cell
+// tagged by both, so the best meeting is optimal (hop count, unlike the sequential version
+// above that stops at the first meeting)
+
+namespace {
+    // per calling thread, so searches from different threads dont share it. tags carry the query
+    // stamp in the high bits, nothing is cleared between queries
+    struct BidirectionalWorkspace {
+        TrackedVector<uint32_t, MemoryTag::Pathfinder> tags;  // (stamp << 2) | side bits, only touched through atomic_ref
+        TrackedVector<int, MemoryTag::Pathfinder> parent[2];   // flat index of the parent per side (-1 at the origin)
+        TrackedVector<int, MemoryTag::Pathfinder> depth[2];    // bfs depth per side, valid where the side's bit is set
+        TrackedVector<int, MemoryTag::Pathfinder> layer[2], nextLayer[2];
+        uint32_t stamp = 0;
+    };
+    thread_local BidirectionalWorkspace bidirectionalWorkspace;
+
+    constexpr uint32_t MAX_STAMP = (1u << 30) - 1;
+    constexpr int EXHAUSTED = 1 << 29;  // depth of a side that ran out of frontier (tagged its whole component)
+    constexpr uint64_t NO_MEETING = ~0ull;
+}
+
+PathResult Pathfinder::findPathBidirectionalParallel(const GridCell& start, const GridCell& goal) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    PathResult result;
+    result.nodesExpanded = 0;
+    
+    if (!isValid(start) || !isValid(goal)) {
+        return result;
+    }
+    
+    if (start == goal) {
+        result.found = true;
+        result.path = {start};
+        return result;
+    }
+    
+    BidirectionalWorkspace& ws = bidirectionalWorkspace;
+    const size_t cellCount = blocked_.size();
+    if (ws.tags.size() != cellCount || ws.stamp == MAX_STAMP) {
+        ws.tags.assign(cellCount, 0u);
+        for (int side = 0; side < 2; side++) {
+            ws.parent[side].resize(cellCount);
+            ws.depth[side].resize(cellCount);
+        }
+        ws.stamp = 0;
+    }
+    const uint32_t stamp = ++ws.stamp;
+    
+    // both origins are tagged before the threads start, so either side finds the other's origin
+    const int origins[2] = {getIndex(start), getIndex(goal)};
+    for (int side = 0; side < 2; side++) {
+        ws.tags[origins[side]] = (stamp << 2) | (1u << side);
+        ws.parent[side][origins[side]] = -1;
+        ws.depth[side][origins[side]] = 0;
+    }
+    
+    std::atomic<uint64_t> best{NO_MEETING};  // (hops << 32) | meeting cell
+    std::atomic<int> reached[2] = {0, 0};     // depth each side has fully tagged
+    std::atomic<bool> done{false};
+    std::atomic<bool> gaveUp{false};  // memory budget
+    
+    auto offerMeeting = [&](int hops, int cell) {
+        const uint64_t offer = (static_cast<uint64_t>(hops) << 32) | static_cast<uint32_t>(cell);
+        uint64_t current = best.load(std::memory_order_relaxed);
+        while (offer < current && !best.compare_exchange_weak(current, offer, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+        }
+    };
+    
+    // same moves as getNeighbors (no corner cutting), which are symmetric so the backward side can use them too
+    const int dx[] = {0, 1, 0, -1, 1, 1, -1, -1};
+    const int dy[] = {-1, 0, 1, 0, -1, 1, 1, -1};
+    
+    // returns the number of cells it expanded
+    auto search = [&](int side) {
+        int expanded = 0;
+        const uint32_t mine = 1u << side;
+        const uint32_t theirs = 1u << (1 - side);
+        auto& layer = ws.layer[side];
+        auto& nextLayer = ws.nextLayer[side];
+        auto& parent = ws.parent[side];
+        auto& depth = ws.depth[side];
+        const auto& otherDepth = ws.depth[1 - side];
+        layer.clear();
+        layer.push_back(origins[side]);
+        
+        int layerDepth = 0;
+        while (!layer.empty() && !done.load(std::memory_order_acquire)) {
+            nextLayer.clear();
+            for (int index : layer) {
+                if (overMemoryBudget(++expanded)) {
+                    gaveUp.store(true, std::memory_order_relaxed);
+                    done.store(true, std::memory_order_release);
+                    return expanded;
+                }
+                const int x = index % gridWidth_;
+                const int y = index / gridWidth_;
+                for (int i = 0; i < 8; i++) {
+                    const int nx = x + dx[i];
+                    const int ny = y + dy[i];
+                    if (!isValid(nx, ny)) continue;
+                    if (i >= 4 && (!isValid(nx, y) || !isValid(x, ny))) continue;
+                    
+                    const int neighbor = getIndex(nx, ny);
+                    std::atomic_ref<uint32_t> tag(ws.tags[neighbor]);
+                    uint32_t seen = tag.load(std::memory_order_acquire);
+                    if ((seen >> 2) == stamp && (seen & mine)) continue;  // ours already
+                    
+                    // fill in our side first, the other side only reads it after it sees our bit
+                    parent[neighbor] = index;
+                    depth[neighbor] = layerDepth + 1;
+                    uint32_t claimed;
+                    do {
+                        claimed = ((seen >> 2) == stamp ? seen : stamp << 2) | mine;
+                    } while (!tag.compare_exchange_weak(seen, claimed, std::memory_order_acq_rel, std::memory_order_acquire));
+                    
+                    nextLayer.push_back(neighbor);
+                    if ((seen >> 2) == stamp && (seen & theirs)) {
+                        offerMeeting(layerDepth + 1 + otherDepth[neighbor], neighbor);
+                    }
+                }
+            }
+            
+            layerDepth++;
+            std::swap(layer, nextLayer);
+            
+            // a side that ran dry has tagged its whole component: no meeting by now means no path
+            const int depthNow = layer.empty() ? EXHAUSTED : layerDepth;
+            reached[side].store(depthNow, std::memory_order_release);
+            const uint64_t meeting = best.load(std::memory_order_acquire);
+            const uint64_t bothDepths = static_cast<uint64_t>(depthNow) + reached[1 - side].load(std::memory_order_acquire);
+            if ((meeting == NO_MEETING && depthNow == EXHAUSTED) || (meeting != NO_MEETING && bothDepths >= (meeting >> 32))) {
+                done.store(true, std::memory_order_release);
+            }
+        }
+        return expanded;
+    };
+    
+    auto backward = std::async(std::launch::async, search, 1);
+    result.nodesExpanded = search(0);
+    result.nodesExpanded += backward.get();
+    
+    const uint64_t meeting = best.load(std::memory_order_acquire);
+    if (meeting != NO_MEETING && !gaveUp.load(std::memory_order_relaxed)) {
+        result.found = true;
+        const int meetingCell = static_cast<int>(meeting & 0xffffffffu);
+        
+        // start -> meeting from the forward parents, then meeting -> goal from the backward ones
+        for (int index = meetingCell; index != -1; index = ws.parent[0][index]) {
+            result.path.push_back({index % gridWidth_, index / gridWidth_});
+        }
+        std::reverse(result.path.begin(), result.path.end());
+        for (int index = ws.parent[1][meetingCell]; index != -1; index = ws.parent[1][index]) {
+            result.path.push_back({index % gridWidth_, index / gridWidth_});
+        }
+        result.pathLength = calculatePathLength(result.path);
+    }
+    
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.computeTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    
+    return result;
+}
+
+
 // Jump point search (JPS)
 
 GridCell Pathfinder::jump(const GridCell& current, int dx, int dy, const GridCell& goal) {
@@ -1902,9 +2149,9 @@ PathResult Pathfinder::findPathJPS(const GridCell& start, const GridCell& goal)
     
     // JPS uses same data structures as A* but prunes many intermediate nodes
     using PQElement = std::pair<float, GridCell>;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> frontier;
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFrom;  // parent of each jump point
-    std::unordered_map<GridCell, float, GridCellHash> costSoFar;    // g score
+    std::priority_queue<PQElement, TrackedVector<PQElement, MemoryTag::Pathfinder>, std::greater<PQElement>> frontier;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFrom;  // parent of each jump point
+    TrackedCellMap<float, MemoryTag::Pathfinder> costSoFar;    // g score
     
     frontier.push({0.0f, start});
     costSoFar[start] = 0.0f;
@@ -1919,6 +2166,7 @@ PathResult Pathfinder::findPathJPS(const GridCell& start, const GridCell& goal)
         GridCell current = frontier.top().second;
         frontier.pop();
         result.nodesExpanded++;
+        if (overMemoryBudget(result.nodesExpanded)) break;
         
         if (current == goal) {
             result.found = true;
@@ -1971,10 +2219,10 @@ PathResult Pathfinder::findPathTheta(const GridCell& start, const GridCell& goal
     }
     
     using PQElement = std::pair<float, GridCell>;
-    std::priority_queue<PQElement, std::vector<PQElement>, std::greater<PQElement>> frontier;
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFrom;  // parent pointer (any angle).
-    std::unordered_map<GridCell, float, GridCellHash> gScore;
-    std::unordered_set<GridCell, GridCellHash> closedSet;
+    std::priority_queue<PQElement, TrackedVector<PQElement, MemoryTag::Pathfinder>, std::greater<PQElement>> frontier;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFrom;  // parent pointer (any angle).
+    TrackedCellMap<float, MemoryTag::Pathfinder> gScore;
+    TrackedCellSet<MemoryTag::Pathfinder> closedSet;
     
     frontier.push({heuristic(start, goal), start});
     gScore[start] = 0.0f;
@@ -1988,6 +2236,7 @@ PathResult Pathfinder::findPathTheta(const GridCell& start, const GridCell& goal
         if (closedSet.find(current) != closedSet.end()) continue;  // already finalized.
         closedSet.insert(current);
         result.nodesExpanded++;
+        if (overMemoryBudget(result.nodesExpanded)) break;
         
         if (current == goal) {
             result.found = true;
@@ -2037,13 +2286,13 @@ PathResult Pathfinder::findPathDFS(const GridCell& start, const GridCell& goal)
     }
     
     // dfs uses a stack (LIFO) so it dives deep before backtracking.
-    std::stack<GridCell> frontier;
+    std::stack<GridCell, TrackedCellDeque<MemoryTag::Pathfinder>> frontier;
     frontier.push(start);
     
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFrom;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFrom;
     cameFrom[start] = start;
     
-    std::unordered_set<GridCell, GridCellHash> visited;
+    TrackedCellSet<MemoryTag::Pathfinder> visited;
     visited.insert(start);
     
     // random number generator for randomized DFS: shuffling neighbor order
@@ -2055,6 +2304,7 @@ PathResult Pathfinder::findPathDFS(const GridCell& start, const GridCell& goal)
         GridCell current = frontier.top();
         frontier.pop();
         result.nodesExpanded++;
+        if (overMemoryBudget(result.nodesExpanded)) break;
         
         if (current == goal) {
             result.found = true;
@@ -2063,7 +2313,7 @@ PathResult Pathfinder::findPathDFS(const GridCell& start, const GridCell& goal)
             break;
         }
         
-        std::vector<GridCell> neighbors = getNeighbors(current);
+        auto neighbors = getNeighbors(current);
         
         // shuffle neighbors so the search picks a random direction each time
         // without shuffle dfs would always prefer one fixed direction.
@@ -2108,13 +2358,13 @@ PathResult Pathfinder::findPathDijkstra(const GridCell& start, const GridCell& g
     
     // priority queue: (cost, cell) - min heap by cost
     using PQEntry = std::pair<float, GridCell>;
-    std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> frontier;
+    std::priority_queue<PQEntry, TrackedVector<PQEntry, MemoryTag::Pathfinder>, std::greater<PQEntry>> frontier;
     
     // cost to reach each cell (g score in A* terminology)
-    std::unordered_map<GridCell, float, GridCellHash> costSoFar;
+    TrackedCellMap<float, MemoryTag::Pathfinder> costSoFar;
     
     // parent tracking for path reconstruction
-    std::unordered_map<GridCell, GridCell, GridCellHash> cameFrom;
+    TrackedCellMap<GridCell, MemoryTag::Pathfinder> cameFrom;
     
     frontier.push({0.0f, start});
     costSoFar[start] = 0.0f;
@@ -2125,6 +2375,7 @@ PathResult Pathfinder::findPathDijkstra(const GridCell& start, const GridCell& g
         auto [currentCost, current] = frontier.top();
         frontier.pop();
         result.nodesExpanded++;
+        if (overMemoryBudget(result.nodesExpanded)) break;
         
         // skip if we've already found a better path to this node.
         if (costSoFar.count(current) && currentCost > costSoFar[current]) {
@@ -2139,7 +2390,7 @@ PathResult Pathfinder::findPathDijkstra(const GridCell& start, const GridCell& g
         }
         
         // and expand all 8 directional neighbors
-        std::vector<GridCell> neighbors = getNeighbors(current, true);
+        auto neighbors = getNeighbors(current, true);
         
         for (const auto& next : neighbors) {
             // edge compute cost: sqrt(2) for diagonal and 1.0 for cardinal
@@ -2166,6 +2417,206 @@ PathResult Pathfinder::findPathDijkstra(const GridCell& start, const GridCell& g
 }
 
 
+// Distance fields
+// same octile moves as getNeighbors (no corner cutting), so a field agrees with findPathDijkstra
+
+namespace {
+    const int FIELD_DX[] = {0, 1, 0, -1, 1, 1, -1, -1};
+    const int FIELD_DY[] = {-1, 0, 1, 0, -1, 1, 1, -1};
+    const float FIELD_COST[] = {1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f};
+    constexpr float UNREACHED = std::numeric_limits<float>::infinity();
+}
+
+Pathfinder::DistanceField Pathfinder::computeDistanceField(const GridCell& source) const {
+    DistanceField dist(blocked_.size(), UNREACHED);
+    if (!isValid(source)) return dist;
+    
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, TrackedVector<Entry, MemoryTag::Pathfinder>, std::greater<Entry>> frontier;
+    dist[getIndex(source)] = 0.0f;
+    frontier.push({0.0f, getIndex(source)});
+    
+    while (!frontier.empty()) {
+        auto [cost, index] = frontier.top();
+        frontier.pop();
+        if (cost > dist[index]) continue;  // stale entry
+        
+        const int x = index % gridWidth_;
+        const int y = index / gridWidth_;
+        for (int i = 0; i < 8; i++) {
+            const int nx = x + FIELD_DX[i];
+            const int ny = y + FIELD_DY[i];
+            if (!isValid(nx, ny)) continue;
+            if (i >= 4 && (!isValid(nx, y) || !isValid(x, ny))) continue;
+            
+            const int next = getIndex(nx, ny);
+            const float newCost = cost + FIELD_COST[i];
+            if (newCost < dist[next]) {
+                dist[next] = newCost;
+                frontier.push({newCost, next});
+            }
+        }
+    }
+    return dist;
+}
+
+// delta stepping (meyer & sanders): cells sit in buckets of width delta by tentative distance. the
+// lowest bucket is drained in phases, each phase relaxes the light edges (cost <= delta) of the
+// cells currently in it, all threads at once with an atomic min on the flat distance array. cells
+// that land back in the same bucket make the next phase. once it stays empty the heavy edges of
+// everything that went through it are relaxed in one more phase, those can only reach later buckets.
+// phases are separated by a barrier, the calling thread does the (serial) bucket bookkeeping between them
+Pathfinder::DistanceField Pathfinder::computeDistanceFieldParallel(const GridCell& source, float delta, unsigned threadCount) const {
+    DistanceField dist(blocked_.size(), UNREACHED);
+    if (!isValid(source)) return dist;
+    
+    delta = std::max(delta, 0.05f);
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, 64u);
+    
+    // an edge can reach at most ceil(sqrt 2 / delta) buckets ahead, so the buckets are a ring
+    const size_t ringSize = static_cast<size_t>(std::ceil(FIELD_COST[4] / delta)) + 1;
+    std::vector<TrackedVector<int, MemoryTag::Pathfinder>> ring(ringSize);
+    size_t pending = 0;  // entries in the ring (stale ones included)
+    auto bucketOf = [delta](float cost) { return static_cast<size_t>(cost / delta); };
+    
+    // dedupes cells per phase (a cell can be queued by several threads / entries)
+    TrackedVector<uint32_t, MemoryTag::Pathfinder> queuedIn(blocked_.size(), 0u);
+    uint32_t phaseStamp = 0;
+    
+    TrackedVector<int, MemoryTag::Pathfinder> frontier, settled;
+    std::vector<TrackedVector<int, MemoryTag::Pathfinder>> improved(threadCount);  // cells each thread lowered
+    
+    // what the next phase runs (written by the calling thread between barriers)
+    const int* phaseCells = nullptr;
+    size_t phaseCount = 0;
+    bool phaseHeavy = false;
+    bool finished = false;
+    std::barrier sync(static_cast<std::ptrdiff_t>(threadCount));
+    
+    auto relax = [&](size_t begin, size_t end, TrackedVector<int, MemoryTag::Pathfinder>& out) {
+        for (size_t n = begin; n < end; n++) {
+            const int index = phaseCells[n];
+            const float cost = std::atomic_ref<float>(dist[index]).load(std::memory_order_relaxed);
+            const int x = index % gridWidth_;
+            const int y = index / gridWidth_;
+            for (int i = 0; i < 8; i++) {
+                if ((FIELD_COST[i] > delta) != phaseHeavy) continue;
+                const int nx = x + FIELD_DX[i];
+                const int ny = y + FIELD_DY[i];
+                if (!isValid(nx, ny)) continue;
+                if (i >= 4 && (!isValid(nx, y) || !isValid(x, ny))) continue;
+                
+                const int next = getIndex(nx, ny);
+                const float newCost = cost + FIELD_COST[i];
+                std::atomic_ref<float> target(dist[next]);
+                float current = target.load(std::memory_order_relaxed);
+                bool lowered = false;
+                while (newCost < current) {
+                    if (target.compare_exchange_weak(current, newCost, std::memory_order_relaxed)) {
+                        lowered = true;
+                        break;
+                    }
+                }
+                if (lowered) out.push_back(next);
+            }
+        }
+    };
+    auto relaxShare = [&](unsigned thread) {
+        relax(phaseCount * thread / threadCount, phaseCount * (thread + 1) / threadCount, improved[thread]);
+    };
+    
+    // the other threads only run phases, the barrier hands them their work and the results back
+    FrameVector<std::future<void>> workers;
+    workers.reserve(threadCount - 1);
+    for (unsigned thread = 1; thread < threadCount; thread++) {
+        workers.emplace_back(std::async(std::launch::async, [&, thread]() {
+            while (true) {
+                sync.arrive_and_wait();
+                if (finished) return;
+                relaxShare(thread);
+                sync.arrive_and_wait();
+            }
+        }));
+    }
+    
+    // small phases are not worth waking everyone up for
+    constexpr size_t PARALLEL_PHASE_MIN = 256;
+    auto runPhase = [&](const TrackedVector<int, MemoryTag::Pathfinder>& cells, bool heavy) {
+        phaseCells = cells.data();
+        phaseCount = cells.size();
+        phaseHeavy = heavy;
+        if (threadCount == 1 || phaseCount < PARALLEL_PHASE_MIN) {
+            relax(0, phaseCount, improved[0]);
+            return;
+        }
+        sync.arrive_and_wait();
+        relaxShare(0);
+        sync.arrive_and_wait();
+    };
+    
+    // sorts what the last phase lowered: cells of the bucket being drained go to the next frontier, the rest into the ring
+    auto collect = [&](size_t bucket) {
+        frontier.clear();
+        ++phaseStamp;
+        for (auto& out : improved) {
+            for (int index : out) {
+                const size_t target = bucketOf(dist[index]);
+                if (target == bucket) {
+                    if (queuedIn[index] != phaseStamp) {
+                        queuedIn[index] = phaseStamp;
+                        frontier.push_back(index);
+                    }
+                } else {
+                    ring[target % ringSize].push_back(index);
+                    pending++;
+                }
+            }
+            out.clear();
+        }
+    };
+    
+    const int sourceIndex = getIndex(source);
+    dist[sourceIndex] = 0.0f;
+    ring[0].push_back(sourceIndex);
+    pending = 1;
+    
+    for (size_t bucket = 0; pending > 0; bucket++) {
+        // take the bucket's live entries (an entry is stale once its cell was lowered into an earlier bucket)
+        auto& slot = ring[bucket % ringSize];
+        pending -= slot.size();
+        frontier.clear();
+        ++phaseStamp;
+        for (int index : slot) {
+            if (bucketOf(dist[index]) == bucket && queuedIn[index] != phaseStamp) {
+                queuedIn[index] = phaseStamp;
+                frontier.push_back(index);
+            }
+        }
+        slot.clear();
+        if (frontier.empty()) continue;
+        
+        settled.clear();
+        while (!frontier.empty()) {
+            settled.insert(settled.end(), frontier.begin(), frontier.end());
+            runPhase(frontier, false);
+            collect(bucket);
+            if (frontier.empty()) {
+                // heavy edges cant land in this bucket, but a rounding edge case would just come around again
+                runPhase(settled, true);
+                settled.clear();
+                collect(bucket);
+            }
+        }
+    }
+    
+    finished = true;
+    if (threadCount > 1) sync.arrive_and_wait();
+    for (auto& worker : workers) worker.get();
+    return dist;
+}
+
+
 // generic dispatcher
 PathResult Pathfinder::findPath(SimulationSettings::Algos algo, const GridCell& start, const GridCell& goal) {
     PathResult result;
@@ -4,6 +4,10 @@
 #include "SpatialGrid.h"
 #include "ParallelProcessor.h"
 #include "OptimizedTrailMap.h"
+#include "FastMath.h"
+#include "Log.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -17,6 +21,9 @@
 #include <random>
 #include <map>
 #include <numeric>
+#include <chrono>
+#include <cstring>
+#include <ctime>
 
 PhysarumSimulation::PhysarumSimulation(const SimulationSettings &settings)
     : settings_(settings)
@@ -58,7 +65,7 @@ PhysarumSimulation::PhysarumSimulation(const SimulationSettings &settings)
     }
 
     // initialize agents
-    agents_ = AgentFactory::createAgents(settings_);
+    AgentFactory::spawnAgents(agents_, settings_, {}, parallelPool());
 
     // initialize display components
     initializeDisplay();
@@ -74,21 +81,15 @@ PhysarumSimulation::PhysarumSimulation(const SimulationSettings &settings)
 
 void PhysarumSimulation::update(float deltaTime)
 {
-    // Handle benchmark mode separately
-    if (inBenchmarkMode_) {
-        updateTimer_.restart();
-        updateBenchmark(deltaTime);
-        
-        // Update trails for visualization
-        trailMap_->diffuse(settings_.diffuseRate);
-        trailMap_->decay(settings_.decayRate);
-        
-        updateDisplay();
-        lastUpdateTime_ = updateTimer_.getElapsedTime().asMilliseconds();
-        return;
-    }
-    
-    // reset audit counters each frame
+    // one tick per call + display refresh (frame driven callers), whatever the frame time was
+    (void)deltaTime;
+    simulateTicks(1, settings_.stepsPerFrame);
+    refreshDisplay();
+}
+
+void PhysarumSimulation::simulateTicks(int ticks, int stepsPerTick)
+{
+    // reset audit counters each frame (they sum over all ticks run this frame)
     auditSplits_ = 0;
     auditMatingsSame_ = 0;
     auditMatingsCross_ = 0;
@@ -96,40 +97,123 @@ void PhysarumSimulation::update(float deltaTime)
     auditSpores_ = 0;
     auditDeaths_ = 0;
     updateTimer_.restart();
+    const std::uint64_t heapBefore = FrameArena::heapAllocations();
+    int stepsRun = 0;
 
-    // update food pellets (decay over time and remove expired ones)
-    for (auto &pellet : foodPellets_)
-    {
-        pellet.update();
-    }
-    // remove expired pellets - working???
-    foodPellets_.erase(
-        std::remove_if(foodPellets_.begin(), foodPellets_.end(),
-                       [](const FoodPellet &p)
-                       { return p.isExpired(); }),
-        foodPellets_.end());
+    trailMap_->setLazyDecay(settings_.lazyDecayEnabled);
+    ParallelProcessor *pool = parallelPool();
+    const int diffusionThreads = pool ? static_cast<int>(pool->getThreadCount()) : 1;
 
-    for (int step = 0; step < settings_.stepsPerFrame; ++step)
+    for (int tick = 0; tick < ticks; ++tick)
     {
-        if (useOptimizedSystems_ && spatialGrid_)
+        // Handle benchmark mode separately (race ticks have their own fixed length, see updateBenchmark)
+        if (inBenchmarkMode_) {
+            const int raceTicks = std::max(1, settings_.benchmarkSettings.raceTicksPerTick);
+            for (int race = 0; race < raceTicks; ++race) {
+                // no jobs run between race ticks: rewind the frame arena so the workers reuse their
+                // blocks instead of each taking a new one per tick (main already did it for the first)
+                if (tick > 0 || race > 0)
+                    FrameArena::beginFrame();
+                stepBenchmarkTick(diffusionThreads);
+            }
+            continue;
+        }
+
+        // update food pellets (decay over time and remove expired ones)
+        for (auto &pellet : foodPellets_)
         {
-            // high performance update path
-            updateAgentsOptimized();
-            updateTrailsOptimized();
+            pellet.update();
         }
-        else
+        // remove expired pellets - working???
+        foodPellets_.erase(
+            std::remove_if(foodPellets_.begin(), foodPellets_.end(),
+                           [](const FoodPellet &p)
+                           { return p.isExpired(); }),
+            foodPellets_.end());
+
+        for (int step = 0; step < stepsPerTick; ++step)
+        {
+            if (useOptimizedSystems_ && spatialGrid_)
+            {
+                // high performance update path
+                updateAgentsOptimized();
+                std::future<void> sortJob = startAgentSort();
+                updateTrailsOptimized();
+                finishAgentSort(sortJob);
+            }
+            else
+            {
+                // legacy update path
+                updateAgents();
+                std::future<void> sortJob = startAgentSort();
+                updateTrails();
+                finishAgentSort(sortJob);
+            }
+            ++stepsRun;
+        }
+
+        // implicit mode: one stable ADI solve covers the whole tick worth of steps
+        // (agents wrap around the world so the trail does too)
+        if (settings_.implicitDiffusion && !(useOptimizedSystems_ && spatialGrid_))
         {
-            // legacy update path
-            updateAgents();
-            updateTrails();
+            trailMap_->diffuseImplicit(settings_.diffuseRate, stepsPerTick, true, diffusionThreads);
         }
+
+        fieldRecorder_.onSteps(*trailMap_, stepsPerTick);
     }
 
-    updateDisplay();
+    if (stepsRun > 0)
+        heapAllocsPerStep_ = (FrameArena::heapAllocations() - heapBefore) / static_cast<std::uint64_t>(stepsRun);
+    lastUpdateTime_ = updateTimer_.getElapsedTime().asMilliseconds();
+}
 
+bool PhysarumSimulation::startFieldRecording()
+{
+    if (fieldRecorder_.isRecording())
+        return true;
+
+    char stamp[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    const std::string path = std::string("field_") + stamp + ".slfr";
+
+    FieldRecorder::Options options;
+    options.stepInterval = settings_.fieldRecording.stepInterval;
+    options.bits = settings_.fieldRecording.bits;
+    options.keyframeInterval = settings_.fieldRecording.keyframeInterval;
+    if (!fieldRecorder_.start(path, options, trailMap_->getWidth(), trailMap_->getHeight(), trailMap_->getNumSpecies()))
+    {
+        std::cout << "[RECORD] could not create " << path << std::endl;
+        return false;
+    }
+    std::cout << "[RECORD] recording trail field to " << path << " (every " << options.stepInterval << " steps, "
+              << options.bits << " bit)" << std::endl;
+    return true;
+}
 
+void PhysarumSimulation::stopFieldRecording()
+{
+    if (!fieldRecorder_.isRecording())
+        return;
+    fieldRecorder_.stop();
+    const double ratio = fieldRecorder_.bytesWritten() > 0
+                             ? static_cast<double>(fieldRecorder_.rawBytes()) / fieldRecorder_.bytesWritten()
+                             : 0.0;
+    std::cout << "[RECORD] stopped: " << fieldRecorder_.framesWritten() << " frames, "
+              << fieldRecorder_.bytesWritten() / (1024.0 * 1024.0) << " MB (" << ratio << "x smaller than float32)"
+              << std::endl;
+}
 
-    lastUpdateTime_ = updateTimer_.getElapsedTime().asMilliseconds();
+void PhysarumSimulation::refreshDisplay()
+{
+    updateDisplay();
+}
+
+void PhysarumSimulation::setQualityOverrides(int blurInterval, bool allowShading, bool allowOverlay)
+{
+    blurInterval_ = std::max(1, blurInterval);
+    allowShading_ = allowShading;
+    allowOverlay_ = allowOverlay;
 }
 
 void PhysarumSimulation::reset()
@@ -155,7 +239,11 @@ void PhysarumSimulation::reset()
     std::fill(cumulativeDeathsPerSpecies_.begin(), cumulativeDeathsPerSpecies_.end(), 0);
     totalCumulativeDeaths_ = 0;
 
-    agents_ = AgentFactory::createAgents(settings_);
+    // respawn into the existing agent storage instead of building a fresh vector
+    AgentFactory::spawnAgents(agents_, settings_, {}, parallelPool());
+    stepsSinceAgentSort_ = 0;
+    sortedJumpBaseline_ = 0.0f;
+    prefetchDistance_ = -1;
     std::cout << "Simulation reset with " << agents_.size() << " agents" << std::endl;
 }
 
@@ -167,6 +255,10 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
     // the benchmark mode for specific drawing
     if (inBenchmarkMode_) {
 
+        // lanes, obstacles and agents are drawn in world coordinates through the camera
+        const sf::View screenView = window.getView();
+        window.setView(cameraView());
+
         benchmarkManager_.drawObstacles(window);
         benchmarkManager_.drawGoal(window);
         
@@ -203,14 +295,10 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
         for (const Agent& agent : agents_) {
             // debug: for detection out of bounds
             if (agent.position.y >= settings_.height) {
-                static int outOfBoundsCount = 0;
-                outOfBoundsCount++;
-                if (outOfBoundsCount % 1000 == 1) {
-                    std::cout << "OUT OF BOUNDS Y: agent=" << agent.agentId 
-                              << " algo=" << SimulationSettings::algoNames(agent.assignedAlgo)
-                              << " y=" << agent.position.y 
-                              << " height=" << settings_.height << std::endl;
-                }
+                SLIME_LOG_EVERY(Log::Level::Warn, 1000, "OUT OF BOUNDS Y: agent=" << agent.agentId
+                                << " algo=" << SimulationSettings::algoNames(agent.assignedAlgo)
+                                << " y=" << agent.position.y
+                                << " height=" << settings_.height);
             }
             
             // skipping agents outside visible bounds
@@ -253,6 +341,8 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
             }
         }
         
+        window.setView(screenView);
+
         // draws the benchmark HUD (unless all ui is hidden)
         if (!hideAllUI_) {
             benchmarkManager_.drawHUD(window, font);
@@ -266,48 +356,67 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
         return;
     }
 
-    if (showAgentOverlay_ && agentOverlayTexture_.getSize().x != 0 && agentOverlaySprite_)
+    if (showAgentOverlay_ && allowOverlay_ && agentOverlayTexture_.getSize().x != 0 && agentOverlaySprite_)
     {
         window.draw(*agentOverlaySprite_);
     }
 
+    // retained hud layer: the audit lines and pellet labels keep their glyph geometry between frames
+    hud_.beginFrame(font);
+
     // hud style label above pellet
-    for (const auto &pellet : foodPellets_)
+    RetainedHud::TextStyle pelletLabelStyle;
+    pelletLabelStyle.characterSize = 12;
+    for (size_t i = 0; i < foodPellets_.size(); ++i)
     {
-        std::string labelText = pellet.strength > 0 ? "Food Pellet" : "Repel Pellet";
-
-        sf::Text label(font, labelText, 12);
-        label.setFillColor(sf::Color::White);
-
-        // get text bounds for background sizing
-        sf::FloatRect textBounds = label.getLocalBounds();
+        const FoodPellet &pellet = foodPellets_[i];
+        const int textId = HUD_PELLET_LABELS + 2 * static_cast<int>(i);
+        sf::FloatRect textBounds = hud_.text(textId, pelletLabelStyle, [&](HudWriter &out)
+                                             { out << (pellet.strength > 0 ? "Food Pellet" : "Repel Pellet"); });
 
-        // position label above pellet (centered)
-        sf::Vector2f labelPos(pellet.position.x - textBounds.size.x / 2.0f,
-                              pellet.position.y - 40.0f); // above the pellet
-        label.setPosition(labelPos);
+        // position label above pellet (centered, in screen space so it stays readable at any zoom)
+        const sf::Vector2f pelletScreen = worldToScreen(pellet.position);
+        sf::Vector2f labelPos(pelletScreen.x - textBounds.size.x / 2.0f,
+                              pelletScreen.y - 40.0f); // above the pellet
+        hud_.place(textId, labelPos);
 
-        // draw hud style background rectangle (same style as hud)
-        sf::RectangleShape background(sf::Vector2f(textBounds.size.x + 10.0f, textBounds.size.y + 10.0f));
-        background.setPosition({labelPos.x - 5.0f, labelPos.y - 5.0f});
-        background.setFillColor(sf::Color(0, 0, 0, 120)); // semitransparent black like hud
-
-        window.draw(background);
-        window.draw(label);
+        // hud style background rectangle (same style as hud), semitransparent black like hud
+        hud_.rect(textId + 1, sf::FloatRect({labelPos.x - 5.0f, labelPos.y - 5.0f}, {textBounds.size.x + 10.0f, textBounds.size.y + 10.0f}),
+                  sf::Color(0, 0, 0, 120));
     }
 
-    // compact audit overlay (up in the top left)
+    // compact audit overlay (up in the top left). the counters move every frame, so the text is
+    // relaid out at most 4 times a second
     {
-        std::ostringstream oss;
-        oss << "splits:" << auditSplits_
-            << " same:" << auditMatingsSame_
-            << " cross:" << auditMatingsCross_
-            << " rebirth:" << auditRebirths_
-            << " spores:" << auditSpores_
-            << " | TOTAL DEATHS: " << totalCumulativeDeaths_;
-        
+        RetainedHud::TextStyle auditStyle;
+        auditStyle.characterSize = 12;
+        auditStyle.fillColor = sf::Color::Cyan;
+        auditStyle.outlineThickness = 1.0f;
+        auditStyle.refreshSeconds = 0.25f;
+        hud_.text(HUD_AUDIT, auditStyle, [&](HudWriter &out)
+        {
+            out << "splits:" << auditSplits_
+                << " same:" << auditMatingsSame_
+                << " cross:" << auditMatingsCross_
+                << " rebirth:" << auditRebirths_
+                << " spores:" << auditSpores_
+                << " | TOTAL DEATHS: " << totalCumulativeDeaths_
+                << " | upload: " << uploadStats_.bytesLastFrame / 1024 << "KB ("
+                << uploadStats_.dirtyTilesLastFrame << "/" << uploadStats_.totalTiles << " tiles)"
+                << " | heap allocs: " << FrameArena::lastFrameHeapAllocations() << "/frame "
+                << heapAllocsPerStep_ << "/step";
+            if (settings_.agentLodEnabled && !agents_.empty())
+            {
+                // share of agents sensing every step / every 2nd / every 4th
+                out << " | lod:";
+                for (int level = 0; level <= Agent::MAX_LOD_LEVEL; ++level)
+                    out << (level ? "/" : "") << (100 * agentLodCounts_[level] / static_cast<int>(agents_.size())) << "%";
+            }
+        });
+        hud_.place(HUD_AUDIT, {8.0f, 8.0f});
+
         // adds the per-species death breakdown - use actual species colors to determine names
-        auto getSpeciesName = [](const sf::Color& c) -> std::string {
+        auto getSpeciesName = [](const sf::Color& c) -> const char * {
             //matching by color to get correct name
             if (c.r > 200 && c.g < 120 && c.b < 120) return "Red";
             if (c.r < 120 && c.g > 100 && c.b > 200) return "Blue";
@@ -316,45 +425,31 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
             if (c.r > 200 && c.g < 120 && c.b > 200) return "Magenta";
             return "Species";
         };
-        std::vector<std::string> speciesNames;
-        for (const auto& sp : settings_.speciesSettings) {
-            speciesNames.push_back(getSpeciesName(sp.color));
-        }
-        std::vector<sf::Color> speciesColors = {
-            sf::Color(255, 80, 80), sf::Color(80, 150, 255), sf::Color(80, 255, 80),
-            sf::Color(255, 255, 80), sf::Color(255, 80, 255), sf::Color(50, 255, 50),
-            sf::Color(200, 0, 0), sf::Color(255, 255, 255)
-        };
-        
-        sf::Text audit(font, oss.str(), 12);
-        audit.setFillColor(sf::Color::Cyan);
-        audit.setOutlineColor(sf::Color::Black);
-        audit.setOutlineThickness(1.0f);
-        audit.setPosition({8.0f, 8.0f});
-        window.draw(audit);
-        
+
         // draws per species death counts on second line
-        std::ostringstream deathOss;
-        deathOss << "Deaths: ";
-        for (size_t i = 0; i < cumulativeDeathsPerSpecies_.size() && i < speciesNames.size(); ++i) {
-            if (i > 0) deathOss << " | ";
-            deathOss << speciesNames[i] << ":" << cumulativeDeathsPerSpecies_[i];
-        }
-        sf::Text deathText(font, deathOss.str(), 11);
-        deathText.setFillColor(sf::Color::Yellow);
-        deathText.setOutlineColor(sf::Color::Black);
-        deathText.setOutlineThickness(1.0f);
-        deathText.setPosition({8.0f, 24.0f});
-        window.draw(deathText);
+        RetainedHud::TextStyle deathStyle = auditStyle;
+        deathStyle.characterSize = 11;
+        deathStyle.fillColor = sf::Color::Yellow;
+        hud_.text(HUD_DEATHS, deathStyle, [&](HudWriter &out)
+        {
+            out << "Deaths: ";
+            for (size_t i = 0; i < cumulativeDeathsPerSpecies_.size() && i < settings_.speciesSettings.size(); ++i) {
+                if (i > 0) out << " | ";
+                out << getSpeciesName(settings_.speciesSettings[i].color) << ":" << cumulativeDeathsPerSpecies_[i];
+            }
+        });
+        hud_.place(HUD_DEATHS, {8.0f, 24.0f});
     }
 
+    hud_.draw(window);
+
     // draw cluster labels if enabled
     if (showClusterLabels_ && !agents_.empty() && !settings_.speciesSettings.empty())
     {
         const int numSpecies = static_cast<int>(settings_.speciesSettings.size());
 
         // 1) count totals per species to set thresholds
-        std::vector<int> totalPerSpecies(numSpecies, 0);
+        FrameVector<int> totalPerSpecies(numSpecies, 0);
         for (const auto &a : agents_)
         {
             if (a.speciesIndex >= 0 && a.speciesIndex < numSpecies)
@@ -369,8 +464,8 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
             sf::Vector2f sum;
             int count;
         };
-        const float cellSize = 120.0f; // tune for label density
-        std::vector<std::unordered_map<long long, Cluster>> clusters(numSpecies);
+        const float cellSize = 120.0f * std::max(1.0f, cameraZoom_); // tune for label density (in screen px)
+        FrameVector<FrameHashMap<long long, Cluster>> clusters(numSpecies);
         auto makeKey = [](int cx, int cy) -> long long
         { return (static_cast<long long>(cx) << 32) ^ (static_cast<unsigned int>(cy)); };
 
@@ -404,7 +499,9 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
                 if (cl.count < minCount)
                     continue;
 
-                sf::Vector2f centroid = sf::Vector2f(cl.sum.x / cl.count, cl.sum.y / cl.count);
+                sf::Vector2f centroid = worldToScreen(sf::Vector2f(cl.sum.x / cl.count, cl.sum.y / cl.count));
+                if (centroid.x < 0.0f || centroid.x >= viewWidth_ || centroid.y < 0.0f || centroid.y >= viewHeight_)
+                    continue; // off screen
 
                 std::ostringstream l;
                 l << "S" << s << ": " << cl.count << " agents";
@@ -415,8 +512,8 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
 
                 float offset = 12.0f + std::min(60.0f, std::sqrt(static_cast<float>(cl.count)) * 1.1f);
                 sf::FloatRect tb = label.getLocalBounds();
-                float x = std::clamp(centroid.x - tb.size.x * 0.5f, 4.0f, static_cast<float>(settings_.width) - tb.size.x - 4.0f);
-                float y = std::clamp(centroid.y - offset - tb.size.y, 4.0f, static_cast<float>(settings_.height) - tb.size.y - 4.0f);
+                float x = std::clamp(centroid.x - tb.size.x * 0.5f, 4.0f, static_cast<float>(viewWidth_) - tb.size.x - 4.0f);
+                float y = std::clamp(centroid.y - offset - tb.size.y, 4.0f, static_cast<float>(viewHeight_) - tb.size.y - 4.0f);
                 label.setPosition({x, y});
 
                 sf::RectangleShape bg;
@@ -439,7 +536,7 @@ void PhysarumSimulation::draw(sf::RenderWindow &window, sf::Font &font)
 
 }
 
-void PhysarumSimulation::updateSettings(const SimulationSettings &newSettings)
+void PhysarumSimulation::updateSettings(const SimulationSettings &newSettings, const std::vector<int> &speciesSources)
 {
     // In benchmark mode, only allow updating benchmark-specific settings
     if (inBenchmarkMode_) {
@@ -449,36 +546,148 @@ void PhysarumSimulation::updateSettings(const SimulationSettings &newSettings)
     
     bool needsResize = (newSettings.width != settings_.width ||
                         newSettings.height != settings_.height);
-    bool needsSpeciesReset = (newSettings.speciesSettings.size() != settings_.speciesSettings.size());
+    bool needsViewResize = (newSettings.viewWidth != settings_.viewWidth ||
+                            newSettings.viewHeight != settings_.viewHeight);
+    int oldWidth = settings_.width;
+    int oldHeight = settings_.height;
+    int oldSpecies = trailMap_ ? trailMap_->getNumSpecies() : 0;
 
     settings_ = newSettings;
     validateSettings();
+    prefetchDistance_ = -1; // grid size / species count may have changed, measure again
+    // new parameters change what a settled agent would sense, everyone goes back to full detail
+    for (Agent &agent : agents_)
+        agent.promoteLod();
 
-    if (needsResize || needsSpeciesReset)
+    // which old species each new species continues. no mapping from the caller means species
+    // keep their slot (extra ones are new, missing ones are dropped off the end)
+    int numSpecies = std::max(1, static_cast<int>(settings_.speciesSettings.size()));
+    std::vector<int> sources = speciesSources;
+    if (sources.size() != static_cast<size_t>(numSpecies))
     {
-        int numSpecies = std::max(1, static_cast<int>(settings_.speciesSettings.size()));
-        trailMap_ = std::make_unique<TrailMap>(settings_.width, settings_.height, numSpecies);
+        sources.resize(numSpecies);
+        for (int i = 0; i < numSpecies; ++i)
+            sources[i] = (i < oldSpecies) ? i : -1;
+    }
 
-        // resize cumulative death tracking for new species count
-        cumulativeDeathsPerSpecies_.resize(numSpecies, 0);
+    bool needsSpeciesRemap = (numSpecies != oldSpecies);
+    for (int i = 0; i < numSpecies && !needsSpeciesRemap; ++i)
+        needsSpeciesRemap = (sources[i] != i);
 
+    if (!trailMap_)
+    {
+        trailMap_ = std::make_unique<TrailMap>(settings_.width, settings_.height, numSpecies);
+    }
+
+    if (needsResize || needsSpeciesRemap)
+    {
+        // reconfigure in place: existing trails and agents survive, only what changed is touched
+        if (needsSpeciesRemap)
+        {
+            trailMap_->remapSpecies(sources);
+        }
         if (needsResize)
         {
+            trailMap_->resize(settings_.width, settings_.height);
             initializeDisplay();
         }
-        
-        // only recreate agents if species count changed or dimensions changed
-        agents_ = AgentFactory::createAgents(settings_);
 
-        std::cout << "TrailMap recreated for " << numSpecies << " species" << std::endl;
+        remapAgents(sources, oldSpecies, oldWidth, oldHeight);
+
+        // carry death tracking over with its species
+        std::vector<std::uint64_t> deaths(numSpecies, 0);
+        for (int i = 0; i < numSpecies; ++i)
+        {
+            if (sources[i] >= 0 && sources[i] < static_cast<int>(cumulativeDeathsPerSpecies_.size()))
+                deaths[i] = cumulativeDeathsPerSpecies_[sources[i]];
+        }
+        cumulativeDeathsPerSpecies_ = std::move(deaths);
+
+        // new species get their own colonies, everyone else keeps going
+        std::vector<int> newSpecies;
+        for (int i = 0; i < numSpecies; ++i)
+        {
+            if (sources[i] < 0 || sources[i] >= oldSpecies)
+                newSpecies.push_back(i);
+        }
+        AgentFactory::spawnSpecies(agents_, settings_, newSpecies, parallelPool());
+
+        std::cout << "TrailMap reconfigured for " << numSpecies << " species at "
+                  << settings_.width << "x" << settings_.height << " (" << agents_.size() << " agents)" << std::endl;
+    }
+    // new display resolution on the same world (a world resize already rebuilt the display above)
+    if (needsViewResize && !needsResize)
+    {
+        initializeDisplay();
     }
     // do not auto recreate agents for numAgents changes - a user must press the space bar to reset
 }
 
+void PhysarumSimulation::remapAgents(const std::vector<int> &sources, int oldSpecies, int oldWidth, int oldHeight)
+{
+    // old species index -> new species index (-1 = species was removed)
+    std::vector<int> newIndexOf(std::max(0, oldSpecies), -1);
+    for (size_t i = 0; i < sources.size(); ++i)
+    {
+        if (sources[i] >= 0 && sources[i] < oldSpecies)
+            newIndexOf[sources[i]] = static_cast<int>(i);
+    }
+    auto remapSpecies = [&newIndexOf](int species) {
+        return (species >= 0 && species < static_cast<int>(newIndexOf.size())) ? newIndexOf[species] : -1;
+    };
+
+    // agents of removed species leave with their trail channel
+    agents_.erase(std::remove_if(agents_.begin(), agents_.end(), [&](const Agent &agent) {
+                      return remapSpecies(agent.speciesIndex) < 0;
+                  }),
+                  agents_.end());
+
+    const bool resized = (oldWidth != settings_.width || oldHeight != settings_.height);
+    const float scaleX = static_cast<float>(settings_.width) / std::max(1, oldWidth);
+    const float scaleY = static_cast<float>(settings_.height) / std::max(1, oldHeight);
+    const float maxX = static_cast<float>(settings_.width - 1);
+    const float maxY = static_cast<float>(settings_.height - 1);
+
+    auto remapAgent = [&](Agent &agent) {
+        agent.speciesIndex = remapSpecies(agent.speciesIndex);
+        agent.setDefaultSpeciesMask(agent.speciesIndex);
+        agent.parentSpeciesA = remapSpecies(agent.parentSpeciesA);
+        agent.parentSpeciesB = remapSpecies(agent.parentSpeciesB);
+
+        if (resized)
+        {
+            // same relative spot in the resampled world, old path memory is in the wrong space now
+            agent.position.x = std::clamp(agent.position.x * scaleX, 0.0f, maxX);
+            agent.position.y = std::clamp(agent.position.y * scaleY, 0.0f, maxY);
+            agent.pathMemoryCount = 0;
+            agent.pathMemoryIndex = 0;
+        }
+    };
+
+    if (ParallelProcessor *pool = parallelPool())
+        pool->processAgentsParallel(agents_, remapAgent);
+    else
+        std::for_each(agents_.begin(), agents_.end(), remapAgent);
+}
+
+ParallelProcessor *PhysarumSimulation::parallelPool()
+{
+    // the pool is only built up front for the optimized systems, the spawner and the
+    // benchmark step want it regardless so create it on first use
+    if (!useParallelUpdates_)
+        return nullptr;
+    if (!parallelProcessor_)
+    {
+        unsigned int numThreads = std::max(1u, std::thread::hardware_concurrency());
+        parallelProcessor_ = std::make_unique<ParallelProcessor>(numThreads);
+    }
+    return parallelProcessor_.get();
+}
+
 void PhysarumSimulation::setAgentCount(int count)
 {
     settings_.numAgents = std::max(1, count);
-    agents_ = AgentFactory::createAgents(settings_);
+    AgentFactory::spawnAgents(agents_, settings_, {}, parallelPool());
 }
 
 void PhysarumSimulation::adjustAgentCount(int delta)
@@ -489,29 +698,7 @@ void PhysarumSimulation::adjustAgentCount(int delta)
     if (delta > 0 && !agents_.empty())
     {
         // adds new agents via cloning existing ones (spawn from existing agents)
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        std::uniform_int_distribution<size_t> agentDist(0, agents_.size() - 1);
-        std::uniform_real_distribution<float> offsetDist(-5.0f, 5.0f);  // small offset from parent
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * M_PI);
-        
-        size_t originalSize = agents_.size();
-        for (int i = 0; i < delta; ++i)
-        {
-            // random existing agent to spawn from (only from original agents)
-            std::uniform_int_distribution<size_t> parentDist(0, originalSize - 1);
-            size_t parentIdx = parentDist(gen);
-            const Agent& parent = agents_[parentIdx];
-            
-            // spawns very close to the parent agent
-            float x = std::clamp(parent.position.x + offsetDist(gen), 0.0f, static_cast<float>(settings_.width - 1));
-            float y = std::clamp(parent.position.y + offsetDist(gen), 0.0f, static_cast<float>(settings_.height - 1));
-            float angle = angleDist(gen);
-            
-            agents_.emplace_back(x, y, angle, parent.speciesIndex);
-            agents_.back().setDefaultSpeciesMask(parent.speciesIndex);
-            agents_.back().applyGenomeToCachedParams(settings_);  // initialize moveSpeed etc
-        }
+        AgentFactory::spawnClones(agents_, static_cast<size_t>(delta), settings_, parallelPool());
         settings_.numAgents = static_cast<int>(agents_.size());
         std::cout << "Added " << delta << " agents (total: " << agents_.size() << ")" << std::endl;
     }
@@ -549,6 +736,9 @@ void PhysarumSimulation::depositFood(int x, int y, float amount, int radius)
     // convert screen coordinates to trail map coordinates if needed
     // for now just assuming direct mapping
 
+    // agents coasting at low detail nearby have to notice the new trail (sensors reach past the brush)
+    promoteAgentsNear(static_cast<float>(x), static_cast<float>(y), radius * 2.0f);
+
     // deposit food to all species channels (food affects all species)
     for (int species = 0; species < trailMap_->getNumSpecies(); ++species)
     {
@@ -563,10 +753,10 @@ void PhysarumSimulation::depositFood(int x, int y, float amount, int radius)
                 if (targetX >= 0 && targetX < settings_.width &&
                     targetY >= 0 && targetY < settings_.height)
                 {
-                    // calculating distance based falloff
-                    float distance = std::sqrt(dx * dx + dy * dy);
-                    if (distance <= radius)
+                    // calculating distance based falloff (squared test first, sqrt only inside the disk)
+                    if (dx * dx + dy * dy <= radius * radius)
                     {
+                        float distance = std::sqrt(static_cast<float>(dx * dx + dy * dy));
                         float falloff = 1.0f - (distance / radius);
                         float depositAmount = amount * falloff * falloff; // a quadratic falloff for smoother effect
 
@@ -584,6 +774,8 @@ void PhysarumSimulation::depositRepellent(int x, int y, float amount, int radius
         return;
 
     // convert screen coordinates to trail map coordinates if needed
+    promoteAgentsNear(static_cast<float>(x), static_cast<float>(y), radius * 2.0f);
+
     // deposit repellent (negative amount) to all species channels
     for (int species = 0; species < trailMap_->getNumSpecies(); ++species)
     {
@@ -597,9 +789,9 @@ void PhysarumSimulation::depositRepellent(int x, int y, float amount, int radius
                 if (targetX >= 0 && targetX < settings_.width &&
                     targetY >= 0 && targetY < settings_.height)
                 {
-                    float distance = std::sqrt(dx * dx + dy * dy);
-                    if (distance <= radius)
+                    if (dx * dx + dy * dy <= radius * radius)
                     {
+                        float distance = std::sqrt(static_cast<float>(dx * dx + dy * dy));
                         float falloff = 1.0f - (distance / radius);
                         float depositAmount = amount * falloff * falloff; // (amount is already negative)
 
@@ -626,9 +818,40 @@ void PhysarumSimulation::addFoodPellet(int x, int y, float strength, float radiu
     float decayRate = 0.9995f; // almost no decay (was 0.995f)
 
     foodPellets_.emplace_back(x, y, pelletStrength, pelletRadius, decayRate, pelletType);
+    promoteAgentsNear(static_cast<float>(x), static_cast<float>(y), pelletRadius);
+
+    SLIME_LOG(Log::Level::Info, "Added MEGA food pellet at (" << x << "," << y << ") strength=" << pelletStrength
+              << " radius=" << pelletRadius << " type=" << pelletType);
+}
+
+void PhysarumSimulation::promoteAgentsNear(float x, float y, float radius)
+{
+    const float radius2 = radius * radius;
+    for (Agent &agent : agents_)
+    {
+        const float dx = agent.position.x - x;
+        const float dy = agent.position.y - y;
+        if (dx * dx + dy * dy <= radius2)
+            agent.promoteLod();
+    }
+}
 
-    std::cout << "Added MEGA food pellet at (" << x << "," << y << ") strength=" << pelletStrength
-              << " radius=" << pelletRadius << " type=" << pelletType << std::endl;
+template <typename SenseFn>
+bool PhysarumSimulation::senseWithLod(Agent &agent, size_t slot, SenseFn &&sense)
+{
+    if (!settings_.agentLodEnabled)
+    {
+        sense();
+        return true;
+    }
+    // the slot staggers the schedule so the skipping agents dont all sense on the same step
+    if (!agent.lodSenseDue(lodStep_ + static_cast<std::uint32_t>(slot)))
+        return false;
+    const float before = agent.angle;
+    sense();
+    const bool turned = std::abs(std::remainder(agent.angle - before, 6.28318531f)) > 1e-3f;
+    agent.recordLodSense(turned, settings_.agentLodStableSteps);
+    return true;
 }
 
 void PhysarumSimulation::clearFoodPellets()
@@ -639,18 +862,26 @@ void PhysarumSimulation::clearFoodPellets()
 
 void PhysarumSimulation::initializeDisplay()
 {
+    // the display works at view resolution, the world can be any size behind the camera
+    viewWidth_ = settings_.viewWidth > 0 ? settings_.viewWidth : settings_.width;
+    viewHeight_ = settings_.viewHeight > 0 ? settings_.viewHeight : settings_.height;
+    resetCamera();
+
     // initializtion of image with new size and black fill
-    displayImage_ = sf::Image(sf::Vector2u(static_cast<unsigned>(settings_.width),
-                         static_cast<unsigned>(settings_.height)),
+    displayImage_ = sf::Image(sf::Vector2u(static_cast<unsigned>(viewWidth_),
+                         static_cast<unsigned>(viewHeight_)),
                          sf::Color::Black);
 
     displayTexture_ = sf::Texture(displayImage_);
     displayTexture_.setSmooth(true);
+    // fresh texture: the next update uploads in full and starts the dirty tracking over
+    uploadedPixels_.clear();
+    uploadStats_ = DisplayUploadStats{};
 
     setupDisplaySprite();
 
-    agentOverlayTexture_.resize({static_cast<unsigned>(settings_.width),
-                                static_cast<unsigned>(settings_.height)});
+    agentOverlayTexture_.resize({static_cast<unsigned>(viewWidth_),
+                                static_cast<unsigned>(viewHeight_)});
     agentOverlayTexture_.setSmooth(true);
     agentOverlaySprite_.emplace(agentOverlayTexture_);
     agentOverlaySprite_->setPosition(displaySprite_->getPosition());
@@ -659,6 +890,81 @@ void PhysarumSimulation::initializeDisplay()
     overlayBuffers();
 }
 
+// ============================== camera ==============================
+
+float PhysarumSimulation::maxCameraZoom() const
+{
+    return std::max(static_cast<float>(settings_.width) / std::max(1, viewWidth_),
+                    static_cast<float>(settings_.height) / std::max(1, viewHeight_));
+}
+
+void PhysarumSimulation::clampCamera()
+{
+    // zoom in down to 8 screen pixels per cell, out until the whole world fits
+    constexpr float MIN_CAMERA_ZOOM = 0.125f;
+    cameraZoom_ = std::clamp(cameraZoom_, MIN_CAMERA_ZOOM, std::max(MIN_CAMERA_ZOOM, maxCameraZoom()));
+
+    // keep the view inside the world, an axis that is wider than the world stays centered
+    const float halfW = viewWidth_ * cameraZoom_ * 0.5f;
+    const float halfH = viewHeight_ * cameraZoom_ * 0.5f;
+    const float worldW = static_cast<float>(settings_.width);
+    const float worldH = static_cast<float>(settings_.height);
+    cameraCenter_.x = (2.0f * halfW >= worldW) ? worldW * 0.5f : std::clamp(cameraCenter_.x, halfW, worldW - halfW);
+    cameraCenter_.y = (2.0f * halfH >= worldH) ? worldH * 0.5f : std::clamp(cameraCenter_.y, halfH, worldH - halfH);
+}
+
+void PhysarumSimulation::resetCamera()
+{
+    cameraZoom_ = maxCameraZoom();
+    cameraCenter_ = sf::Vector2f(settings_.width * 0.5f, settings_.height * 0.5f);
+    clampCamera();
+}
+
+void PhysarumSimulation::panCamera(sf::Vector2f screenDelta)
+{
+    // the world follows the cursor
+    cameraCenter_ -= screenDelta * cameraZoom_;
+    clampCamera();
+}
+
+void PhysarumSimulation::zoomCamera(float factor, sf::Vector2i screenAnchor)
+{
+    // the world point under the anchor stays put
+    const sf::Vector2f anchorWorld = screenToWorld(screenAnchor);
+    cameraZoom_ *= factor;
+    clampCamera();
+    const sf::Vector2f anchorOffset(screenAnchor.x - viewWidth_ * 0.5f, screenAnchor.y - viewHeight_ * 0.5f);
+    cameraCenter_ = anchorWorld - anchorOffset * cameraZoom_;
+    clampCamera();
+}
+
+sf::Vector2f PhysarumSimulation::screenToWorld(sf::Vector2i screen) const
+{
+    const TrailMap::Viewport view = cameraViewport();
+    return sf::Vector2f(view.originX + screen.x * view.scale, view.originY + screen.y * view.scale);
+}
+
+sf::Vector2f PhysarumSimulation::worldToScreen(sf::Vector2f world) const
+{
+    const TrailMap::Viewport view = cameraViewport();
+    return sf::Vector2f((world.x - view.originX) / view.scale, (world.y - view.originY) / view.scale);
+}
+
+TrailMap::Viewport PhysarumSimulation::cameraViewport() const
+{
+    TrailMap::Viewport view;
+    view.scale = cameraZoom_;
+    view.originX = cameraCenter_.x - viewWidth_ * cameraZoom_ * 0.5f;
+    view.originY = cameraCenter_.y - viewHeight_ * cameraZoom_ * 0.5f;
+    view.meanReduce = settings_.viewMeanDownsample;
+    return view;
+}
+
+sf::View PhysarumSimulation::cameraView() const
+{
+    return sf::View(cameraCenter_, sf::Vector2f(viewWidth_ * cameraZoom_, viewHeight_ * cameraZoom_));
+}
+
 void PhysarumSimulation::updateAgents()
 {
     // check if we have multiple species
@@ -669,25 +975,33 @@ void PhysarumSimulation::updateAgents()
     {
         spatialGrid_->rebuild(agents_);
     }
+    ++lodStep_;
 
     if (isMultiSpecies)
     {
         // track starting population per species for conditional rebirth
-        std::vector<int> currentPopPerSpecies(settings_.speciesSettings.size(), 0);
+        FrameVector<int> currentPopPerSpecies(settings_.speciesSettings.size(), 0);
         for (const auto &a : agents_) {
             if (a.speciesIndex >= 0 && a.speciesIndex < static_cast<int>(currentPopPerSpecies.size()))
                 ++currentPopPerSpecies[a.speciesIndex];
         }
         
+        const size_t prefetchAhead = static_cast<size_t>(sensingPrefetchDistance());
         for (size_t i = 0; i < agents_.size(); ++i)
         {
+            // sensor cells of the agent prefetchAhead slots on start loading now, used when we get there
+            if (prefetchAhead > 0 && i + prefetchAhead < agents_.size() &&
+                agents_[i + prefetchAhead].lodSenseDue(lodStep_ + static_cast<std::uint32_t>(i + prefetchAhead)))
+                agents_[i + prefetchAhead].prefetchSensors(*trailMap_, settings_);
+
             Agent &agent = agents_[i];
             if (agent.speciesIndex < 0 || agent.speciesIndex >= static_cast<int>(settings_.speciesSettings.size()))
                 continue;
                 
             const auto &sp = settings_.speciesSettings[agent.speciesIndex];
             
-            agent.senseMultiSpecies(*trailMap_, settings_);
+            senseWithLod(agent, i, [&]
+                         { agent.senseMultiSpecies(*trailMap_, settings_); });
 
             // pellets completely override normal movement no distance check here!
             if (!foodPellets_.empty())
@@ -745,6 +1059,9 @@ void PhysarumSimulation::updateAgents()
                         float stolen = std::min(victim.energy, sp.energyStealRate);
                         victim.energy -= stolen;
                         agent.energy += stolen;
+                        // interactions pull both back to full detail
+                        victim.promoteLod();
+                        agent.promoteLod();
                     }
                 }
             }
@@ -769,6 +1086,8 @@ void PhysarumSimulation::updateAgents()
                         if (given > 0) {
                             agent.energy -= given;
                             recipient.energy += given;
+                            recipient.promoteLod();
+                            agent.promoteLod();
                         }
                     }
                 }
@@ -843,11 +1162,20 @@ void PhysarumSimulation::updateAgents()
     }
     else
     {
-        // use legacy single species methods with mega pellet override
-        float *trailData = trailMap_->getData();
-        for (auto &agent : agents_)
+        // use legacy single species methods with mega pellet override. sensing reads the stored values
+        // as they are: it only compares left / forward / right, which one scale factor cant reorder, so
+        // the channel doesnt have to be settled (a full sweep) every step. deposits go through the map
+        const float *trailData = static_cast<const TrailMap &>(*trailMap_).getData();
+        const size_t prefetchAhead = static_cast<size_t>(sensingPrefetchDistance());
+        for (size_t i = 0; i < agents_.size(); ++i)
         {
-            agent.sense(trailData, settings_.width, settings_.height, settings_);
+            if (prefetchAhead > 0 && i + prefetchAhead < agents_.size() &&
+                agents_[i + prefetchAhead].lodSenseDue(lodStep_ + static_cast<std::uint32_t>(i + prefetchAhead)))
+                agents_[i + prefetchAhead].prefetchSensors(trailData, settings_.width, settings_.height, settings_);
+
+            Agent &agent = agents_[i];
+            senseWithLod(agent, i, [&]
+                         { agent.sense(trailData, settings_.width, settings_.height, settings_); });
 
             // pellets completely override normal movement no distance check
             if (!foodPellets_.empty())
@@ -855,7 +1183,7 @@ void PhysarumSimulation::updateAgents()
             else
                 agent.move(settings_);
 
-            agent.deposit(trailData, settings_.width, settings_.height, settings_);
+            agent.deposit(*trailMap_, settings_);
             {
                 auto le = agent.updateEnergyAndState(settings_);
                 if (le == Agent::LifeEvent::Rebirth)
@@ -866,10 +1194,15 @@ void PhysarumSimulation::updateAgents()
         }
     }
 
+    // level of detail census (what the hud reports)
+    agentLodCounts_.fill(0);
+    for (const Agent &a : agents_)
+        ++agentLodCounts_[std::min<int>(a.lodLevel, Agent::MAX_LOD_LEVEL)];
+
     // handle deaths and spore bursts (legacy path)
     {
         //counts the current population per species for conditional rebirth
-        std::vector<int> currentPopPerSpecies(settings_.speciesSettings.size(), 0);
+        FrameVector<int> currentPopPerSpecies(settings_.speciesSettings.size(), 0);
         for (const auto &a : agents_) {
             if (a.speciesIndex >= 0 && a.speciesIndex < static_cast<int>(currentPopPerSpecies.size()))
                 ++currentPopPerSpecies[a.speciesIndex];
@@ -878,7 +1211,7 @@ void PhysarumSimulation::updateAgents()
         // calculates starting population per species (estimate from numAgents / species count)
         int startingPopPerSpecies = settings_.numAgents / std::max(1, static_cast<int>(settings_.speciesSettings.size()));
         
-        std::vector<size_t> toRemove;
+        FrameVector<size_t> toRemove;
         toRemove.reserve(64);
         for (size_t i = 0; i < agents_.size(); ++i)
         {
@@ -949,7 +1282,9 @@ void PhysarumSimulation::updateAgents()
                     return std::clamp(parentVal * (1.0f + delta), 0.5f, 1.5f);
                 };
                 
-                for (int s = 0; s < std::max(0, sp.sporeCount); ++s)
+                // spore bursts were never count capped, only a memory budget limits them
+                const size_t sporeCap = MemoryTracker::budget() > 0 ? populationCap() : SIZE_MAX;
+                for (int s = 0; s < std::max(0, sp.sporeCount) && agents_.size() < sporeCap; ++s)
                 {
                     float ang = 2.0f * 3.14159265f * (std::rand() / (float)RAND_MAX);
                     float r = sp.sporeRadius * (std::rand() / (float)RAND_MAX);
@@ -1003,13 +1338,10 @@ void PhysarumSimulation::updateAgents()
 
     // lightweight reproduction pass (legacy path)
     // global pop cap - prevent runaway growth
-    const size_t maxPopulation = static_cast<size_t>(settings_.numAgents * 2);  // cap at 2x starting population
+    const size_t maxPopulation = populationCap();  // 2x starting population, less when the memory budget is tight
     if (agents_.size() >= maxPopulation) {
         // population at cap - no reproduction allowed
-        static int capWarnCounter = 0;
-        if (++capWarnCounter % 300 == 0) {
-            std::cout << "Population at cap (" << agents_.size() << "/" << maxPopulation << ") - reproduction paused" << std::endl;
-        }
+        SLIME_LOG_EVERY(Log::Level::Info, 5000, "Population at cap (" << agents_.size() << "/" << maxPopulation << ") - reproduction paused");
         return;  // skipping reproduction entirely
     }
     
@@ -1021,9 +1353,9 @@ void PhysarumSimulation::updateAgents()
     size_t born = 0;
     
     // debug: counts agents per species and their energy states
-    static int debugCounter = 0;
-    if (++debugCounter % 300 == 0) { // every 5 seconds at 60fps
-        std::cerr << "\n [DEBUG] Species status " << std::endl;
+    static Log::RateLimit speciesStatusSite(5000); // every 5 seconds
+    if (Log::due(Log::Level::Debug, speciesStatusSite)) {
+        SLIME_LOG(Log::Level::Debug, "\n [DEBUG] Species status ");
         for (int speciesIdx = 0; speciesIdx < static_cast<int>(settings_.speciesSettings.size()); ++speciesIdx) {
             const auto& sp = settings_.speciesSettings[speciesIdx];
             int count = 0;
@@ -1041,15 +1373,14 @@ void PhysarumSimulation::updateAgents()
                 }
             }
             float avgE = count > 0 ? totalEnergy / count : 0;
-            std::cerr << "  Species " << speciesIdx << ": " << count << " agents"
+            SLIME_LOG(Log::Level::Debug, "  Species " << speciesIdx << ": " << count << " agents"
                       << ", avgEnergy=" << avgE 
                       << ", splitThreshold=" << sp.splitEnergyThreshold
                       << ", canSplit=" << canSplit 
                       << ", onCooldown=" << onCooldown
-                      << ", splittingEnabled=" << sp.splittingEnabled
-                      << std::endl;
+                      << ", splittingEnabled=" << sp.splittingEnabled);
         }
-        std::cerr << "  BIRTHS this check: splits=" << auditSplits_ << " matingSame=" << auditMatingsSame_ << std::endl;
+        SLIME_LOG(Log::Level::Debug, "  BIRTHS this check: splits=" << auditSplits_ << " matingSame=" << auditMatingsSame_);
     }
     
     for (size_t i = 0; i < agents_.size() && born < maxOffspring; ++i)
@@ -1097,7 +1428,7 @@ void PhysarumSimulation::updateAgents()
             float r2 = r * r;
             
             // use spatial grid for nearby agents - O(1) instead of O(n)...
-            std::vector<size_t> nearbyIndices;
+            FrameVector<size_t> nearbyIndices;
             if (spatialGrid_)
             {
                 nearbyIndices = spatialGrid_->getNearbyAgents(a.position.x, a.position.y, r);
@@ -1155,12 +1486,13 @@ void PhysarumSimulation::updateAgents()
 
 void PhysarumSimulation::updateTrails()
 {
-    trailMap_->diffuse(settings_.diffuseRate);
+    // implicit diffusion runs once per tick in simulateTicks instead
+    if (!settings_.implicitDiffusion)
+        trailMap_->diffuse(settings_.diffuseRate);
     trailMap_->decay(settings_.decayRate);
 
-    // apply blur only every few frames to reduce performance impact
-    static int blurCounter = 0;
-    if (settings_.blurEnabled && (++blurCounter % 2 == 0))
+    // apply blur only every few frames to reduce performance impact (cadence set by the frame budget)
+    if (settings_.blurEnabled && (++blurCounter_ % blurInterval_ == 0))
     {
         trailMap_->applyBlur();
     }
@@ -1179,48 +1511,52 @@ void PhysarumSimulation::updateDisplay()
         sf::Color(255, 255, 0)    
     };
 
+    // only the part of the world under the camera gets converted, at display resolution
+    const TrailMap::Viewport view = cameraViewport();
+
     if (inBenchmarkMode_) {
-        std::vector<sf::Color> benchmarkColors(BENCHMARK_COLORS, BENCHMARK_COLORS + 7);
-        trailMap_->updateMultiSpeciesTexture(displayImage_, settings_.displayThreshold, benchmarkColors);
+        trailMap_->updateMultiSpeciesTexture(displayImage_, settings_.displayThreshold, BENCHMARK_COLORS, settings_.fastMath, view);
     }
     // check for if we have multiple species
     else if (settings_.speciesSettings.size() > 1)
     {
         // multi species display with color blending
-        std::vector<sf::Color> speciesColors;
+        FrameVector<sf::Color> speciesColors;
+        speciesColors.reserve(settings_.speciesSettings.size());
         for (const auto &speciesSettings : settings_.speciesSettings)
         {
             speciesColors.push_back(speciesSettings.color);
         }
-        trailMap_->updateMultiSpeciesTexture(displayImage_, settings_.displayThreshold, speciesColors);
+        trailMap_->updateMultiSpeciesTexture(displayImage_, settings_.displayThreshold, speciesColors, settings_.fastMath, view);
     }
     else
     {
         // use single species display
         sf::Color baseColor = settings_.speciesSettings.empty() ? sf::Color(255, 230, 0) : settings_.speciesSettings[0].color;
-        trailMap_->updateTexture(displayImage_, settings_.displayThreshold, baseColor);
+        trailMap_->updateTexture(displayImage_, settings_.displayThreshold, baseColor, settings_.fastMath, view);
     }
 
     // draws food pellets as subtle blurry circles
     for (const auto &pellet : foodPellets_)
     {
-        // small reasonable visual radius
-        int radius = 30; // fixed small radius for visibility
-        int centerX = static_cast<int>(pellet.position.x);
-        int centerY = static_cast<int>(pellet.position.y);
+        // small reasonable visual radius (30 world px, drawn where the camera puts it)
+        int radius = std::max(2, static_cast<int>(30.0f / view.scale));
+        const sf::Vector2f center = worldToScreen(pellet.position);
+        int centerX = static_cast<int>(center.x);
+        int centerY = static_cast<int>(center.y);
 
         // opaque colors: dark red for attractive, darker red for repulsive
         sf::Color coreColor = pellet.strength > 0 ? sf::Color(120, 30, 30, 200) : // dark red for attractive
                                   sf::Color(80, 20, 20, 180);                     // darker red for repulsive
 
-        // draw circle with soft blurry edges
+        // draw circle with soft blurry edges (corners rejected on squared distance before the sqrt)
         for (int y = -radius; y <= radius; ++y)
         {
             for (int x = -radius; x <= radius; ++x)
             {
-                float distance = std::sqrt(x * x + y * y);
-                if (distance <= radius)
+                if (x * x + y * y <= radius * radius)
                 {
+                    float distance = std::sqrt(static_cast<float>(x * x + y * y));
                     int px = centerX + x;
                     int py = centerY + y;
                     if (px >= 0 && px < static_cast<int>(displayImage_.getSize().x) &&
@@ -1256,7 +1592,7 @@ void PhysarumSimulation::updateDisplay()
     // via central differences on the luminance and applying simple lighting.
     const unsigned w = displayImage_.getSize().x;
     const unsigned h = displayImage_.getSize().y;
-    if (settings_.slimeShadingEnabled && w > 2 && h > 2)
+    if (settings_.slimeShadingEnabled && allowShading_ && w > 2 && h > 2)
     {
         sf::Image shaded(sf::Vector2u(w, h), sf::Color::Black);
 
@@ -1320,10 +1656,11 @@ void PhysarumSimulation::updateDisplay()
                 H.y /= hlen;
                 H.z /= hlen;
                 float NdotH = std::max(0.0f, N.x * H.x + N.y * H.y + N.z * H.z);
-                float spec = std::pow(NdotH, specPower) * specStrength;
+                float spec = FastMath::pow(NdotH, specPower, settings_.fastMath) * specStrength;
 
                 // rim lighting (attempt to give a gooey edge)
-                float rim = std::pow(1.0f - std::max(0.0f, N.x * V.x + N.y * V.y + N.z * V.z), 2.0f) * rimStrength;
+                float rimBase = 1.0f - std::max(0.0f, N.x * V.x + N.y * V.y + N.z * V.z);
+                float rim = rimBase * rimBase * rimStrength;
 
                 float shade = 0.15f + 0.85f * NdotL; // ambient + diffuse
                 float outR = std::clamp(rC * shade + spec + rim * 0.2f, 0.0f, 1.0f);
@@ -1333,16 +1670,98 @@ void PhysarumSimulation::updateDisplay()
                 shaded.setPixel(sf::Vector2u(x, y), sf::Color(static_cast<std::uint8_t>(outR * 255.0f), static_cast<std::uint8_t>(outG * 255.0f), static_cast<std::uint8_t>(outB * 255.0f)));
             }
         }
-        displayTexture_.update(shaded);
+        uploadDirtyTiles(shaded);
     }
     else
     {
-        displayTexture_.update(displayImage_);
+        uploadDirtyTiles(displayImage_);
     }
 
     updateAgentOverlayTexture();
 }
 
+namespace
+{
+    // dirty tracking granularity for the trail texture (64 x 64 rgba = 16 KB per tile)
+    constexpr unsigned DISPLAY_TILE_SIZE = 64;
+}
+
+void PhysarumSimulation::uploadDirtyTiles(const sf::Image &image)
+{
+    const unsigned w = image.getSize().x;
+    const unsigned h = image.getSize().y;
+    const std::uint8_t *pixels = image.getPixelsPtr();
+    const size_t rowBytes = static_cast<size_t>(w) * 4;
+    const unsigned tilesX = (w + DISPLAY_TILE_SIZE - 1) / DISPLAY_TILE_SIZE;
+    const unsigned tilesY = (h + DISPLAY_TILE_SIZE - 1) / DISPLAY_TILE_SIZE;
+    uploadStats_.totalTiles = static_cast<int>(tilesX * tilesY);
+    uploadStats_.bytesLastFrame = 0;
+    uploadStats_.dirtyTilesLastFrame = 0;
+    if (!pixels || w == 0 || h == 0)
+        return;
+
+    // nothing uploaded yet at this size: send everything once
+    if (uploadedPixels_.size() != rowBytes * h)
+    {
+        uploadedPixels_.assign(pixels, pixels + rowBytes * h);
+        displayTexture_.update(image);
+        uploadStats_.bytesLastFrame = rowBytes * h;
+        uploadStats_.dirtyTilesLastFrame = uploadStats_.totalTiles;
+        uploadStats_.totalBytes = rowBytes * h;
+        return;
+    }
+
+    std::vector<bool> dirty(tilesX);
+    for (unsigned ty = 0; ty < tilesY; ++ty)
+    {
+        const unsigned y0 = ty * DISPLAY_TILE_SIZE;
+        const unsigned y1 = std::min(h, y0 + DISPLAY_TILE_SIZE);
+
+        // a tile is dirty when any of its quantized colors differs from what the texture holds
+        for (unsigned tx = 0; tx < tilesX; ++tx)
+        {
+            const size_t offset = static_cast<size_t>(tx) * DISPLAY_TILE_SIZE * 4;
+            const size_t bytes = static_cast<size_t>(std::min(w, (tx + 1) * DISPLAY_TILE_SIZE) - tx * DISPLAY_TILE_SIZE) * 4;
+            bool changed = false;
+            for (unsigned y = y0; y < y1 && !changed; ++y)
+            {
+                changed = std::memcmp(pixels + y * rowBytes + offset, uploadedPixels_.data() + y * rowBytes + offset, bytes) != 0;
+            }
+            dirty[tx] = changed;
+        }
+
+        // neighbouring dirty tiles in this band go up as one sub rectangle
+        for (unsigned tx = 0; tx < tilesX;)
+        {
+            if (!dirty[tx])
+            {
+                ++tx;
+                continue;
+            }
+            unsigned runEnd = tx;
+            while (runEnd < tilesX && dirty[runEnd])
+                ++runEnd;
+
+            const unsigned x0 = tx * DISPLAY_TILE_SIZE;
+            const unsigned x1 = std::min(w, runEnd * DISPLAY_TILE_SIZE);
+            const size_t spanBytes = static_cast<size_t>(x1 - x0) * 4;
+            tileUploadScratch_.resize(spanBytes * (y1 - y0));
+            for (unsigned y = y0; y < y1; ++y)
+            {
+                const std::uint8_t *src = pixels + y * rowBytes + static_cast<size_t>(x0) * 4;
+                std::memcpy(tileUploadScratch_.data() + (y - y0) * spanBytes, src, spanBytes);
+                std::memcpy(uploadedPixels_.data() + y * rowBytes + static_cast<size_t>(x0) * 4, src, spanBytes);
+            }
+            displayTexture_.update(tileUploadScratch_.data(), sf::Vector2u(x1 - x0, y1 - y0), sf::Vector2u(x0, y0));
+
+            uploadStats_.bytesLastFrame += tileUploadScratch_.size();
+            uploadStats_.dirtyTilesLastFrame += static_cast<int>(runEnd - tx);
+            tx = runEnd;
+        }
+    }
+    uploadStats_.totalBytes += uploadStats_.bytesLastFrame;
+}
+
 void PhysarumSimulation::setupDisplaySprite()
 {
     displaySprite_.emplace(displayTexture_);
@@ -1358,17 +1777,17 @@ void PhysarumSimulation::setupDisplaySprite()
 
 void PhysarumSimulation::overlayBuffers()
 {
-    const size_t pixelCount = static_cast<size_t>(settings_.width) * static_cast<size_t>(settings_.height);
+    const size_t pixelCount = static_cast<size_t>(viewWidth_) * static_cast<size_t>(viewHeight_);
     if (pixelCount == 0)
         return;
 
     overlayPixelBuffer_.assign(pixelCount * 4, 0);
 
-    if (agentOverlayTexture_.getSize().x != static_cast<unsigned>(settings_.width) ||
-        agentOverlayTexture_.getSize().y != static_cast<unsigned>(settings_.height))
+    if (agentOverlayTexture_.getSize().x != static_cast<unsigned>(viewWidth_) ||
+        agentOverlayTexture_.getSize().y != static_cast<unsigned>(viewHeight_))
     {
-        agentOverlayTexture_.resize({static_cast<unsigned>(settings_.width),
-                                    static_cast<unsigned>(settings_.height)});
+        agentOverlayTexture_.resize({static_cast<unsigned>(viewWidth_),
+                                    static_cast<unsigned>(viewHeight_)});
         agentOverlayTexture_.setSmooth(true);
     }
     agentOverlaySprite_.emplace(agentOverlayTexture_);
@@ -1378,11 +1797,11 @@ void PhysarumSimulation::overlayBuffers()
 
 void PhysarumSimulation::updateAgentOverlayTexture()
 {
-    if (!showAgentOverlay_)
+    if (!showAgentOverlay_ || !allowOverlay_)
         return;
 
-    const int width = settings_.width;
-    const int height = settings_.height;
+    const int width = viewWidth_;
+    const int height = viewHeight_;
     const size_t bufferSize = static_cast<size_t>(width) * height * 4;
 
     if (overlayPixelBuffer_.size() != bufferSize)
@@ -1391,11 +1810,13 @@ void PhysarumSimulation::updateAgentOverlayTexture()
     // clear to transparent
     std::fill(overlayPixelBuffer_.begin(), overlayPixelBuffer_.end(), 0);
 
-    // render ALL agents - no skipping, no stride
+    // render ALL agents in view - no skipping, no stride (one pixel each, through the camera)
+    const TrailMap::Viewport view = cameraViewport();
+    const float invScale = 1.0f / view.scale;
     for (const Agent &agent : agents_)
     {
-        int x = static_cast<int>(agent.position.x);
-        int y = static_cast<int>(agent.position.y);
+        int x = static_cast<int>(std::floor((agent.position.x - view.originX) * invScale));
+        int y = static_cast<int>(std::floor((agent.position.y - view.originY) * invScale));
         
         if (x < 0 || x >= width || y < 0 || y >= height)
             continue;
@@ -1422,9 +1843,223 @@ void PhysarumSimulation::updateAgentOverlayTexture()
     agentOverlaySprite_->setScale(displaySprite_->getScale());
 }
 
+namespace
+{
+    // spread the low 16 bits of v out to the even bit positions
+    std::uint32_t spreadBits16(std::uint32_t v)
+    {
+        v &= 0x0000ffffu;
+        v = (v | (v << 8)) & 0x00ff00ffu;
+        v = (v | (v << 4)) & 0x0f0f0f0fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    }
+
+    std::uint32_t mortonKey(const sf::Vector2f &position)
+    {
+        const auto x = static_cast<std::uint32_t>(std::clamp(position.x, 0.0f, 65535.0f));
+        const auto y = static_cast<std::uint32_t>(std::clamp(position.y, 0.0f, 65535.0f));
+        return spreadBits16(x) | (spreadBits16(y) << 1);
+    }
+
+    // how often the locality metric is sampled between forced sorts
+    constexpr int AGENT_LOCALITY_CHECK_STEPS = 30;
+    constexpr size_t AGENT_LOCALITY_SAMPLES = 4096;
+
+    // prefetch lookaheads tried by tunePrefetchDistance (0 = no prefetch, the baseline)
+    constexpr int PREFETCH_CANDIDATES[] = {0, 1, 2, 4, 8, 16, 32};
+    constexpr int PREFETCH_TUNE_RUNS = 3;
+    // below this the trail sampling is too quick to time and the prefetch wont matter anyway
+    constexpr size_t PREFETCH_TUNE_MIN_AGENTS = 4096;
+}
+
+int PhysarumSimulation::sensingPrefetchDistance()
+{
+    if (settings_.sensingPrefetchDistance >= 0)
+        return settings_.sensingPrefetchDistance;
+    if (prefetchDistance_ < 0)
+    {
+        if (agents_.size() < PREFETCH_TUNE_MIN_AGENTS)
+            return 0; // try again once there are enough agents to measure
+        prefetchDistance_ = tunePrefetchDistance();
+    }
+    return prefetchDistance_;
+}
+
+int PhysarumSimulation::tunePrefetchDistance() const
+{
+    // times the sensing gather alone (three sensor reads per agent over the real agents and trail,
+    // nothing written) for each lookahead and keeps the fastest. best of a few runs so a context
+    // switch in one run doesnt decide it
+    const bool isMultiSpecies = settings_.speciesSettings.size() > 1;
+    const float *trailData = trailMap_->getData();
+    const size_t count = agents_.size();
+    volatile float sink = 0.0f;
+
+    int best = 0;
+    double bestSeconds = 0.0;
+    double baselineSeconds = 0.0;
+    for (int distance : PREFETCH_CANDIDATES)
+    {
+        double fastest = 0.0;
+        for (int run = 0; run < PREFETCH_TUNE_RUNS; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            float total = 0.0f;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t ahead = i + static_cast<size_t>(distance);
+                if (distance > 0 && ahead < count)
+                {
+                    if (isMultiSpecies)
+                        agents_[ahead].prefetchSensors(*trailMap_, settings_);
+                    else
+                        agents_[ahead].prefetchSensors(trailData, settings_.width, settings_.height, settings_);
+                }
+                const Agent &agent = agents_[i];
+                for (const sf::Vector2f &p : agent.sensorPositions(settings_))
+                {
+                    const int x = static_cast<int>(p.x);
+                    const int y = static_cast<int>(p.y);
+                    if (isMultiSpecies)
+                        total += trailMap_->sampleSpeciesInteraction(x, y, agent.speciesIndex, 1.0f, -1.0f);
+                    else if (x >= 0 && x < settings_.width && y >= 0 && y < settings_.height)
+                        total += trailData[y * settings_.width + x];
+                }
+            }
+            sink = sink + total;
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            fastest = (run == 0) ? seconds : std::min(fastest, seconds);
+        }
+        if (distance == 0)
+            baselineSeconds = fastest;
+        if (distance == 0 || fastest < bestSeconds)
+        {
+            best = distance;
+            bestSeconds = fastest;
+        }
+    }
+
+    std::cout << "Sensing prefetch: lookahead " << best << " agents (" << std::fixed << std::setprecision(2)
+              << baselineSeconds * 1000.0 << "ms -> " << bestSeconds * 1000.0 << "ms per gather over "
+              << count << " agents)" << std::defaultfloat << std::endl;
+    return best;
+}
+
+float PhysarumSimulation::agentLocalityJump() const
+{
+    if (agents_.size() < 2)
+        return 0.0f;
+    // sampled pairs (i, i + 1) spread over the whole vector, births at the end get their share
+    const size_t pairs = agents_.size() - 1;
+    const size_t samples = std::min(pairs, AGENT_LOCALITY_SAMPLES);
+    double total = 0.0;
+    for (size_t s = 0; s < samples; ++s)
+    {
+        const size_t i = s * pairs / samples;
+        const sf::Vector2f d = agents_[i + 1].position - agents_[i].position;
+        total += std::abs(d.x) + std::abs(d.y);
+    }
+    return static_cast<float>(total / samples);
+}
+
+bool PhysarumSimulation::agentSortDue()
+{
+    if (settings_.agentSortInterval <= 0 || agents_.size() < 2)
+        return false;
+
+    ++stepsSinceAgentSort_;
+    if (stepsSinceAgentSort_ >= settings_.agentSortInterval)
+        return true;
+    // births land at the end and agents drift, sort early once the order has clearly decayed
+    if (sortedJumpBaseline_ > 0.0f && stepsSinceAgentSort_ % AGENT_LOCALITY_CHECK_STEPS == 0)
+        return agentLocalityJump() > sortedJumpBaseline_ * settings_.agentSortDegradeFactor;
+    return false;
+}
+
+std::future<void> PhysarumSimulation::startAgentSort()
+{
+    if (!agentSortDue())
+        return {};
+
+    // only reads agent positions, the trail update running meanwhile never touches agents_
+    return std::async(std::launch::async, [this]
+                      {
+        const size_t count = agents_.size();
+        agentSortKeys_.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            agentSortKeys_[i] = (static_cast<std::uint64_t>(mortonKey(agents_[i].position)) << 32) | i;
+        }
+        // the slot in the low bits keeps equal keys in their current order (stable)
+        std::sort(agentSortKeys_.begin(), agentSortKeys_.end());
+        agentSortOrder_.resize(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            agentSortOrder_[i] = static_cast<std::uint32_t>(agentSortKeys_[i] & 0xffffffffu);
+        } });
+}
+
+void PhysarumSimulation::finishAgentSort(std::future<void> &job)
+{
+    if (!job.valid())
+        return;
+    job.get();
+    stepsSinceAgentSort_ = 0;
+
+    const size_t count = agentSortOrder_.size();
+    if (count != agents_.size())
+        return;
+
+    // the per agent behavior maps are keyed by address, move their entries along first
+    Agent::permuteSharedBehaviorState(agents_.data(), count, agentSortOrder_);
+
+    // apply the permutation in place one cycle at a time (one temporary per cycle, moves only)
+    std::vector<std::uint32_t> &order = agentSortOrder_;
+    for (size_t start = 0; start < count; ++start)
+    {
+        if (order[start] == start)
+            continue;
+        Agent carried = std::move(agents_[start]);
+        size_t slot = start;
+        while (true)
+        {
+            const size_t source = order[slot];
+            order[slot] = static_cast<std::uint32_t>(slot); // mark done
+            if (source == start)
+            {
+                agents_[slot] = std::move(carried);
+                break;
+            }
+            agents_[slot] = std::move(agents_[source]);
+            slot = source;
+        }
+    }
+
+    // anything holding agent indices has to see the new order before it is read again
+    if (spatialGrid_)
+        spatialGrid_->rebuild(agents_);
+    sortedJumpBaseline_ = std::max(1e-3f, agentLocalityJump());
+}
+
+size_t PhysarumSimulation::populationCap() const
+{
+    const size_t countCap = static_cast<size_t>(std::max(0, settings_.numAgents) * 2);
+    if (MemoryTracker::budget() == 0 || agents_.empty())
+        return countCap;
+
+    // what one more agent costs: the agents tag per agent (its slot, spare capacity and its path).
+    // only half of what the headroom buys, agents_ needs room to double its capacity on the way there
+    const size_t perAgent = std::max(sizeof(Agent), MemoryTracker::live(MemoryTag::Agents) / agents_.size());
+    const size_t affordable = MemoryTracker::headroom() / perAgent / 2;
+    return std::min(countCap, agents_.size() + affordable);
+}
+
 void PhysarumSimulation::validateSettings()
 {
     settings_.validateAndClamp();
+    MemoryTracker::setBudget(static_cast<size_t>(settings_.memoryBudgetMB) * 1024 * 1024);
 }
 
 void PhysarumSimulation::updateAgentsOptimized()
@@ -1506,7 +2141,7 @@ void PhysarumSimulation::updateAgentsOptimized()
 
     // handle deaths and spore bursts (optimized path)
     {
-        std::vector<size_t> toRemove;
+        FrameVector<size_t> toRemove;
         toRemove.reserve(64);
         for (size_t i = 0; i < agents_.size(); ++i)
         {
@@ -1532,7 +2167,9 @@ void PhysarumSimulation::updateAgentsOptimized()
                     return std::clamp(parentVal * (1.0f + delta), 0.5f, 1.5f);
                 };
                 
-                for (int s = 0; s < std::max(0, sp.sporeCount); ++s)
+                // spore bursts were never count capped, only a memory budget limits them
+                const size_t sporeCap = MemoryTracker::budget() > 0 ? populationCap() : SIZE_MAX;
+                for (int s = 0; s < std::max(0, sp.sporeCount) && agents_.size() < sporeCap; ++s)
                 {
                     float ang = 2.0f * 3.14159265f * (std::rand() / (float)RAND_MAX);
                     float r = sp.sporeRadius * (std::rand() / (float)RAND_MAX);
@@ -1579,7 +2216,9 @@ void PhysarumSimulation::updateAgentsOptimized()
     }
 
     // reproduction pass (optimized path): spatial, capped
-    const size_t maxOffspring = std::min<size_t>(agents_.size() / 50 + 1, 2000);
+    // like the spore bursts: only a memory budget caps this path, it never had a count cap
+    const size_t popCap = MemoryTracker::budget() > 0 ? populationCap() : SIZE_MAX;
+    const size_t maxOffspring = std::min<size_t>({agents_.size() / 50 + 1, 2000, popCap > agents_.size() ? popCap - agents_.size() : 0});
     size_t born = 0;
     // use grid for partner search
     for (size_t i = 0; i < agents_.size() && born < maxOffspring; ++i)
@@ -1648,9 +2287,8 @@ void PhysarumSimulation::updateTrailsOptimized()
         optimizedTrailMap_->decayOptimized(settings_.decayRate);
     }
 
-    // apply blur only every few frames to reduce performance impact
-    static int blurCounter = 0;
-    if (settings_.blurEnabled && (++blurCounter % 2 == 0))
+    // apply blur only every few frames to reduce performance impact (cadence set by the frame budget)
+    if (settings_.blurEnabled && (++blurCounter_ % blurInterval_ == 0))
     {
         optimizedTrailMap_->applyBlurOptimized();
     }
@@ -1676,6 +2314,9 @@ void PhysarumSimulation::enterBenchmarkMode() {
     slimeGoalFound_ = false;
     slimeGoalX_ = 0.0f;
     slimeGoalY_ = 0.0f;
+
+    // the lanes span the whole world, start with all of it in view
+    resetCamera();
     
     std::cout << "Setting up benchmark mode [V7]..." << std::endl;
     std::cout << "  Window: " << settings_.width << "x" << settings_.height << std::endl;
@@ -1715,10 +2356,16 @@ void PhysarumSimulation::enterBenchmarkMode() {
         settings_.speciesSettings.push_back(species);
     }
     
+    // the benchmark step runs its agent batches on the pool even when the optimized
+    // systems are off (benchmark agents dont touch the spatial grid or the simd trail map)
+    parallelPool();
+    benchmarkStepCounts_ = BenchmarkStepCounts{};
+
     // setup for benchmark manager with current dimensions and larger cell size for faster pathfinding
     benchmarkManager_.getPathfinder().setCellSize(settings_.benchmarkSettings.pathCellSize);
     benchmarkManager_.setupBenchmark(settings_.width, settings_.height, 
                            settings_.benchmarkSettings.agentsPerAlgorithm);
+    benchmarkManager_.setEventLogEnabled(settings_.benchmarkSettings.eventLog);
     
     std::cout << "  Goal at world: (" << benchmarkManager_.getGoalX() << ", " << benchmarkManager_.getGoalY() << ")" << std::endl;
     std::cout << "  Goal cell: (" << benchmarkManager_.getGoalCell().x << ", " << benchmarkManager_.getGoalCell().y << ")" << std::endl;
@@ -1842,6 +2489,7 @@ void PhysarumSimulation::enterBenchmarkMode() {
                     }
                 }
                 
+                benchmarkManager_.recordPathComputed(agent.speciesIndex, agent.agentId, pathResult, it != pathCache.end());
                 if (pathResult.found) {
                     agent.setPath(pathResult.path, algo);
                     totalPathsFound++;
@@ -1892,6 +2540,9 @@ void PhysarumSimulation::enterBenchmarkMode() {
                   << "hasPath=" << a.hasPath << " pathLen=" << a.currentPath.size() << std::endl;
     }
     
+    // agent ids double as the dense slot into the arrival bitsets
+    benchmarkManager_.reserveArrivalSlots(agentId);
+
     // update species settings for display colors
     settings_.speciesSettings.clear();
     for (size_t i = 0; i < algorithms.size(); i++) {
@@ -1919,12 +2570,70 @@ void PhysarumSimulation::exitBenchmarkMode() {
     std::cout << "Exited Algorithm Benchmark Mode" << std::endl;
 }
 
+namespace
+{
+    // (species, agent id) of every agent lined up for the race
+    std::vector<std::pair<int, int>> raceAgentKeys(const AgentVector &agents)
+    {
+        std::vector<std::pair<int, int>> keys;
+        keys.reserve(agents.size());
+        for (const Agent &agent : agents)
+            keys.emplace_back(agent.speciesIndex, agent.agentId);
+        return keys;
+    }
+}
+
 void PhysarumSimulation::startBenchmark() {
     if (!inBenchmarkMode_) return;
+    if (!benchmarkManager_.isBenchmarkActive())
+        benchmarkManager_.keepPendingPaths(raceAgentKeys(agents_));
     benchmarkManager_.startBenchmark();
     std::cout << "Benchmark started!" << std::endl;
 }
 
+void PhysarumSimulation::stepBenchmarkTick(int diffusionThreads) {
+    updateBenchmark(settings_.benchmarkSettings.raceTickSeconds);
+
+    // Update trails for visualization (benchmark agents are clamped to the world, so is the diffusion).
+    // every race tick, slimes sense the trail so skipping some would change the race
+    if (settings_.implicitDiffusion)
+        trailMap_->diffuseImplicit(settings_.diffuseRate, 1, false, diffusionThreads);
+    else
+        trailMap_->diffuse(settings_.diffuseRate);
+    trailMap_->decay(settings_.decayRate);
+
+    fieldRecorder_.onSteps(*trailMap_, 1);
+}
+
+int PhysarumSimulation::runBenchmarkHeadless(int maxTicks) {
+    if (!inBenchmarkMode_) return 0;
+    if (!benchmarkManager_.isBenchmarkActive()) {
+        benchmarkManager_.keepPendingPaths(raceAgentKeys(agents_));
+        benchmarkManager_.startBenchmark();
+    }
+    if (benchmarkManager_.isPaused()) benchmarkManager_.resumeBenchmark();
+
+    ParallelProcessor *pool = parallelPool();
+    const int diffusionThreads = pool ? static_cast<int>(pool->getThreadCount()) : 1;
+    auto wallStart = std::chrono::high_resolution_clock::now();
+
+    int ticks = 0;
+    while (ticks < maxTicks && !benchmarkManager_.isBenchmarkComplete()) {
+        // every tick is a frame as far as the arena goes, or the worker blocks pile up for the whole race
+        FrameArena::beginFrame();
+        stepBenchmarkTick(diffusionThreads);
+        ticks++;
+    }
+    benchmarkManager_.flushArrivals();
+
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - wallStart).count();
+    const double raceMs = benchmarkManager_.getBenchmarkElapsedMs();
+    std::cout << "[BENCHMARK] headless: " << ticks << " ticks, race time " << raceMs / 1000.0 << "s in "
+              << wallMs / 1000.0 << "s wall (" << (wallMs > 0.0 ? raceMs / wallMs : 0.0) << "x real time)"
+              << (benchmarkManager_.isBenchmarkComplete() ? "" : ", stopped before every algorithm finished") << std::endl;
+    return ticks;
+}
+
 void PhysarumSimulation::pauseBenchmark() {
     if (!inBenchmarkMode_) return;
     
@@ -2030,6 +2739,7 @@ void PhysarumSimulation::toggleBenchmarkPackPositions() {
                 static_cast<int>(std::clamp(agent.benchmarkSpawnPosition.x, 0.0f, static_cast<float>(settings_.width - 1))),
                 static_cast<int>(std::clamp(agent.benchmarkSpawnPosition.y, 0.0f, static_cast<float>(settings_.height - 1))));
             PathResult pathResult = pathfinder.findPath(agent.assignedAlgo, startCell, goalCell);
+            benchmarkManager_.recordPathComputed(agent.speciesIndex, agent.agentId, pathResult, false);
             if (pathResult.found) {
                 agent.setPath(pathResult.path, agent.assignedAlgo);
             } else {
@@ -2151,6 +2861,7 @@ void PhysarumSimulation::adjustBenchmarkAgentCount(int delta) {
                 }
                 else if (!isSlime) {
                     PathResult pathResult = benchmarkManager_.getPathfinder().findPath(algo, start, goal);
+                    benchmarkManager_.recordPathComputed(agent.speciesIndex, agent.agentId, pathResult, false);
                     if (pathResult.found) {
                         agent.setPath(pathResult.path, algo);
                     }
@@ -2160,11 +2871,12 @@ void PhysarumSimulation::adjustBenchmarkAgentCount(int delta) {
                 added++;
             }
         }
+        benchmarkManager_.reserveArrivalSlots(agentId);
         std::cout << "Added " << added << " agents (" << newPerAlgo << " per algo, " 
                   << agents_.size() << " total)" << std::endl;
     }
     else {
-        std::vector<Agent> newAgents;
+        AgentVector newAgents;
         std::vector<int> keptPerAlgo(numAlgos, 0);
         
         for (const Agent& agent : agents_) {
@@ -2275,6 +2987,7 @@ void PhysarumSimulation::toggleBenchmarkAlgorithm(int algoIndex) {
                 int startY = static_cast<int>(std::clamp(activeSpawn.y, 0.0f, static_cast<float>(settings_.height - 1)));
                 GridCell start = benchmarkManager_.getPathfinder().worldToGrid(startX, startY);
                 PathResult pathResult = benchmarkManager_.getPathfinder().findPath(algo, start, goal);
+                benchmarkManager_.recordPathComputed(agent.speciesIndex, agent.agentId, pathResult, false);
                 if (pathResult.found) {
                     agent.setPath(pathResult.path, algo);
                 }
@@ -2282,6 +2995,7 @@ void PhysarumSimulation::toggleBenchmarkAlgorithm(int algoIndex) {
             
             agents_.push_back(agent);
         }
+        benchmarkManager_.reserveArrivalSlots(agentId);
         std::cout << "[BENCH] Enabled " << algoName << " (" << perAlgo << " agents)" << std::endl;
     }
     
@@ -2289,6 +3003,22 @@ void PhysarumSimulation::toggleBenchmarkAlgorithm(int algoIndex) {
     benchmarkManager_.setAlgorithmEnabled(algoIndex, benchmarkAlgorithmEnabled_[algoIndex]);
 }
 
+namespace
+{
+    // what a benchmark agent did during the parallel step, read back by the serial merge
+    enum BenchmarkStepFlag : std::uint8_t
+    {
+        STEP_EXPLORER = 1 << 0,
+        STEP_PATHFINDER = 1 << 1,
+        STEP_SLIME = 1 << 2,
+        STEP_NO_PATH = 1 << 3,
+        STEP_ALREADY_ARRIVED = 1 << 4,
+        STEP_ARRIVED = 1 << 5,       // reached the goal this step
+        STEP_DEPOSIT = 1 << 6,       // regular 7x7 benchmark deposit
+        STEP_SLIME_DEPOSIT = 1 << 7  // slime 5x5 energy scaled deposit
+    };
+}
+
 void PhysarumSimulation::updateBenchmark(float deltaTime) {
     if (!inBenchmarkMode_) return;
     
@@ -2301,231 +3031,224 @@ void PhysarumSimulation::updateBenchmark(float deltaTime) {
     benchmarkManager_.update(deltaTime);
     
     // agents following its path
-    Pathfinder& pathfinder = benchmarkManager_.getPathfinder();
-    float goalRadius = settings_.benchmarkSettings.goalArrivalRadius;
-    float moveSpeed = settings_.benchmarkSettings.agentMoveSpeed;
+    const Pathfinder& pathfinder = benchmarkManager_.getPathfinder();
+    const float goalRadius = settings_.benchmarkSettings.goalArrivalRadius;
+    const float moveSpeed = settings_.benchmarkSettings.agentMoveSpeed;
+    const float trailWeight = settings_.trailWeight;
     constexpr int SLIME_RESPAWN_DELAY_FRAMES = 90;
     
-    //  depositing food at goal location
-    // this allows slime agents to sense the goal via trail concentration
-    // instead of knowing goal coordinates (which is authentic Physarum behavior)
-    // MUST be MUCH stronger than slime self trails to create a gradient
-    // that pulls slimes out of their local "scent bubble"
-    int goalX = static_cast<int>(benchmarkManager_.getGoalX());
-    int goalY = static_cast<int>(benchmarkManager_.getGoalY());
-    const float GOAL_FOOD_STRENGTH = 500.0f;  // strong beacon for slime sensing
-    const int GOAL_FOOD_RADIUS = 200;         // and extra wide radius for long range detection
-    
     // deposit food to a hidden channel (7) - not rendered but sensed by slimes
     // this way goal food doesnt create a visible glow that overwhelms trail visibility
-    const int goalFoodChannel = std::max(0, trailMap_->getNumSpecies() - 1);
-    
-    for (int dx = -GOAL_FOOD_RADIUS; dx <= GOAL_FOOD_RADIUS; ++dx) {
-        for (int dy = -GOAL_FOOD_RADIUS; dy <= GOAL_FOOD_RADIUS; ++dy) {
-            float dist = std::sqrt(static_cast<float>(dx * dx + dy * dy));
-            if (dist <= GOAL_FOOD_RADIUS) {
-                int px = goalX + dx;
-                int py = goalY + dy;
-                if (px >= 0 && px < settings_.width && py >= 0 && py < settings_.height) {
-                    float falloff = 1.0f - (dist / GOAL_FOOD_RADIUS);
-                    trailMap_->deposit(px, py, GOAL_FOOD_STRENGTH * falloff, goalFoodChannel);
-                }
-            }
-        }
-    }
-    
-    static int debugCounter = 0;
-    static int frameCounter = 0;
-    frameCounter++;
-
-    //goal field instrumentation accumulators (experiment 1) 
-    constexpr float SPAWN_GOAL_SAMPLE_MAX_X = 160.0f;
-    float frameSpawnGoalSum = 0.0f;
-    int frameSpawnGoalSamples = 0;
-    float frameFrontGoalValue = 0.0f;
-    float frameFrontMostX = -1.0f;
-    static float spawnGoalRunningSum = 0.0f;
-    static int spawnGoalRunningFrames = 0;
-    static float frontGoalRunningSum = 0.0f;
-    static int frontGoalRunningFrames = 0;
-    static int goalFieldPrintCounter = 0;
-    
-    int movedCount = 0;
-    int arrivedCount = 0;
-    int noPathCount = 0;
-    int slimeCount = 0;
-    int explorerCount = 0;
-    
-    // debugging: count slimes in agents
-    static int debugFrame = 0;
-    if (++debugFrame % 120 == 0) {
-        int totalSlimes = 0;
-        int slimesExploring = 0;
-        int slimesReached = 0;
-        for (const auto& a : agents_) {
-            if (a.assignedAlgo == SimulationSettings::Algos::Slime) {
-                totalSlimes++;
-                if (a.isExploring) slimesExploring++;
-                if (a.reachedGoal) slimesReached++;
-            }
-        }
-        std::cout << "[SLIME CENSUS] Total=" << totalSlimes 
-                  << " isExploring=" << slimesExploring 
-                  << " reachedGoal=" << slimesReached << std::endl;
-    }
-    
-    int agentIndex = 0;
-    for (Agent& agent : agents_) {
-        int i = agentIndex++;  // track agent index for rate limiting
-        if (agent.reachedGoal) {
-            arrivedCount++;
-            continue;
-        }
-        
-        if (agent.isExploring) {
-            explorerCount++;
-            
-            GridCell goalCell = benchmarkManager_.getGoalCell();
-            
-            bool found = false;
-            if (agent.assignedAlgo == SimulationSettings::Algos::Dijkstra) {
-                found = agent.exploreStepDijkstra(pathfinder, goalCell, moveSpeed);
-            } else {
-                found = agent.exploreStep(pathfinder, goalCell, moveSpeed, nullptr);
-            }
-            
-            if (found) {
-                agent.reachedGoal = true;
-                benchmarkManager_.recordArrival(agent.speciesIndex, agent.agentId);
-            }
-            
-            agent.depositBenchmark(*trailMap_, settings_.trailWeight);
-            continue;
-        }
-        
-        if (agent.assignedAlgo == SimulationSettings::Algos::Slime) {
-            slimeCount++;
+    const int numChannels = trailMap_->getNumSpecies();
+    const int goalFoodChannel = std::max(0, numChannels - 1);
+    stampBenchmarkGoalFood(static_cast<int>(benchmarkManager_.getGoalX()),
+                           static_cast<int>(benchmarkManager_.getGoalY()),
+                           goalFoodChannel);
+
+    const GridCell goalCell = benchmarkManager_.getGoalCell();
+    const float goalWorldX = benchmarkManager_.getGoalX();
+    const float goalWorldY = benchmarkManager_.getGoalY();
+    const double elapsedMs = benchmarkManager_.getBenchmarkElapsedMs();
+
+    // scratch is only resized when the population changes (clear() keeps capacity)
+    const size_t agentCount = agents_.size();
+    benchmarkStepFlags_.resize(agentCount);
+    benchmarkSlimeDeposit_.resize(agentCount);
+    benchmarkChannelBatches_.resize(numChannels);
+    for (auto& batch : benchmarkChannelBatches_) {
+        batch.clear();
+    }
+
+    // PHASE 1: step every agent. each agent only touches its own state and only READS the
+    // trail map (no deposits yet) so chunks of agents are fully independent:
+    //  - path followers just walk their precomputed path
+    //  - explorers run on their own private frontier/visited sets
+    //  - slimes sense last frames trail and stage their deposit strength
+    auto stepRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            Agent& agent = agents_[i];
+            std::uint8_t flags = 0;
 
-            static int slimeCodePathCounter = 0;
-            if (++slimeCodePathCounter % 300 == 0) {
-                std::cout << "[SLIME CODE PATH] " << slimeCodePathCounter 
-                          << " slime updates executed" << std::endl;
+            if (agent.reachedGoal) {
+                benchmarkStepFlags_[i] = STEP_ALREADY_ARRIVED;
+                continue;
             }
 
             if (agent.isExploring) {
-                static bool warned = false;
-                if (!warned) {
-                    std::cout << "[WARNING] Slime agent " << agent.agentId << " has isExploring=true!" << std::endl;
-                    warned = true;
+                flags |= STEP_EXPLORER;
+                const GridCell previousCell = agent.currentCell;
+                bool found = (agent.assignedAlgo == SimulationSettings::Algos::Dijkstra)
+                    ? agent.exploreStepDijkstra(pathfinder, goalCell, moveSpeed)
+                    : agent.exploreStep(pathfinder, goalCell, moveSpeed, nullptr);
+                if (agent.currentCell != previousCell) {
+                    benchmarkManager_.recordExplorationStep(agent.speciesIndex, agent.agentId, agent.currentCell,
+                                                            static_cast<int>(agent.visitedCells.size()));
                 }
+                if (found) {
+                    agent.reachedGoal = true;
+                    flags |= STEP_ARRIVED;
+                    benchmarkManager_.recordArrival(agent.speciesIndex, agent.agentId);
+                }
+                benchmarkStepFlags_[i] = flags | STEP_DEPOSIT;
+                continue;
             }
 
-            if (!agent.benchmarkAlive) {
-                if (agent.benchmarkRespawnFrames > 0) {
-                    agent.benchmarkRespawnFrames--;
+            if (agent.assignedAlgo == SimulationSettings::Algos::Slime) {
+                flags |= STEP_SLIME;
+
+                if (!agent.benchmarkAlive) {
+                    if (agent.benchmarkRespawnFrames > 0) {
+                        agent.benchmarkRespawnFrames--;
+                    }
+                    if (agent.benchmarkRespawnFrames <= 0) {
+                        respawnBenchmarkSlime(agent);
+                    }
+                    benchmarkStepFlags_[i] = flags;
+                    continue;
+                }
+
+                // deposit strength is decided from the signal memory BEFORE the step
+                float depositMultiplier = (elapsedMs < 5000.0) ? 0.25f : 1.0f;
+                if (agent.benchmarkSignalMemory < 0.015f) {
+                    depositMultiplier *= 0.5f;
+                }
+
+                bool alive = agent.benchmarkSlimeStep(
+                    *trailMap_, pathfinder, settings_,
+                    goalWorldX, goalWorldY,
+                    goalFoodChannel
+                );
+
+                if (!alive) {
+                    agent.benchmarkAlive = false;
+                    agent.benchmarkRespawnFrames = SLIME_RESPAWN_DELAY_FRAMES;
+                    benchmarkStepFlags_[i] = flags;
+                    continue;
                 }
-                if (agent.benchmarkRespawnFrames <= 0) {
-                    respawnBenchmarkSlime(agent);
+
+                benchmarkSlimeDeposit_[i] = 2.0f * depositMultiplier;
+                flags |= STEP_SLIME_DEPOSIT;
+
+                float dx = goalWorldX - agent.position.x;
+                float dy = goalWorldY - agent.position.y;
+                if (dx * dx + dy * dy < goalRadius * goalRadius) {
+                    agent.reachedGoal = true;
+                    flags |= STEP_ARRIVED;
+                    benchmarkManager_.recordArrival(agent.speciesIndex, agent.agentId);
                 }
+                benchmarkStepFlags_[i] = flags;
                 continue;
             }
 
-            double elapsedMs = benchmarkManager_.getBenchmarkElapsedMs();
-            float depositMultiplier = (elapsedMs < 5000.0) ? 0.25f : 1.0f;
-            if (agent.benchmarkSignalMemory < 0.015f) {
-                depositMultiplier *= 0.5f;
-            }
-            float slimeTrailStrength = 2.0f * depositMultiplier;
-            float goalWorldX = benchmarkManager_.getGoalX();
-            float goalWorldY = benchmarkManager_.getGoalY();
-
-            bool alive = agent.benchmarkSlimeStep(
-                *trailMap_, pathfinder, settings_,
-                slimeTrailStrength,
-                goalWorldX, goalWorldY,
-                goalFoodChannel
-            );
-
-            if (!alive) {
-                agent.benchmarkAlive = false;
-                agent.benchmarkRespawnFrames = SLIME_RESPAWN_DELAY_FRAMES;
+            if (!agent.hasPath || agent.currentPath.empty()) {
+                benchmarkStepFlags_[i] = STEP_NO_PATH;
                 continue;
             }
 
-            int sampleX = std::clamp(static_cast<int>(agent.position.x), 0, settings_.width - 1);
-            int sampleY = std::clamp(static_cast<int>(agent.position.y), 0, settings_.height - 1);
-            float goalSense = trailMap_->sample(sampleX, sampleY, goalFoodChannel);
-            if (agent.position.x < SPAWN_GOAL_SAMPLE_MAX_X) {
-                frameSpawnGoalSum += goalSense;
-                frameSpawnGoalSamples++;
-            }
-            if (agent.position.x > frameFrontMostX) {
-                frameFrontMostX = agent.position.x;
-                frameFrontGoalValue = goalSense;
+            flags |= STEP_PATHFINDER | STEP_DEPOSIT;
+            if (agent.followPath(pathfinder, moveSpeed, goalRadius)) {
+                agent.reachedGoal = true;
+                flags |= STEP_ARRIVED;
+                benchmarkManager_.recordArrival(agent.speciesIndex, agent.agentId);
             }
+            benchmarkStepFlags_[i] = flags;
+        }
+    };
 
-            float dx = goalWorldX - agent.position.x;
-            float dy = goalWorldY - agent.position.y;
-            float distToGoal = std::sqrt(dx * dx + dy * dy);
+    if (parallelProcessor_) {
+        parallelProcessor_->processRangeParallel(agentCount, stepRange);
+    } else {
+        stepRange(0, agentCount);
+    }
 
-            if (distToGoal < goalRadius) {
-                std::cout << "[SLIME ARRIVED] Agent " << agent.agentId 
-                          << " reached goal! Reinforcing path with 500 strength to ch2" << std::endl;
-                agent.reinforceRecentPath(*trailMap_, 500.0f);
+    // group depositing agents by channel. every algorithm owns its own channel so
+    // the batches below write disjoint memory and can be stamped concurrently
+    for (size_t i = 0; i < agentCount; ++i) {
+        if (benchmarkStepFlags_[i] & (STEP_DEPOSIT | STEP_SLIME_DEPOSIT)) {
+            int channel = std::clamp(agents_[i].speciesIndex, 0, numChannels - 1);
+            benchmarkChannelBatches_[channel].push_back(i);
+        }
+    }
 
-                agent.reachedGoal = true;
-                benchmarkManager_.recordArrival(agent.speciesIndex, agent.agentId);
+    // PHASE 2: staged deposits, one task per channel
+    auto depositChannels = [&](size_t begin, size_t end) {
+        for (size_t channel = begin; channel < end; ++channel) {
+            for (size_t i : benchmarkChannelBatches_[channel]) {
+                if (benchmarkStepFlags_[i] & STEP_SLIME_DEPOSIT) {
+                    agents_[i].depositBenchmarkSlime(*trailMap_, benchmarkSlimeDeposit_[i]);
+                } else {
+                    agents_[i].depositBenchmark(*trailMap_, trailWeight);
+                }
             }
-
-            continue;
         }
-        
-        if (!agent.hasPath || agent.currentPath.empty()) {
-            noPathCount++;
-            continue;
+    };
+
+    if (parallelProcessor_) {
+        parallelProcessor_->processRangeParallel(benchmarkChannelBatches_.size(), depositChannels);
+    } else {
+        depositChannels(0, benchmarkChannelBatches_.size());
+    }
+
+    // PHASE 3: serial merge. arrivals were already recorded lock free by the workers,
+    // here we only do the trail writes they couldnt and publish the stats for the HUD
+    BenchmarkStepCounts counts;
+    for (size_t i = 0; i < agentCount; ++i) {
+        std::uint8_t flags = benchmarkStepFlags_[i];
+        if (flags & STEP_ALREADY_ARRIVED) counts.arrived++;
+        if (flags & STEP_EXPLORER) counts.explorers++;
+        if (flags & STEP_PATHFINDER) counts.pathfinders++;
+        if (flags & STEP_SLIME) counts.slimes++;
+        if (flags & STEP_NO_PATH) counts.noPath++;
+
+        if ((flags & STEP_ARRIVED) && (flags & STEP_SLIME)) {
+            // successful slime lays a highway back along its remembered path
+            agents_[i].reinforceRecentPath(*trailMap_, 500.0f);
         }
-        
-        bool arrived = agent.followPath(pathfinder, moveSpeed, goalRadius);
-        movedCount++;
-        
-        if (arrived) {
-            agent.reachedGoal = true;
-            benchmarkManager_.recordArrival(agent.speciesIndex, agent.agentId);
+    }
+    benchmarkStepCounts_ = counts;
+    benchmarkManager_.flushArrivals();
+}
+
+// goal food beacon: MUST be MUCH stronger than slime self trails to create a gradient
+// that pulls slimes out of their local "scent bubble". the falloff disk is computed once
+// and rows are stamped in parallel (they never overlap)
+void PhysarumSimulation::stampBenchmarkGoalFood(int goalX, int goalY, int goalFoodChannel) {
+    const float GOAL_FOOD_STRENGTH = 500.0f;  // strong beacon for slime sensing
+    const int GOAL_FOOD_RADIUS = 200;         // and extra wide radius for long range detection
+    const int diameter = GOAL_FOOD_RADIUS * 2 + 1;
+
+    if (benchmarkGoalStamp_.size() != static_cast<size_t>(diameter * diameter)) {
+        benchmarkGoalStamp_.assign(diameter * diameter, 0.0f);
+        for (int dy = -GOAL_FOOD_RADIUS; dy <= GOAL_FOOD_RADIUS; ++dy) {
+            for (int dx = -GOAL_FOOD_RADIUS; dx <= GOAL_FOOD_RADIUS; ++dx) {
+                float dist = std::sqrt(static_cast<float>(dx * dx + dy * dy));
+                if (dist <= GOAL_FOOD_RADIUS) {
+                    float falloff = 1.0f - (dist / GOAL_FOOD_RADIUS);
+                    benchmarkGoalStamp_[(dy + GOAL_FOOD_RADIUS) * diameter + (dx + GOAL_FOOD_RADIUS)] =
+                        GOAL_FOOD_STRENGTH * falloff;
+                }
+            }
         }
-        
-        agent.depositBenchmark(*trailMap_, settings_.trailWeight);
     }
-    
-    if (frameSpawnGoalSamples > 0) {
-        spawnGoalRunningSum += frameSpawnGoalSum / static_cast<float>(frameSpawnGoalSamples);
-        spawnGoalRunningFrames++;
-    }
-    if (frameFrontMostX >= 0.0f) {
-        frontGoalRunningSum += frameFrontGoalValue;
-        frontGoalRunningFrames++;
-    }
-    goalFieldPrintCounter++;
-    if (goalFieldPrintCounter >= 120) {
-        float avgSpawn = (spawnGoalRunningFrames > 0) ?
-            (spawnGoalRunningSum / static_cast<float>(spawnGoalRunningFrames)) : 0.0f;
-        float avgFront = (frontGoalRunningFrames > 0) ?
-            (frontGoalRunningSum / static_cast<float>(frontGoalRunningFrames)) : 0.0f;
-        std::cout << "[GoalField] spawnAvg=" << avgSpawn
-                  << " frontAvg=" << avgFront << std::endl;
-        spawnGoalRunningSum = 0.0f;
-        spawnGoalRunningFrames = 0;
-        frontGoalRunningSum = 0.0f;
-        frontGoalRunningFrames = 0;
-        goalFieldPrintCounter = 0;
-    }
-
-    debugCounter++;
-    if (debugCounter % 60 == 0) {
-        std::cout << "Benchmark: explorers=" << explorerCount
-                  << " pathfinders=" << movedCount 
-                  << " slime=" << slimeCount
-                  << " arrived=" << arrivedCount 
-                  << " noPath=" << noPathCount << std::endl;
+
+    auto stampRows = [&](size_t begin, size_t end) {
+        for (size_t row = begin; row < end; ++row) {
+            int py = goalY + static_cast<int>(row) - GOAL_FOOD_RADIUS;
+            if (py < 0 || py >= settings_.height) continue;
+            const float* stampRow = &benchmarkGoalStamp_[row * diameter];
+            for (int col = 0; col < diameter; ++col) {
+                int px = goalX + col - GOAL_FOOD_RADIUS;
+                if (px >= 0 && px < settings_.width && stampRow[col] > 0.0f) {
+                    trailMap_->deposit(px, py, stampRow[col], goalFoodChannel);
+                }
+            }
+        }
+    };
+
+    if (parallelProcessor_) {
+        parallelProcessor_->processRangeParallel(diameter, stampRows);
+    } else {
+        stampRows(0, diameter);
     }
 }
 
@@ -2552,4 +3275,7 @@ void PhysarumSimulation::respawnBenchmarkSlime(Agent &agent) {
     agent.pathMemoryCount = 0;
     agent.pathMemoryIndex = 0;
     agent.reachedGoal = false;
+
+    benchmarkManager_.recordRespawn(agent.speciesIndex, agent.agentId,
+        benchmarkManager_.getPathfinder().worldToGrid(static_cast<int>(spawn.x), static_cast<int>(spawn.y)));
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "RetainedHud.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // same quad sf::Text builds for a glyph (two triangles, 1px padding around the glyph)
+    void appendGlyphQuad(std::vector<sf::Vertex> &vertices, sf::Vector2f pen, sf::Color color, const sf::Glyph &glyph)
+    {
+        const sf::Vector2f padding(1.0f, 1.0f);
+        const sf::Vector2f p1 = glyph.bounds.position - padding;
+        const sf::Vector2f p2 = glyph.bounds.position + glyph.bounds.size + padding;
+        const sf::Vector2f uv1 = sf::Vector2f(glyph.textureRect.position) - padding;
+        const sf::Vector2f uv2 = sf::Vector2f(glyph.textureRect.position + glyph.textureRect.size) + padding;
+
+        vertices.push_back({pen + sf::Vector2f(p1.x, p1.y), color, {uv1.x, uv1.y}});
+        vertices.push_back({pen + sf::Vector2f(p2.x, p1.y), color, {uv2.x, uv1.y}});
+        vertices.push_back({pen + sf::Vector2f(p1.x, p2.y), color, {uv1.x, uv2.y}});
+        vertices.push_back({pen + sf::Vector2f(p1.x, p2.y), color, {uv1.x, uv2.y}});
+        vertices.push_back({pen + sf::Vector2f(p2.x, p1.y), color, {uv2.x, uv1.y}});
+        vertices.push_back({pen + sf::Vector2f(p2.x, p2.y), color, {uv2.x, uv2.y}});
+    }
+
+    // solid quad: every font page keeps a white 2x2 square at its top left (sfml reserves it for
+    // underlines), sampling its middle gives flat color without switching textures
+    void appendSolidQuad(std::vector<sf::Vertex> &vertices, sf::Vector2f p1, sf::Vector2f p2, sf::Color color)
+    {
+        const sf::Vector2f white(1.0f, 1.0f);
+        vertices.push_back({{p1.x, p1.y}, color, white});
+        vertices.push_back({{p2.x, p1.y}, color, white});
+        vertices.push_back({{p1.x, p2.y}, color, white});
+        vertices.push_back({{p1.x, p2.y}, color, white});
+        vertices.push_back({{p2.x, p1.y}, color, white});
+        vertices.push_back({{p2.x, p2.y}, color, white});
+    }
+}
+
+void RetainedHud::beginFrame(const sf::Font &font)
+{
+    if (font_ != &font)
+    {
+        // cached geometry points into the old font's pages
+        widgets_.clear();
+        font_ = &font;
+        dirty_ = true;
+    }
+    frameOrder_.clear();
+}
+
+RetainedHud::Widget &RetainedHud::touch(int id, bool isText)
+{
+    Widget &widget = widgets_[id];
+    if (widget.isText != isText)
+    {
+        widget = Widget{};
+        widget.isText = isText;
+        dirty_ = true;
+    }
+    frameOrder_.push_back(id);
+    return widget;
+}
+
+bool RetainedHud::sameStyle(const TextStyle &a, const TextStyle &b)
+{
+    // refreshSeconds only paces relayouts, it doesnt change the geometry
+    return a.characterSize == b.characterSize && a.fillColor == b.fillColor &&
+           a.outlineColor == b.outlineColor && a.outlineThickness == b.outlineThickness && a.bold == b.bold;
+}
+
+void RetainedHud::place(int id, sf::Vector2f position)
+{
+    auto it = widgets_.find(id);
+    if (it == widgets_.end() || it->second.position == position)
+        return;
+    it->second.position = position;
+    dirty_ = true;
+}
+
+void RetainedHud::rect(int id, const sf::FloatRect &bounds, sf::Color fill, float outlineThickness, sf::Color outlineColor)
+{
+    Widget &widget = touch(id, false);
+    if (widget.hasContent && widget.rect.position == bounds.position && widget.rect.size == bounds.size &&
+        widget.fill == fill && widget.outlineThickness == outlineThickness && widget.outlineColor == outlineColor)
+        return;
+    widget.hasContent = true;
+    widget.rect = bounds;
+    widget.fill = fill;
+    widget.outlineThickness = outlineThickness;
+    widget.outlineColor = outlineColor;
+    dirty_ = true;
+}
+
+void RetainedHud::layout(Widget &widget)
+{
+    // mirrors sf::Text's layout (kerning, tabs = 4 spaces, line spacing, outline glyphs under the fill)
+    ++layoutCount_;
+    dirty_ = true;
+    widget.vertices.clear();
+    widget.bounds = sf::FloatRect();
+    if (widget.text.empty())
+        return;
+
+    const TextStyle &style = widget.style;
+    const unsigned size = style.characterSize;
+    const float whitespaceWidth = font_->getGlyph(U' ', size, style.bold).advance;
+    const float lineSpacing = font_->getLineSpacing(size);
+
+    std::vector<sf::Vertex> fillVertices;
+    float minX = static_cast<float>(size);
+    float minY = static_cast<float>(size);
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    float x = 0.0f;
+    float y = static_cast<float>(size);
+    char32_t previous = 0;
+
+    const sf::String string = sf::String::fromUtf8(widget.text.begin(), widget.text.end());
+    for (const char32_t c : string)
+    {
+        if (c == U'\r')
+            continue;
+
+        x += font_->getKerning(previous, c, size, style.bold);
+        previous = c;
+
+        if (c == U' ' || c == U'\n' || c == U'\t')
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+            if (c == U' ')
+                x += whitespaceWidth;
+            else if (c == U'\t')
+                x += whitespaceWidth * 4.0f;
+            else
+            {
+                y += lineSpacing;
+                x = 0.0f;
+            }
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        if (style.outlineThickness != 0.0f)
+        {
+            const sf::Glyph &outlineGlyph = font_->getGlyph(c, size, style.bold, style.outlineThickness);
+            appendGlyphQuad(widget.vertices, {x, y}, style.outlineColor, outlineGlyph);
+        }
+
+        const sf::Glyph &glyph = font_->getGlyph(c, size, style.bold);
+        appendGlyphQuad(fillVertices, {x, y}, style.fillColor, glyph);
+
+        minX = std::min(minX, x + glyph.bounds.position.x);
+        maxX = std::max(maxX, x + glyph.bounds.position.x + glyph.bounds.size.x);
+        minY = std::min(minY, y + glyph.bounds.position.y);
+        maxY = std::max(maxY, y + glyph.bounds.position.y + glyph.bounds.size.y);
+
+        x += glyph.advance;
+    }
+
+    if (style.outlineThickness != 0.0f)
+    {
+        const float outline = std::abs(std::ceil(style.outlineThickness));
+        minX -= outline;
+        maxX += outline;
+        minY -= outline;
+        maxY += outline;
+    }
+
+    widget.vertices.insert(widget.vertices.end(), fillVertices.begin(), fillVertices.end());
+    widget.bounds = sf::FloatRect({minX, minY}, {maxX - minX, maxY - minY});
+}
+
+void RetainedHud::rebuildBatches()
+{
+    for (Batch &batch : batches_)
+        batch.vertices.clear();
+
+    auto batchFor = [this](unsigned characterSize) -> Batch &
+    {
+        for (Batch &batch : batches_)
+            if (batch.characterSize == characterSize)
+                return batch;
+        batches_.push_back(Batch{characterSize, {}});
+        return batches_.back();
+    };
+
+    // backgrounds first (they have to end up under all of the text), in the first text's page
+    unsigned rectPage = 0;
+    for (int id : frameOrder_)
+    {
+        const Widget &widget = widgets_[id];
+        if (widget.isText && widget.hasContent)
+        {
+            rectPage = widget.style.characterSize;
+            break;
+        }
+    }
+    if (rectPage == 0)
+        rectPage = batches_.empty() ? 12u : batches_.front().characterSize;
+
+    // the rect page batch goes first so the backgrounds draw before every other page
+    auto rectIt = std::find_if(batches_.begin(), batches_.end(), [&](const Batch &b)
+                               { return b.characterSize == rectPage; });
+    if (rectIt == batches_.end())
+        batches_.insert(batches_.begin(), Batch{rectPage, {}});
+    else
+        std::rotate(batches_.begin(), rectIt, rectIt + 1);
+
+    std::vector<sf::Vertex> &rectVertices = batches_.front().vertices;
+    for (int id : frameOrder_)
+    {
+        const Widget &widget = widgets_[id];
+        if (widget.isText || !widget.hasContent)
+            continue;
+        const sf::Vector2f p1 = widget.rect.position;
+        const sf::Vector2f p2 = widget.rect.position + widget.rect.size;
+        const float t = widget.outlineThickness;
+        if (t > 0.0f && widget.outlineColor.a > 0)
+        {
+            // border outside the rect like sf::RectangleShape's outline
+            appendSolidQuad(rectVertices, {p1.x - t, p1.y - t}, {p2.x + t, p1.y}, widget.outlineColor);
+            appendSolidQuad(rectVertices, {p1.x - t, p2.y}, {p2.x + t, p2.y + t}, widget.outlineColor);
+            appendSolidQuad(rectVertices, {p1.x - t, p1.y}, {p1.x, p2.y}, widget.outlineColor);
+            appendSolidQuad(rectVertices, {p2.x, p1.y}, {p2.x + t, p2.y}, widget.outlineColor);
+        }
+        appendSolidQuad(rectVertices, p1, p2, widget.fill);
+    }
+
+    for (int id : frameOrder_)
+    {
+        const Widget &widget = widgets_[id];
+        if (!widget.isText || !widget.hasContent)
+            continue;
+        std::vector<sf::Vertex> &out = batchFor(widget.style.characterSize).vertices;
+        for (sf::Vertex vertex : widget.vertices)
+        {
+            vertex.position += widget.position;
+            out.push_back(vertex);
+        }
+    }
+
+    batches_.erase(std::remove_if(batches_.begin(), batches_.end(), [](const Batch &b)
+                                  { return b.vertices.empty(); }),
+                   batches_.end());
+    builtOrder_ = frameOrder_;
+    dirty_ = false;
+}
+
+void RetainedHud::draw(sf::RenderTarget &target)
+{
+    if (!font_)
+        return;
+    if (dirty_ || frameOrder_ != builtOrder_)
+        rebuildBatches();
+
+    for (const Batch &batch : batches_)
+    {
+        sf::RenderStates states;
+        states.texture = &font_->getTexture(batch.characterSize);
+        target.draw(batch.vertices.data(), batch.vertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+}
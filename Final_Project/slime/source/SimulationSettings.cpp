@@ -18,7 +18,16 @@ bool SimulationSettings::saveToFile(const std::string &filename) const
     file << "stepsPerFrame=" << stepsPerFrame << "\n";
     file << "width=" << width << "\n";
     file << "height=" << height << "\n";
+    file << "viewWidth=" << viewWidth << "\n";
+    file << "viewHeight=" << viewHeight << "\n";
+    file << "viewMeanDownsample=" << (viewMeanDownsample ? 1 : 0) << "\n";
     file << "numAgents=" << numAgents << "\n";
+    file << "agentSortInterval=" << agentSortInterval << "\n";
+    file << "agentSortDegradeFactor=" << agentSortDegradeFactor << "\n";
+    file << "sensingPrefetchDistance=" << sensingPrefetchDistance << "\n";
+    file << "agentLodEnabled=" << (agentLodEnabled ? 1 : 0) << "\n";
+    file << "agentLodStableSteps=" << agentLodStableSteps << "\n";
+    file << "memoryBudgetMB=" << memoryBudgetMB << "\n";
     file << "spawnMode=" << static_cast<int>(spawnMode) << "\n";
     file << "trailWeight=" << trailWeight << "\n";
     file << "decayRate=" << decayRate << "\n";
@@ -26,6 +35,9 @@ bool SimulationSettings::saveToFile(const std::string &filename) const
     file << "displayThreshold=" << displayThreshold << "\n";
     file << "blurEnabled=" << (blurEnabled ? 1 : 0) << "\n";
     file << "slimeShadingEnabled=" << (slimeShadingEnabled ? 1 : 0) << "\n";
+    file << "lazyDecayEnabled=" << (lazyDecayEnabled ? 1 : 0) << "\n";
+    file << "implicitDiffusion=" << (implicitDiffusion ? 1 : 0) << "\n";
+    file << "fastMath=" << (fastMath ? 1 : 0) << "\n";
     file << "motionInertia=" << motionInertia << "\n";
     file << "anisotropicSplatsEnabled=" << (anisotropicSplatsEnabled ? 1 : 0) << "\n";
     file << "splatSigmaParallel=" << splatSigmaParallel << "\n";
@@ -33,6 +45,14 @@ bool SimulationSettings::saveToFile(const std::string &filename) const
     file << "splatIntensityScale=" << splatIntensityScale << "\n";
     file << "complianceStrength=" << complianceStrength << "\n";
     file << "complianceDamping=" << complianceDamping << "\n";
+    file << "fixedTimestep=" << (frameBudget.fixedTimestep ? 1 : 0) << "\n";
+    file << "tickRate=" << frameBudget.tickRate << "\n";
+    file << "maxTicksPerFrame=" << frameBudget.maxTicksPerFrame << "\n";
+    file << "adaptiveQuality=" << (frameBudget.adaptiveQuality ? 1 : 0) << "\n";
+    file << "targetFrameMs=" << frameBudget.targetFrameMs << "\n";
+    file << "fieldRecordInterval=" << fieldRecording.stepInterval << "\n";
+    file << "fieldRecordBits=" << fieldRecording.bits << "\n";
+    file << "fieldRecordKeyframeInterval=" << fieldRecording.keyframeInterval << "\n";
 
     // save species settings
     file << "speciesCount=" << speciesSettings.size() << "\n";
@@ -84,8 +104,26 @@ bool SimulationSettings::loadFromFile(const std::string &filename)
             width = std::stoi(value);
         else if (key == "height")
             height = std::stoi(value);
+        else if (key == "viewWidth")
+            viewWidth = std::stoi(value);
+        else if (key == "viewHeight")
+            viewHeight = std::stoi(value);
+        else if (key == "viewMeanDownsample")
+            viewMeanDownsample = (std::stoi(value) != 0);
         else if (key == "numAgents")
             numAgents = std::stoi(value);
+        else if (key == "agentSortInterval")
+            agentSortInterval = std::stoi(value);
+        else if (key == "agentSortDegradeFactor")
+            agentSortDegradeFactor = std::stof(value);
+        else if (key == "sensingPrefetchDistance")
+            sensingPrefetchDistance = std::stoi(value);
+        else if (key == "agentLodEnabled")
+            agentLodEnabled = (std::stoi(value) != 0);
+        else if (key == "agentLodStableSteps")
+            agentLodStableSteps = std::stoi(value);
+        else if (key == "memoryBudgetMB")
+            memoryBudgetMB = std::stoi(value);
         else if (key == "spawnMode")
             spawnMode = static_cast<SpawnMode>(std::stoi(value));
         else if (key == "trailWeight")
@@ -100,6 +138,12 @@ bool SimulationSettings::loadFromFile(const std::string &filename)
             blurEnabled = (std::stoi(value) != 0);
         else if (key == "slimeShadingEnabled")
             slimeShadingEnabled = (std::stoi(value) != 0);
+        else if (key == "lazyDecayEnabled")
+            lazyDecayEnabled = (std::stoi(value) != 0);
+        else if (key == "implicitDiffusion")
+            implicitDiffusion = (std::stoi(value) != 0);
+        else if (key == "fastMath")
+            fastMath = (std::stoi(value) != 0);
         else if (key == "motionInertia")
             motionInertia = std::stof(value);
         else if (key == "anisotropicSplatsEnabled")
@@ -114,6 +158,22 @@ bool SimulationSettings::loadFromFile(const std::string &filename)
             complianceStrength = std::stof(value);
         else if (key == "complianceDamping")
             complianceDamping = std::stof(value);
+        else if (key == "fixedTimestep")
+            frameBudget.fixedTimestep = (std::stoi(value) != 0);
+        else if (key == "tickRate")
+            frameBudget.tickRate = std::stof(value);
+        else if (key == "maxTicksPerFrame")
+            frameBudget.maxTicksPerFrame = std::stoi(value);
+        else if (key == "adaptiveQuality")
+            frameBudget.adaptiveQuality = (std::stoi(value) != 0);
+        else if (key == "targetFrameMs")
+            frameBudget.targetFrameMs = std::stof(value);
+        else if (key == "fieldRecordInterval")
+            fieldRecording.stepInterval = std::stoi(value);
+        else if (key == "fieldRecordBits")
+            fieldRecording.bits = std::stoi(value);
+        else if (key == "fieldRecordKeyframeInterval")
+            fieldRecording.keyframeInterval = std::stoi(value);
         // parse species settings
         else if (key.find("species") == 0)
         {
@@ -157,9 +217,16 @@ bool SimulationSettings::loadFromFile(const std::string &filename)
 void SimulationSettings::validateAndClamp()
 {
     stepsPerFrame = std::max(1, stepsPerFrame);
-    width = std::clamp(width, 100, 4096);
-    height = std::clamp(height, 100, 4096);
+    width = std::clamp(width, 100, 16384);
+    height = std::clamp(height, 100, 16384);
+    viewWidth = (viewWidth <= 0) ? 0 : std::clamp(viewWidth, 100, 8192);
+    viewHeight = (viewHeight <= 0) ? 0 : std::clamp(viewHeight, 100, 8192);
     numAgents = std::clamp(numAgents, 100, 1000000);
+    agentSortInterval = std::clamp(agentSortInterval, 0, 100000);
+    agentSortDegradeFactor = std::clamp(agentSortDegradeFactor, 1.1f, 100.0f);
+    sensingPrefetchDistance = std::clamp(sensingPrefetchDistance, -1, 64);
+    agentLodStableSteps = std::clamp(agentLodStableSteps, 1, 255);
+    memoryBudgetMB = std::clamp(memoryBudgetMB, 0, 1 << 20);
     trailWeight = std::clamp(trailWeight, 0.1f, 100.0f);
     decayRate = std::clamp(decayRate, 0.001f, 1.0f);
     diffuseRate = std::clamp(diffuseRate, 0.0f, 1.0f);
@@ -170,6 +237,12 @@ void SimulationSettings::validateAndClamp()
     splatIntensityScale = std::clamp(splatIntensityScale, 0.1f, 5.0f);
     complianceStrength = std::clamp(complianceStrength, 0.0f, 2.0f);
     complianceDamping = std::clamp(complianceDamping, 0.0f, 2.0f);
+    frameBudget.tickRate = std::clamp(frameBudget.tickRate, 1.0f, 1000.0f);
+    frameBudget.maxTicksPerFrame = std::clamp(frameBudget.maxTicksPerFrame, 1, 64);
+    frameBudget.targetFrameMs = std::clamp(frameBudget.targetFrameMs, 1.0f, 1000.0f);
+    fieldRecording.stepInterval = std::clamp(fieldRecording.stepInterval, 1, 100000);
+    fieldRecording.bits = fieldRecording.bits > 8 ? 16 : 8;
+    fieldRecording.keyframeInterval = std::clamp(fieldRecording.keyframeInterval, 1, 10000);
 
     // validate species settings
     for (auto &species : speciesSettings)
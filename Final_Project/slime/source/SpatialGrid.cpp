@@ -27,7 +27,7 @@ void SpatialGrid::insertAgent(size_t agentIndex, float x, float y)
     cells_[hash].addAgent(agentIndex);
 }
 
-void SpatialGrid::rebuild(const std::vector<Agent> &agents)
+void SpatialGrid::rebuild(const AgentVector &agents)
 {
     clear();
 
@@ -37,26 +37,55 @@ void SpatialGrid::rebuild(const std::vector<Agent> &agents)
     }
 }
 
-std::vector<size_t> SpatialGrid::getNeighbors(float x, float y, float radius) const
+FrameVector<size_t> SpatialGrid::getNeighbors(float x, float y, float radius) const
 {
-    std::vector<size_t> neighbors;
-    neighbors.reserve(64); // reasonable initial capacity
-
     // calculate grid range to check
     int radiusInCells = static_cast<int>(std::ceil(radius * invCellSize_));
     auto [centerX, centerY] = worldToGrid(x, y);
 
+    // find the occupied cells first so the result is sized once (a vector growing in the arena
+    // leaves its old buffers behind until the frame ends). up to radius 3 the cells are remembered,
+    // bigger queries just look them up again
+    constexpr int MAX_REMEMBERED = 49;
+    const IndexList *found[MAX_REMEMBERED];
+    int foundCount = 0;
+    bool remembered = true;
+    size_t total = 0;
+
     // check all cells within radius
     for (int dx = -radiusInCells; dx <= radiusInCells; ++dx)
     {
         for (int dy = -radiusInCells; dy <= radiusInCells; ++dy)
         {
-            int cellX = centerX + dx;
-            int cellY = centerY + dy;
-
-            uint64_t hash = hashPosition(cellX, cellY);
+            uint64_t hash = hashPosition(centerX + dx, centerY + dy);
             auto it = cells_.find(hash);
 
+            if (it != cells_.end())
+            {
+                const auto &indices = it->second.agentIndices;
+                total += indices.size();
+                if (foundCount < MAX_REMEMBERED)
+                    found[foundCount++] = &indices;
+                else
+                    remembered = false;
+            }
+        }
+    }
+
+    FrameVector<size_t> neighbors;
+    neighbors.reserve(total);
+    if (remembered)
+    {
+        for (int i = 0; i < foundCount; ++i)
+            neighbors.insert(neighbors.end(), found[i]->begin(), found[i]->end());
+        return neighbors;
+    }
+
+    for (int dx = -radiusInCells; dx <= radiusInCells; ++dx)
+    {
+        for (int dy = -radiusInCells; dy <= radiusInCells; ++dy)
+        {
+            auto it = cells_.find(hashPosition(centerX + dx, centerY + dy));
             if (it != cells_.end())
             {
                 const auto &cell = it->second;
@@ -70,7 +99,7 @@ std::vector<size_t> SpatialGrid::getNeighbors(float x, float y, float radius) co
     return neighbors;
 }
 
-std::vector<size_t> SpatialGrid::getNeighborsInCell(float x, float y) const
+FrameVector<size_t> SpatialGrid::getNeighborsInCell(float x, float y) const
 {
     auto [gridX, gridY] = worldToGrid(x, y);
     uint64_t hash = hashPosition(gridX, gridY);
@@ -78,13 +107,13 @@ std::vector<size_t> SpatialGrid::getNeighborsInCell(float x, float y) const
     auto it = cells_.find(hash);
     if (it != cells_.end())
     {
-        return it->second.agentIndices;
+        return FrameVector<size_t>(it->second.agentIndices.begin(), it->second.agentIndices.end());
     }
 
     return {};
 }
 
-std::vector<size_t> SpatialGrid::getSensingNeighbors(float x, float y, float sensorDistance) const
+FrameVector<size_t> SpatialGrid::getSensingNeighbors(float x, float y, float sensorDistance) const
 {
     // optimized for typical agent sensing operations
     return getNeighbors(x, y, sensorDistance * 1.1f); // small buffer for the edge cases
@@ -121,7 +150,7 @@ void SpatialGrid::reserve(size_t expectedAgents)
     cells_.reserve(expectedCells);
 }
 
-std::vector<size_t> SpatialGrid::getNearbyAgents(float x, float y, float radius) const
+FrameVector<size_t> SpatialGrid::getNearbyAgents(float x, float y, float radius) const
 {
     return getNeighbors(x, y, radius);
 }
@@ -1,11 +1,23 @@
 #undef setPixel
 #include "TrailMap.h"
+#include "FastMath.h"
+#include "FrameArena.h"
+#include "Log.h"
 #include <SFML/Graphics/Image.hpp>
 #include <algorithm>
 #include <cstring>
 #include <cmath>
 #include <random>
 #include <iostream>
+#include <future>
+#include <thread>
+#include <limits>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 TrailMap::TrailMap(int width, int height, int numSpecies)
     : width_(width), height_(height), numSpecies_(numSpecies)
@@ -15,15 +27,150 @@ TrailMap::TrailMap(int width, int height, int numSpecies)
     // create one trail map per species
     for (int i = 0; i < numSpecies_; ++i)
     {
-        speciesData_.push_back(std::make_unique<float[]>(size));
-        tempSpeciesData_.push_back(std::make_unique<float[]>(size));
+        speciesData_.push_back(makeTrackedArray<float, MemoryTag::Trails>(size));
+        tempSpeciesData_.push_back(makeTrackedArray<float, MemoryTag::Trails>(size));
     }
+    channelScale_.assign(numSpecies_, 1.0f);
+    channelInvScale_.assign(numSpecies_, 1.0f);
+    selectKernels();
 
     clear();
 }
 
 TrailMap::~TrailMap() = default;
 
+// ============================== species count kernels ==============================
+// N > 0 makes `count` a compile time constant so the species loops unroll, N = 0 is the fallback
+
+template <int N>
+float TrailMap::sampleInteractionKernel(const TrailMap &map, int idx, int species,
+                                        float attractionToSelf, float attractionToOthers)
+{
+    const int count = N > 0 ? N : map.numSpecies_;
+    const float ownTrail = map.speciesData_[species][idx] * map.channelScale_[species];
+
+    // the overlap rules only depend on the attraction parameters, work them out once:
+    // cooperative species get a synergy boost where trails meet, avoidant ones stronger repulsion,
+    // aggressive ones weaken the others (same cascade as before, just hoisted out of the loop)
+    const float overlapGain = attractionToOthers > 0.5f ? 1.3f : (attractionToOthers < -0.2f ? 1.5f : 1.0f);
+    const float overlapCut = (overlapGain == 1.0f && attractionToSelf > 1.2f && attractionToOthers < 0.2f) ? 0.3f : 0.0f;
+    const bool territorial = attractionToSelf > 1.0f;
+    const bool avoidant = attractionToOthers < 0.0f;
+
+    float totalAttraction = ownTrail * attractionToSelf;
+    for (int other = 0; other < count; ++other)
+    {
+        const float otherTrail = map.speciesData_[other][idx] * map.channelScale_[other];
+        float interaction = otherTrail * attractionToOthers;
+        const bool overlap = otherTrail > 0.1f && ownTrail > 0.1f;
+        interaction = overlap ? interaction * overlapGain - otherTrail * overlapCut : interaction;
+        // territory: strong own presence suppresses others, being overwhelmed increases avoidance
+        const float territory = (ownTrail > otherTrail * 2.0f && territorial)  ? 0.7f
+                                : (otherTrail > ownTrail * 2.0f && avoidant) ? 1.4f
+                                                                              : 1.0f;
+        totalAttraction += (other != species) ? interaction * territory : 0.0f;
+    }
+    return totalAttraction;
+}
+
+template <int N>
+float TrailMap::eatAnyKernel(TrailMap &map, int idx, int excludeSpecies, float maxBite)
+{
+    const int count = N > 0 ? N : map.numSpecies_;
+    float totalEaten = 0.0f;
+    for (int s = 0; s < count; ++s)
+    {
+        if (s == excludeSpecies) continue;  // dont eat own trail
+
+        float available = map.speciesData_[s][idx] * map.channelScale_[s];
+        float bite = std::min(available, maxBite - totalEaten);
+        if (bite > 0.0f)
+        {
+            map.speciesData_[s][idx] -= bite * map.channelInvScale_[s];
+            totalEaten += bite;
+        }
+        if (totalEaten >= maxBite) break;
+    }
+    return totalEaten;
+}
+
+template <int N>
+void TrailMap::composeRowKernel(const TrailMap &map, int width, const float *normalizedRows, const float *intensityRows,
+                                const float *thresholds, const float *colorRGB, sf::Image &image, int y)
+{
+    const int count = N > 0 ? N : map.numSpecies_;
+    for (int x = 0; x < width; ++x)
+    {
+        float totalR = 0.0f, totalG = 0.0f, totalB = 0.0f;
+        bool hasTrail = false;
+
+        // additive blend of every species above the display threshold (inactive species have an
+        // infinite threshold so they never light up)
+        for (int species = 0; species < count; ++species)
+        {
+            const size_t rowIdx = static_cast<size_t>(species) * width + x;
+            const bool lit = normalizedRows[rowIdx] > thresholds[species];
+            const float intensity = lit ? intensityRows[rowIdx] : 0.0f;
+            totalR += colorRGB[species * 3 + 0] * intensity;
+            totalG += colorRGB[species * 3 + 1] * intensity;
+            totalB += colorRGB[species * 3 + 2] * intensity;
+            hasTrail |= lit;
+        }
+
+        sf::Color finalColor = sf::Color::Black;
+
+        if (hasTrail)
+        {
+            // only compress if colors are severely oversaturated
+            float maxComponent = std::max({totalR, totalG, totalB});
+            if (maxComponent > 1.2f)
+            {
+                float scale = 1.2f / maxComponent;
+                totalR *= scale;
+                totalG *= scale;
+                totalB *= scale;
+            }
+
+            finalColor.r = static_cast<unsigned char>(std::min(255.0f, totalR * 255.0f));
+            finalColor.g = static_cast<unsigned char>(std::min(255.0f, totalG * 255.0f));
+            finalColor.b = static_cast<unsigned char>(std::min(255.0f, totalB * 255.0f));
+        }
+
+        finalColor.a = 255;
+        image.setPixel(sf::Vector2u(static_cast<unsigned int>(x), static_cast<unsigned int>(y)), finalColor);
+    }
+}
+
+template <int N>
+void TrailMap::useKernels()
+{
+    sampleInteractionFn_ = &TrailMap::sampleInteractionKernel<N>;
+    eatAnyFn_ = &TrailMap::eatAnyKernel<N>;
+    composeRowFn_ = &TrailMap::composeRowKernel<N>;
+}
+
+void TrailMap::selectKernels()
+{
+    switch (numSpecies_)
+    {
+    case 1:
+        useKernels<1>();
+        break;
+    case 3:
+        useKernels<3>();
+        break;
+    case 5:
+        useKernels<5>();
+        break;
+    case 8:
+        useKernels<8>();
+        break;
+    default:
+        useKernels<0>();
+        break;
+    }
+}
+
 // overload for compatibility with different parameter orders
 void TrailMap::deposit(int species, int x, int y, float amount)
 {
@@ -34,7 +181,50 @@ void TrailMap::clear()
     for (int species = 0; species < numSpecies_; ++species)
     {
         std::memset(speciesData_[species].get(), 0, width_ * height_ * sizeof(float));
+        channelScale_[species] = 1.0f;
+        channelInvScale_[species] = 1.0f;
+    }
+}
+
+namespace
+{
+    // below this the stored values get close to float overflow for fresh deposits, fold the scale in
+    constexpr float LAZY_DECAY_MIN_SCALE = 1e-20f;
+}
+
+void TrailMap::setLazyDecay(bool enabled)
+{
+    if (lazyDecay_ == enabled)
+        return;
+    lazyDecay_ = enabled;
+    if (!enabled)
+    {
+        for (int species = 0; species < numSpecies_; ++species)
+            settleScale(species);
+    }
+}
+
+void TrailMap::settleScale(int species)
+{
+    float scale = channelScale_[species];
+    if (scale == 1.0f)
+        return;
+
+    float *data = speciesData_[species].get();
+    for (int i = 0; i < width_ * height_; ++i)
+    {
+        data[i] *= scale;
     }
+    channelScale_[species] = 1.0f;
+    channelInvScale_[species] = 1.0f;
+}
+
+float *TrailMap::getData(int species)
+{
+    if (species < 0 || species >= numSpecies_)
+        return nullptr;
+    settleScale(species);
+    return speciesData_[species].get();
 }
 
 // optimized: inline bounds check assumes valid input in hot path
@@ -43,7 +233,7 @@ void TrailMap::deposit(int x, int y, float amount, int species)
     // defensive bounds check to prevent crash
     if (species < 0 || species >= numSpecies_ || x < 0 || x >= width_ || y < 0 || y >= height_)
         return;
-    speciesData_[species][y * width_ + x] += amount;
+    speciesData_[species][y * width_ + x] += amount * channelInvScale_[species];
 }
 
 // optimized: inline bounds check, avoid function call overhead, assume valid input in hot path
@@ -51,7 +241,7 @@ float TrailMap::sample(int x, int y, int species) const
 {
     if (species < 0 || species >= numSpecies_ || x < 0 || x >= width_ || y < 0 || y >= height_)
         return 0.0f;
-    return speciesData_[species][y * width_ + x];
+    return speciesData_[species][y * width_ + x] * channelScale_[species];
 }
 
 // eat trail at position return amount consumed (removes from trail)
@@ -61,9 +251,9 @@ float TrailMap::eat(int x, int y, int species, float maxBite)
         return 0.0f;
     
     int idx = y * width_ + x;
-    float available = speciesData_[species][idx];
+    float available = speciesData_[species][idx] * channelScale_[species];
     float eaten = std::min(available, maxBite);
-    speciesData_[species][idx] -= eaten;  // CONSUME the trail!
+    speciesData_[species][idx] -= eaten * channelInvScale_[species];  // CONSUME the trail!
     return eaten;
 }
 
@@ -73,23 +263,23 @@ float TrailMap::eatAnySpecies(int x, int y, int excludeSpecies, float maxBite)
     if (x < 0 || x >= width_ || y < 0 || y >= height_)
         return 0.0f;
     
-    float totalEaten = 0.0f;
-    int idx = y * width_ + x;
-    
-    for (int s = 0; s < numSpecies_; ++s)
+    return eatAnyFn_(*this, y * width_ + x, excludeSpecies, maxBite);
+}
+
+void TrailMap::prefetch(int x, int y) const
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (!isValidCoordinate(x, y))
+        return;
+    const int idx = getIndex(x, y);
+    for (int species = 0; species < numSpecies_; ++species)
     {
-        if (s == excludeSpecies) continue;  // dont eat own trail
-        
-        float available = speciesData_[s][idx];
-        float bite = std::min(available, maxBite - totalEaten);
-        if (bite > 0.0f)
-        {
-            speciesData_[s][idx] -= bite;
-            totalEaten += bite;
-        }
-        if (totalEaten >= maxBite) break;
+        __builtin_prefetch(speciesData_[species].get() + idx, 0, 1);
     }
-    return totalEaten;
+#else
+    (void)x;
+    (void)y;
+#endif
 }
 
 // multi species interaction sampling attempt to enhance complex emergent behaviors
@@ -100,58 +290,8 @@ float TrailMap::sampleSpeciesInteraction(int x, int y, int species,
     if (!isValidCoordinate(x, y) || species < 0 || species >= numSpecies_)
         return 0.0f;
 
-    float totalAttraction = 0.0f;
-    float ownTrail = speciesData_[species][getIndex(x, y)];
-
-    // sample own species trail with self attraction
-    totalAttraction += ownTrail * attractionToSelf;
-
-    // enhanced multi species interactions with emergent behaviors
-    for (int otherSpecies = 0; otherSpecies < numSpecies_; ++otherSpecies)
-    {
-        if (otherSpecies != species)
-        {
-            float otherTrail = speciesData_[otherSpecies][getIndex(x, y)];
-
-            // basic attraction/repulsion to other species
-            float basicInteraction = otherTrail * attractionToOthers;
-
-            // enhanced interactions based on trail density combinations
-            if (otherTrail > 0.1f && ownTrail > 0.1f)
-            {
-                // when trails overlap, create competition or cooperation effects
-                if (attractionToOthers > 0.5f)
-                {
-                    // cooperative species: synergy effect when trails meet
-                    basicInteraction *= 1.3f;
-                }
-                else if (attractionToOthers < -0.2f)
-                {
-                    // avoidant species: stronger repulsion when trails are dense
-                    basicInteraction *= 1.5f;
-                }
-                else if (attractionToSelf > 1.2f && attractionToOthers < 0.2f)
-                {
-                    // aggressive species: compete for territory by weakening others
-                    basicInteraction -= otherTrail * 0.3f;
-                }
-            }
-
-            // territory competition: stronger trails suppress weaker ones
-            if (ownTrail > otherTrail * 2.0f && attractionToSelf > 1.0f)
-            {
-                // strong own presence suppresses others for territorial species
-                basicInteraction *= 0.7f;
-            }
-            else if (otherTrail > ownTrail * 2.0f && attractionToOthers < 0.0f)
-            {
-                // being overwhelmed by others should increase avoidance
-                basicInteraction *= 1.4f;
-            }
-
-            totalAttraction += basicInteraction;
-        }
-    }
+    // own trail weighted by self attraction plus every other species through the interaction rules
+    float totalAttraction = sampleInteractionFn_(*this, getIndex(x, y), species, attractionToSelf, attractionToOthers);
 
     // adds small amount of noise to prevent perfectly regular patterns
     static thread_local std::random_device rd;
@@ -199,19 +339,246 @@ void TrailMap::diffuse(float diffuseRate)
             }
         }
 
-        // blend original with the diffused result
+        // border pixels arent diffused - keep them as is instead of blending in whatever an
+        // earlier blur swap left in the temp buffer (that stale data is also in old lazy decay units)
+        std::memcpy(tempData, data, width_ * sizeof(float));
+        std::memcpy(tempData + (height_ - 1) * width_, data + (height_ - 1) * width_, width_ * sizeof(float));
+        for (int y = 1; y < height_ - 1; ++y)
+        {
+            tempData[getIndex(0, y)] = data[getIndex(0, y)];
+            tempData[getIndex(width_ - 1, y)] = data[getIndex(width_ - 1, y)];
+        }
+
+        // blend original with the diffused result. the blend is a full sweep anyway so any pending
+        // lazy decay scale gets folded in here for free
+        const float scale = channelScale_[species];
+        const float keep = (1.0f - diffuseRate) * scale;
+        const float spread = diffuseRate * scale;
         for (int i = 0; i < width_ * height_; ++i)
         {
-            data[i] = data[i] * (1.0f - diffuseRate) + tempData[i] * diffuseRate;
+            data[i] = data[i] * keep + tempData[i] * spread;
+        }
+        channelScale_[species] = 1.0f;
+        channelInvScale_[species] = 1.0f;
+    }
+}
+
+namespace
+{
+    // factored constant coefficient tridiagonal system  -a x[i-1] + (1 + 2a) x[i] - a x[i+1] = d[i]
+    // (ends are 1 + a for the clamped boundary). the elimination coefficients dont depend on the
+    // right hand side so they are computed once per line length and reused for every row/column
+    struct TridiagonalPlan
+    {
+        int n = 0;
+        float a = 0.0f;
+        bool cyclic = false;
+        std::vector<float> invPivot; // 1 / (b[i] - a * cp[i-1])
+        std::vector<float> cp;       // c'[i] of the thomas algorithm
+        std::vector<float> z;        // sherman-morrison correction vector (cyclic only)
+        float cornerOverGamma = 0.0f;
+        float invCorrectionDenom = 0.0f;
+
+        TridiagonalPlan(int length, float alpha, bool wrap)
+            : n(length), a(alpha), cyclic(wrap && length >= 3), invPivot(length), cp(length)
+        {
+            const float lower = -a; // sub and super diagonal
+            std::vector<float> b(n, 1.0f + 2.0f * a);
+            if (!cyclic)
+            {
+                // clamped: the edge cell has only one neighbor to exchange with
+                b[0] = 1.0f + a;
+                b[n - 1] = 1.0f + a;
+                if (n == 1)
+                    b[0] = 1.0f;
+            }
+
+            // cyclic system via sherman-morrison: the two corner entries (-a) are folded into
+            // the diagonal and corrected afterwards with the precomputed vector z
+            const float gamma = -b[0];
+            if (cyclic)
+            {
+                b[0] -= gamma;
+                b[n - 1] -= lower * lower / gamma;
+            }
+
+            invPivot[0] = 1.0f / b[0];
+            cp[0] = lower * invPivot[0];
+            for (int i = 1; i < n; ++i)
+            {
+                invPivot[i] = 1.0f / (b[i] - lower * cp[i - 1]);
+                cp[i] = lower * invPivot[i];
+            }
+
+            if (cyclic)
+            {
+                z.assign(n, 0.0f);
+                z[0] = gamma;
+                z[n - 1] = lower;
+                solveSingle(z.data());
+                cornerOverGamma = lower / gamma;
+                invCorrectionDenom = 1.0f / (1.0f + z[0] + cornerOverGamma * z[n - 1]);
+            }
+        }
+
+        // plain thomas solve of the (modified) system for one contiguous vector
+        void solveSingle(float *d) const
+        {
+            const float lower = -a;
+            d[0] *= invPivot[0];
+            for (int i = 1; i < n; ++i)
+                d[i] = (d[i] - lower * d[i - 1]) * invPivot[i];
+            for (int i = n - 2; i >= 0; --i)
+                d[i] -= cp[i] * d[i + 1];
+        }
+
+        // solves `lanes` independent lines at once. element i of lane l lives at
+        // base[i * stride + l] so the inner loops run over contiguous memory and vectorize
+        void solveLanes(float *base, size_t stride, int lanes) const
+        {
+            const float lower = -a;
+            {
+                float *row = base;
+                const float p = invPivot[0];
+                for (int l = 0; l < lanes; ++l)
+                    row[l] *= p;
+            }
+            for (int i = 1; i < n; ++i)
+            {
+                float *row = base + i * stride;
+                const float *prev = row - stride;
+                const float p = invPivot[i];
+                for (int l = 0; l < lanes; ++l)
+                    row[l] = (row[l] - lower * prev[l]) * p;
+            }
+            for (int i = n - 2; i >= 0; --i)
+            {
+                float *row = base + i * stride;
+                const float *next = row + stride;
+                const float c = cp[i];
+                for (int l = 0; l < lanes; ++l)
+                    row[l] -= c * next[l];
+            }
+
+            if (!cyclic)
+                return;
+
+            // sherman-morrison correction x -= fact * z per lane
+            const float *first = base;
+            const float *last = base + (n - 1) * stride;
+            float fact[ADI_LANES];
+            for (int l0 = 0; l0 < lanes; l0 += ADI_LANES)
+            {
+                int count = std::min(ADI_LANES, lanes - l0);
+                for (int l = 0; l < count; ++l)
+                    fact[l] = (first[l0 + l] + cornerOverGamma * last[l0 + l]) * invCorrectionDenom;
+                for (int i = 0; i < n; ++i)
+                {
+                    float *row = base + i * stride + l0;
+                    const float zi = z[i];
+                    for (int l = 0; l < count; ++l)
+                        row[l] -= fact[l] * zi;
+                }
+            }
+        }
+
+        static constexpr int ADI_LANES = 16;
+    };
+
+    // splits [0, count) into bands and runs func(begin, end) on each (std::async like the other parallel paths)
+    template <typename Function>
+    void runBands(int count, int numThreads, Function &&func)
+    {
+        if (numThreads <= 1 || count < 2 * numThreads)
+        {
+            func(0, count);
+            return;
+        }
+
+        FrameVector<std::future<void>> futures;
+        futures.reserve(numThreads);
+        int perBand = (count + numThreads - 1) / numThreads;
+        for (int begin = 0; begin < count; begin += perBand)
+        {
+            int end = std::min(begin + perBand, count);
+            futures.emplace_back(std::async(std::launch::async, [&func, begin, end]()
+                                            { func(begin, end); }));
+        }
+        for (auto &future : futures)
+        {
+            future.wait();
         }
     }
 }
 
+void TrailMap::diffuseImplicit(float diffuseRate, int steps, bool wrapEdges, int numThreads)
+{
+    if (diffuseRate <= 0.0f || steps <= 0)
+        return;
+    if (numThreads <= 0)
+    {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // the explicit step blends a [1 2 1]/4 kernel (variance 0.5 per axis) in at diffuseRate, so
+    // `steps` of them spread by 0.5 * rate * steps per axis. backward euler with coefficient a
+    // spreads by 2a, which gives a = rate * steps / 4
+    const float alpha = 0.25f * diffuseRate * static_cast<float>(steps);
+    const TridiagonalPlan rowPlan(width_, alpha, wrapEdges);
+    const TridiagonalPlan columnPlan(height_, alpha, wrapEdges);
+    constexpr int LANES = TridiagonalPlan::ADI_LANES;
+
+    for (int species = 0; species < numSpecies_; ++species)
+    {
+        float *data = speciesData_[species].get();
+
+        // pass 1: rows. blocks of LANES rows are transposed into an interleaved buffer so the
+        // solve runs across rows in lockstep, then written back
+        const int rowBlocks = (height_ + LANES - 1) / LANES;
+        runBands(rowBlocks, numThreads, [&](int blockBegin, int blockEnd)
+                 {
+            std::vector<float> lanes(static_cast<size_t>(width_) * LANES);
+            for (int block = blockBegin; block < blockEnd; ++block)
+            {
+                int y0 = block * LANES;
+                int count = std::min(LANES, height_ - y0);
+                for (int r = 0; r < count; ++r)
+                {
+                    const float *src = data + static_cast<size_t>(y0 + r) * width_;
+                    for (int x = 0; x < width_; ++x)
+                        lanes[x * LANES + r] = src[x];
+                }
+                rowPlan.solveLanes(lanes.data(), LANES, count);
+                for (int r = 0; r < count; ++r)
+                {
+                    float *dst = data + static_cast<size_t>(y0 + r) * width_;
+                    for (int x = 0; x < width_; ++x)
+                        dst[x] = lanes[x * LANES + r];
+                }
+            } });
+
+        // pass 2: columns. a column band is already lane contiguous within each row
+        runBands(width_, numThreads, [&](int x0, int x1)
+                 { columnPlan.solveLanes(data + x0, static_cast<size_t>(width_), x1 - x0); });
+    }
+}
+
 void TrailMap::decay(float decayRate)
 {
     float decayFactor = 1.0f - decayRate;
     for (int species = 0; species < numSpecies_; ++species)
     {
+        if (lazyDecay_)
+        {
+            // no sweep: the channel just remembers it got smaller
+            channelScale_[species] *= decayFactor;
+            if (channelScale_[species] < LAZY_DECAY_MIN_SCALE)
+                settleScale(species);
+            else
+                channelInvScale_[species] = 1.0f / channelScale_[species];
+            continue;
+        }
+
         float *data = speciesData_[species].get();
         for (int i = 0; i < width_ * height_; ++i)
         {
@@ -229,6 +596,8 @@ void TrailMap::applyBlur()
     {
         float *data = speciesData_[species].get();
         float *tempData = tempSpeciesData_[species].get();
+        // visibility cutoff in stored units (lazy decay scale)
+        const float visibleCutoff = 0.01f * channelInvScale_[species];
 
         // copy original data first
         std::memcpy(tempData, data, width_ * height_ * sizeof(float));
@@ -241,7 +610,7 @@ void TrailMap::applyBlur()
                 float original = data[idx];
 
                 // applies the blur to any visible trail (lower threshold so more pixels are affected)
-                if (original > 0.01f)
+                if (original > visibleCutoff)
                 {
                     // and weighted 3x3 blur for smoother effect
                     float sum = 0.0f;
@@ -269,18 +638,149 @@ void TrailMap::applyBlur()
     }
 }
 
-void TrailMap::updateTexture(sf::Image &image, float displayThreshold, const sf::Color &baseColor) const
+namespace
+{
+    // one step of the vertical view reduction: acc = max(acc, src) or acc += src over a row span
+    void reduceRowInto(const float *src, float *acc, int count, bool sum)
+    {
+        int i = 0;
+#if defined(__AVX__)
+        if (sum)
+        {
+            for (; i + 8 <= count; i += 8)
+                _mm256_storeu_ps(acc + i, _mm256_add_ps(_mm256_loadu_ps(acc + i), _mm256_loadu_ps(src + i)));
+        }
+        else
+        {
+            for (; i + 8 <= count; i += 8)
+                _mm256_storeu_ps(acc + i, _mm256_max_ps(_mm256_loadu_ps(acc + i), _mm256_loadu_ps(src + i)));
+        }
+#elif defined(__ARM_NEON)
+        if (sum)
+        {
+            for (; i + 4 <= count; i += 4)
+                vst1q_f32(acc + i, vaddq_f32(vld1q_f32(acc + i), vld1q_f32(src + i)));
+        }
+        else
+        {
+            for (; i + 4 <= count; i += 4)
+                vst1q_f32(acc + i, vmaxq_f32(vld1q_f32(acc + i), vld1q_f32(src + i)));
+        }
+#endif
+        // handle remaining elements
+        for (; i < count; ++i)
+        {
+            acc[i] = sum ? acc[i] + src[i] : std::max(acc[i], src[i]);
+        }
+    }
+}
+
+void TrailMap::reduceView(int species, const Viewport &view, int outW, int outH, float *out) const
+{
+    const float *data = speciesData_[species].get();
+    const float scale = std::max(view.scale, 1e-3f);
+
+    if (scale <= 1.0f)
+    {
+        // 1:1 or magnified: each output pixel shows the cell under its center (outside the world = 0)
+        viewColumns_.resize(outW);
+        for (int px = 0; px < outW; ++px)
+        {
+            viewColumns_[px] = static_cast<int>(std::floor(view.originX + (px + 0.5f) * scale));
+        }
+        for (int py = 0; py < outH; ++py)
+        {
+            float *dst = out + static_cast<size_t>(py) * outW;
+            const int wy = static_cast<int>(std::floor(view.originY + (py + 0.5f) * scale));
+            if (wy < 0 || wy >= height_)
+            {
+                std::fill(dst, dst + outW, 0.0f);
+                continue;
+            }
+            const float *row = data + static_cast<size_t>(wy) * width_;
+            for (int px = 0; px < outW; ++px)
+            {
+                const int wx = viewColumns_[px];
+                dst[px] = (wx >= 0 && wx < width_) ? row[wx] : 0.0f;
+            }
+        }
+        return;
+    }
+
+    // zoomed out: output column px covers world columns [viewColumns_[px], viewColumns_[px + 1]).
+    // the rows under one output row get folded together first (contiguous, simd), then each column
+    // span of that folded row is reduced to one pixel
+    viewColumns_.resize(outW + 1);
+    for (int px = 0; px <= outW; ++px)
+    {
+        viewColumns_[px] = std::clamp(static_cast<int>(std::floor(view.originX + px * scale)), 0, width_);
+    }
+    const int firstColumn = viewColumns_[0];
+    const int span = viewColumns_[outW] - firstColumn;
+    viewReduceRow_.resize(width_);
+    float *folded = viewReduceRow_.data();
+
+    for (int py = 0; py < outH; ++py)
+    {
+        float *dst = out + static_cast<size_t>(py) * outW;
+        const int y0 = std::clamp(static_cast<int>(std::floor(view.originY + py * scale)), 0, height_);
+        const int y1 = std::clamp(static_cast<int>(std::floor(view.originY + (py + 1) * scale)), 0, height_);
+        if (y1 <= y0 || span <= 0)
+        {
+            std::fill(dst, dst + outW, 0.0f);
+            continue;
+        }
+
+        std::memcpy(folded + firstColumn, data + static_cast<size_t>(y0) * width_ + firstColumn, span * sizeof(float));
+        for (int y = y0 + 1; y < y1; ++y)
+        {
+            reduceRowInto(data + static_cast<size_t>(y) * width_ + firstColumn, folded + firstColumn, span, view.meanReduce);
+        }
+
+        const float rows = static_cast<float>(y1 - y0);
+        for (int px = 0; px < outW; ++px)
+        {
+            const int x0 = viewColumns_[px];
+            const int x1 = viewColumns_[px + 1];
+            if (x1 <= x0)
+            {
+                dst[px] = 0.0f;
+                continue;
+            }
+            float value = folded[x0];
+            if (view.meanReduce)
+            {
+                for (int x = x0 + 1; x < x1; ++x)
+                    value += folded[x];
+                value /= rows * static_cast<float>(x1 - x0);
+            }
+            else
+            {
+                for (int x = x0 + 1; x < x1; ++x)
+                    value = std::max(value, folded[x]);
+            }
+            dst[px] = value;
+        }
+    }
+}
+
+void TrailMap::updateTexture(sf::Image &image, float displayThreshold, const sf::Color &baseColor, bool fastMath,
+                             const Viewport &view) const
 #undef setPixel
 {
     if (numSpecies_ == 0)
         return;
 
-    // for single species it just uses the first channel
-    float *data = speciesData_[0].get();
+    // for single species it just uses the first channel, brought to display resolution first
+    const int outW = static_cast<int>(image.getSize().x);
+    const int outH = static_cast<int>(image.getSize().y);
+    viewValues_.resize(static_cast<size_t>(outW) * outH);
+    reduceView(0, view, outW, outH, viewValues_.data());
+    const float *data = viewValues_.data();
 
-    // find maximum value for normalization
+    // find maximum value for normalization (over what is on screen)
     float maxVal = 0.0f;
-    for (int i = 0; i < width_ * height_; ++i)
+    for (size_t i = 0; i < viewValues_.size(); ++i)
     {
         maxVal = std::max(maxVal, data[i]);
     }
@@ -288,13 +788,24 @@ void TrailMap::updateTexture(sf::Image &image, float displayThreshold, const sf:
     if (maxVal <= 0.0f)
         return;
 
+    // intensity curve for a whole row at once so the pow runs as one batch
+    std::vector<float> normalizedRow(outW);
+    std::vector<float> intensityRow(outW);
+    const float invMax = 1.0f / maxVal;
+
     // update image pixels with crisp, high contrast rendering
-    for (int y = 0; y < height_; ++y)
+    for (int y = 0; y < outH; ++y)
     {
-        for (int x = 0; x < width_; ++x)
+        const float *row = data + static_cast<size_t>(y) * outW;
+        for (int x = 0; x < outW; ++x)
         {
-            float rawValue = data[getIndex(x, y)];
-            float normalizedValue = rawValue / maxVal;
+            normalizedRow[x] = row[x] * invMax;
+        }
+        FastMath::powArray(normalizedRow.data(), 0.8f, intensityRow.data(), outW, fastMath);
+
+        for (int x = 0; x < outW; ++x)
+        {
+            float normalizedValue = normalizedRow[x];
 
             sf::Color color;
             if (normalizedValue < displayThreshold)
@@ -304,7 +815,7 @@ void TrailMap::updateTexture(sf::Image &image, float displayThreshold, const sf:
             else
             {
                 // high contrast mapping for sharp, detailed trails
-                float intensity = std::pow(normalizedValue, 0.8f); // enhance contrast
+                float intensity = intensityRow[x]; // normalized^0.8 to enhance contrast
 
                 // preserve accurate species colors
                 float r = (baseColor.r / 255.0f) * intensity;
@@ -333,95 +844,202 @@ void TrailMap::updateTexture(sf::Image &image, float displayThreshold, const sf:
 
 // multi species texture update 
 void TrailMap::updateMultiSpeciesTexture(sf::Image &image, float displayThreshold,
-                                         const std::vector<sf::Color> &speciesColors) const
+                                         std::span<const sf::Color> speciesColors, bool fastMath,
+                                         const Viewport &view) const
 {
+    // every channel brought to display resolution first, everything below works on that
+    const int outW = static_cast<int>(image.getSize().x);
+    const int outH = static_cast<int>(image.getSize().y);
+    const size_t plane = static_cast<size_t>(outW) * outH;
+    viewValues_.resize(plane * numSpecies_);
+
     // Find max value PER species for independent normalization (so each species is equally visible)
     std::vector<float> maxValPerSpecies(numSpecies_, 0.0f);
     for (int species = 0; species < numSpecies_; ++species)
     {
-        const float *data = speciesData_[species].get();
-        for (int i = 0; i < width_ * height_; ++i)
+        float *data = viewValues_.data() + plane * species;
+        reduceView(species, view, outW, outH, data);
+        for (size_t i = 0; i < plane; ++i)
         {
             maxValPerSpecies[species] = std::max(maxValPerSpecies[species], data[i]);
         }
     }
     
-    // debug: for printing max values per species every 120 frames
-    static int debugCounter = 0;
-    if (++debugCounter % 120 == 0) {
-        std::cout << "[TRAIL DEBUG] Max per channel: ";
+    // debug: for printing max values per species every 2 seconds
+    static Log::RateLimit trailDebugSite(2000);
+    if (Log::due(Log::Level::Debug, trailDebugSite)) {
+        Log::Line line(Log::Level::Debug, 0);
+        line.stream() << "[TRAIL DEBUG] Max per channel: ";
         for (int s = 0; s < numSpecies_ && s < 8; ++s) {
-            std::cout << "ch" << s << "=" << maxValPerSpecies[s] << " ";
+            line.stream() << "ch" << s << "=" << maxValPerSpecies[s] * channelScale_[s] << " ";
         }
-        std::cout << std::endl;
     }
 
+    // per species blend inputs for the compose kernel: colors as 0..1 floats, and the display threshold
+    // (infinite for species without a color or without any trail so they never contribute)
+    std::vector<float> colorRGB(static_cast<size_t>(numSpecies_) * 3, 0.0f);
+    std::vector<float> thresholds(numSpecies_, std::numeric_limits<float>::infinity());
+    for (int species = 0; species < numSpecies_ && species < static_cast<int>(speciesColors.size()); ++species)
+    {
+        colorRGB[species * 3 + 0] = speciesColors[species].r / 255.0f;
+        colorRGB[species * 3 + 1] = speciesColors[species].g / 255.0f;
+        colorRGB[species * 3 + 2] = speciesColors[species].b / 255.0f;
+        if (maxValPerSpecies[species] > 0.0f)
+            thresholds[species] = displayThreshold;
+    }
+
+    // per species rows of normalized value and intensity, the pow runs per row as one batch
+    std::vector<float> normalizedRows(static_cast<size_t>(numSpecies_) * outW, 0.0f);
+    std::vector<float> intensityRows(static_cast<size_t>(numSpecies_) * outW, 0.0f);
+
     // renders each pixel with proper species color blending
-    for (int y = 0; y < height_; ++y)
+    for (int y = 0; y < outH; ++y)
     {
-        for (int x = 0; x < width_; ++x)
+        for (int species = 0; species < numSpecies_; ++species)
         {
-            int idx = getIndex(x, y);
-            float totalR = 0.0f, totalG = 0.0f, totalB = 0.0f;
-            bool hasTrail = false;
-
-            // calculate contribution from each species
-            for (int species = 0; species < numSpecies_; ++species)
+            if (maxValPerSpecies[species] <= 0.0f)
+                continue;
+            float *normalized = normalizedRows.data() + static_cast<size_t>(species) * outW;
+            const float *row = viewValues_.data() + plane * species + static_cast<size_t>(y) * outW;
+            const float invMax = 1.0f / maxValPerSpecies[species];
+            for (int x = 0; x < outW; ++x)
             {
-                if (species >= static_cast<int>(speciesColors.size()))
-                    continue;
-
-                // skipping if this species has no trails at all
-                if (maxValPerSpecies[species] <= 0.0f)
-                    continue;
-
-                float rawValue = speciesData_[species][idx];
-                float normalizedVal = rawValue / maxValPerSpecies[species];  // normalize per species
-                
-                // use display threshold like single species mode
-                if (normalizedVal > displayThreshold)
-                {
-                    hasTrail = true;
-                    const sf::Color &speciesColor = speciesColors[species];
+                normalized[x] = row[x] * invMax;
+            }
+            FastMath::powArray(normalized, 0.8f, intensityRows.data() + static_cast<size_t>(species) * outW, outW, fastMath);
+        }
 
-                    // use same intensity curve as single species for consistency
-                    float intensity = std::pow(normalizedVal, 0.8f);
+        composeRowFn_(*this, outW, normalizedRows.data(), intensityRows.data(), thresholds.data(), colorRGB.data(), image, y);
+    }
+}
 
-                    // accurate species color reproduction
-                    float r = (speciesColor.r / 255.0f) * intensity;
-                    float g = (speciesColor.g / 255.0f) * intensity;
-                    float b = (speciesColor.b / 255.0f) * intensity;
+// ============================== reconfiguration ==============================
 
-                    // additive blending for species interactions
-                    totalR += r;
-                    totalG += g;
-                    totalB += b;
-                }
-            }
+void TrailMap::remapSpecies(const std::vector<int> &sourceChannels)
+{
+    size_t size = width_ * height_;
+    std::vector<Channel> newData;
+    std::vector<Channel> newTemp;
+    std::vector<float> newScale;
+    std::vector<float> newInvScale;
+    newData.reserve(sourceChannels.size());
+    newTemp.reserve(sourceChannels.size());
+
+    // surviving channels just move their buffers over, only new species allocate
+    for (int source : sourceChannels)
+    {
+        if (source >= 0 && source < numSpecies_ && speciesData_[source])
+        {
+            newData.push_back(std::move(speciesData_[source]));
+            newTemp.push_back(std::move(tempSpeciesData_[source]));
+            newScale.push_back(channelScale_[source]);
+            newInvScale.push_back(channelInvScale_[source]);
+        }
+        else
+        {
+            newData.push_back(makeTrackedArray<float, MemoryTag::Trails>(size)); // value initialized = empty trail
+            newTemp.push_back(makeTrackedArray<float, MemoryTag::Trails>(size));
+            newScale.push_back(1.0f);
+            newInvScale.push_back(1.0f);
+        }
+    }
 
-            sf::Color finalColor = sf::Color::Black;
+    speciesData_ = std::move(newData);
+    tempSpeciesData_ = std::move(newTemp);
+    channelScale_ = std::move(newScale);
+    channelInvScale_ = std::move(newInvScale);
+    numSpecies_ = static_cast<int>(speciesData_.size());
+    selectKernels();
+}
 
-            if (hasTrail)
-            {
-                // only compress if colors are severely oversaturated
-                float maxComponent = std::max({totalR, totalG, totalB});
-                if (maxComponent > 1.2f)
-                {
-                    float scale = 1.2f / maxComponent;
-                    totalR *= scale;
-                    totalG *= scale;
-                    totalB *= scale;
-                }
+namespace
+{
+    // vertical half of the bilinear filter: out = a + (b - a) * t over a whole source row
+    void lerpRows(const float *a, const float *b, float t, float *out, int count)
+    {
+        int i = 0;
+#if defined(__AVX__)
+        const __m256 tVec = _mm256_set1_ps(t);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 va = _mm256_loadu_ps(a + i);
+            __m256 vb = _mm256_loadu_ps(b + i);
+            _mm256_storeu_ps(out + i, _mm256_add_ps(va, _mm256_mul_ps(_mm256_sub_ps(vb, va), tVec)));
+        }
+#elif defined(__ARM_NEON)
+        const float32x4_t tVec = vdupq_n_f32(t);
+        for (; i + 4 <= count; i += 4)
+        {
+            float32x4_t va = vld1q_f32(a + i);
+            float32x4_t vb = vld1q_f32(b + i);
+            vst1q_f32(out + i, vmlaq_f32(va, vsubq_f32(vb, va), tVec));
+        }
+#endif
+        // handle remaining elements
+        for (; i < count; ++i)
+        {
+            out[i] = a[i] + (b[i] - a[i]) * t;
+        }
+    }
 
-                finalColor.r = static_cast<unsigned char>(std::min(255.0f, totalR * 255.0f));
-                finalColor.g = static_cast<unsigned char>(std::min(255.0f, totalG * 255.0f));
-                finalColor.b = static_cast<unsigned char>(std::min(255.0f, totalB * 255.0f));
-            }
+    // source sample position for each destination pixel (pixel centers line up)
+    struct ResampleTap
+    {
+        int i0, i1;
+        float t;
+    };
+
+    std::vector<ResampleTap> buildTaps(int srcSize, int dstSize)
+    {
+        std::vector<ResampleTap> taps(dstSize);
+        float scale = static_cast<float>(srcSize) / static_cast<float>(dstSize);
+        for (int d = 0; d < dstSize; ++d)
+        {
+            float pos = std::clamp((d + 0.5f) * scale - 0.5f, 0.0f, static_cast<float>(srcSize - 1));
+            int i0 = static_cast<int>(pos);
+            taps[d] = {i0, std::min(i0 + 1, srcSize - 1), pos - i0};
+        }
+        return taps;
+    }
+}
+
+void TrailMap::resize(int newWidth, int newHeight)
+{
+    if (newWidth == width_ && newHeight == height_)
+        return;
+    newWidth = std::max(1, newWidth);
+    newHeight = std::max(1, newHeight);
+
+    const size_t newSize = static_cast<size_t>(newWidth) * newHeight;
+    const std::vector<ResampleTap> xTaps = buildTaps(width_, newWidth);
+    const std::vector<ResampleTap> yTaps = buildTaps(height_, newHeight);
+    std::vector<float> row(width_);
 
-            finalColor.a = 255;
-            image.setPixel(sf::Vector2u(static_cast<unsigned int>(x), static_cast<unsigned int>(y)), finalColor);
+    for (int species = 0; species < numSpecies_; ++species)
+    {
+        const float *src = speciesData_[species].get();
+        auto dst = makeTrackedArray<float, MemoryTag::Trails>(newSize);
+
+        for (int y = 0; y < newHeight; ++y)
+        {
+            // blend the two source rows (simd), then pick columns out of the blended row
+            const ResampleTap &ty = yTaps[y];
+            lerpRows(src + ty.i0 * width_, src + ty.i1 * width_, ty.t, row.data(), width_);
+
+            float *out = dst.get() + static_cast<size_t>(y) * newWidth;
+            for (int x = 0; x < newWidth; ++x)
+            {
+                const ResampleTap &tx = xTaps[x];
+                out[x] = row[tx.i0] + (row[tx.i1] - row[tx.i0]) * tx.t;
+            }
         }
+
+        speciesData_[species] = std::move(dst);
+        tempSpeciesData_[species] = makeTrackedArray<float, MemoryTag::Trails>(newSize);
     }
+
+    width_ = newWidth;
+    height_ = newHeight;
 }
 
 // ============================== GPU data transfer ==============================
@@ -436,9 +1054,10 @@ std::vector<float> TrailMap::getAllData() const
     for (int species = 0; species < numSpecies_; ++species)
     {
         const float *speciesPtr = speciesData_[species].get();
+        const float scale = channelScale_[species];
         for (int i = 0; i < width_ * height_; ++i)
         {
-            allData.push_back(speciesPtr[i]);
+            allData.push_back(speciesPtr[i] * scale);
         }
     }
 
@@ -469,6 +1088,8 @@ void TrailMap::setData(const std::vector<float> &data, int width, int height)
         {
             speciesPtr[i] = data[offset++];
         }
+        channelScale_[species] = 1.0f;
+        channelInvScale_[species] = 1.0f;
     }
 }
 bool TrailMap::isValidCoordinate(int x, int y) const
@@ -27,66 +27,71 @@ void UIManager::handleMouseInput(const sf::Event::MouseButtonPressed* mouseEvent
 void UIManager::drawHUD(sf::RenderWindow &window, const SimulationSettings &settings,
                         float updateTime, int agentCount)
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3);
-
-    // basic info
-    oss << "=== Physarum Simulation ===" << "\n";
-    oss << "Agents: " << agentCount << " | Update: " << updateTime << "ms" << "\n";
-    oss << "Resolution: " << settings.width << "x" << settings.height << "\n\n";
-
-    // trail settings
-    oss << "=== Trail Settings ===" << "\n";
-    oss << "Trail Weight [5/6]: " << settings.trailWeight << "\n";
-    oss << "Decay Rate [3/4]: " << settings.decayRate << "\n";
-    oss << "Diffuse Rate [1/2]: " << settings.diffuseRate << "\n";
-    oss << "Display Threshold [T/Y]: " << settings.displayThreshold << "\n";
-    oss << "Blur [B]: " << (settings.blurEnabled ? "ON" : "OFF") << "\n\n";
-
-    // movement settings (first species)
-    if (!settings.speciesSettings.empty())
-    {
-        const auto &species = settings.speciesSettings[0];
-        oss << "=== Movement Settings ===" << "\n";
-        oss << "Move Speed [E/R]: " << species.moveSpeed << "\n";
-        oss << "Turn Speed [Q/W]: " << species.turnSpeed << "°" << "\n";
-        oss << "Sensor Angle [7/8]: " << species.sensorAngleSpacing << "°" << "\n";
-        oss << "Sensor Distance [9/0]: " << species.sensorOffsetDistance << "\n\n";
-    }
-
-    // emergence & reproduction (first species shown)
-    if (!settings.speciesSettings.empty())
+    // retained: the text is only relaid out when the values change, the update time at most 4x a second
+    RetainedHud::TextStyle style;
+    style.characterSize = 14;
+    style.fillColor = hudTextColor_;
+    style.outlineThickness = 1.5f;
+    style.refreshSeconds = 0.25f;
+
+    hud_.beginFrame(font_);
+    sf::FloatRect textBounds = hud_.text(HUD_TEXT, style, [&](HudWriter &out)
     {
-        const auto &s = settings.speciesSettings[0];
-        oss << "=== Emergence & Reproduction ===" << "\n";
-        oss << "Mating [X]: " << (s.matingEnabled ? "ON" : "OFF")
-            << "  |  Splitting [Z]: " << (s.splittingEnabled ? "ON" : "OFF")
-            << "  |  Cross-species [C]: " << (s.crossSpeciesMating ? "ON" : "OFF") << "\n";
-        oss << "Radius [U/I]: " << s.matingRadius
-            << "  |  Mutation [K/J]: " << s.hybridMutationRate << "\n";
-        oss << "SplitThreshold: " << s.splitEnergyThreshold
-            << "  |  Rebirth: " << (s.rebirthEnabled ? "ON" : "OFF")
-            << "  |  Lifespan(s): " << s.lifespanSeconds << "\n\n";
-    }
+        out << std::fixed << std::setprecision(3);
+
+        // basic info
+        out << "=== Physarum Simulation ===" << "\n";
+        out << "Agents: " << agentCount << " | Update: " << updateTime << "ms" << "\n";
+        out << "Resolution: " << settings.width << "x" << settings.height << "\n\n";
+
+        // trail settings
+        out << "=== Trail Settings ===" << "\n";
+        out << "Trail Weight [5/6]: " << settings.trailWeight << "\n";
+        out << "Decay Rate [3/4]: " << settings.decayRate << "\n";
+        out << "Diffuse Rate [1/2]: " << settings.diffuseRate << "\n";
+        out << "Display Threshold [T/Y]: " << settings.displayThreshold << "\n";
+        out << "Blur [B]: " << (settings.blurEnabled ? "ON" : "OFF") << "\n\n";
+
+        // movement settings (first species)
+        if (!settings.speciesSettings.empty())
+        {
+            const auto &species = settings.speciesSettings[0];
+            out << "=== Movement Settings ===" << "\n";
+            out << "Move Speed [E/R]: " << species.moveSpeed << "\n";
+            out << "Turn Speed [Q/W]: " << species.turnSpeed << "°" << "\n";
+            out << "Sensor Angle [7/8]: " << species.sensorAngleSpacing << "°" << "\n";
+            out << "Sensor Distance [9/0]: " << species.sensorOffsetDistance << "\n\n";
+        }
 
-    // controls
-    oss << "=== Controls ===" << "\n";
-    oss << "[Space] Reset | [↑/↓] Agent Count" << "\n";
-    oss << "[P] Parameter Editor | [H] Help" << "\n";
-    oss << "[S] Save | [L] Load Settings" << "\n";
-    oss << "[M] Multi-Species (" << settings.speciesSettings.size() << " species)" << "\n";
+        // emergence & reproduction (first species shown)
+        if (!settings.speciesSettings.empty())
+        {
+            const auto &s = settings.speciesSettings[0];
+            out << "=== Emergence & Reproduction ===" << "\n";
+            out << "Mating [X]: " << (s.matingEnabled ? "ON" : "OFF")
+                << "  |  Splitting [Z]: " << (s.splittingEnabled ? "ON" : "OFF")
+                << "  |  Cross-species [C]: " << (s.crossSpeciesMating ? "ON" : "OFF") << "\n";
+            out << "Radius [U/I]: " << s.matingRadius
+                << "  |  Mutation [K/J]: " << s.hybridMutationRate << "\n";
+            out << "SplitThreshold: " << s.splitEnergyThreshold
+                << "  |  Rebirth: " << (s.rebirthEnabled ? "ON" : "OFF")
+                << "  |  Lifespan(s): " << s.lifespanSeconds << "\n\n";
+        }
 
-    sf::Text text(font_, oss.str(), 14);
-    text.setFillColor(hudTextColor_);
-    text.setOutlineColor(sf::Color::Black);
-    text.setOutlineThickness(1.5f);
-    text.setPosition({10.0f, 10.0f});
+        // controls
+        out << "=== Controls ===" << "\n";
+        out << "[Space] Reset | [↑/↓] Agent Count" << "\n";
+        out << "[P] Parameter Editor | [H] Help" << "\n";
+        out << "[S] Save | [L] Load Settings" << "\n";
+        out << "[M] Multi-Species (" << settings.speciesSettings.size() << " species)" << "\n";
+    });
+    hud_.place(HUD_TEXT, {10.0f, 10.0f});
 
-    // draw background
-    sf::FloatRect textBounds = text.getLocalBounds();
-    drawBackground(window, sf::FloatRect({5, 5}, {textBounds.size.x + 10, textBounds.size.y + 10}));
+    // background (same look as drawBackground)
+    hud_.rect(HUD_BACKGROUND, sf::FloatRect({5, 5}, {textBounds.size.x + 10, textBounds.size.y + 10}),
+              hudBackgroundColor_, 1.0f, sf::Color(100, 100, 100));
 
-    window.draw(text);
+    hud_.draw(window);
 }
 
 void UIManager::drawParameterEditor(sf::RenderWindow &window, SimulationSettings &settings)
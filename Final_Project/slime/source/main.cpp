@@ -15,11 +15,19 @@
 #include <iomanip>
 #include <cmath>
 #include <random>
+#include <cstdlib>
+#include <string>
 
 #include "SimulationSettings.h"
 #include "Agent.h"
 #include "TrailMap.h"
 #include "PhysarumSimulation.h"
+#include "FrameBudgetController.h"
+#include "RetainedHud.h"
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include "EventLog.h"
+#include "FieldRecorder.h"
 
 // species generation modes
 enum class SpeciesMode
@@ -59,6 +67,15 @@ static bool hudTransparency = true; // whether hud background is transparent
 static bool allUIHidden = false;    // Shift+F toggle - completely hides ALL UI elements
 static HudMode savedHudMode = HudMode::Full; // saved mode before hiding all UI
 
+// widget ids in the main hud layer
+enum HudWidget
+{
+    HUD_FULL_BACKGROUND,
+    HUD_FULL_TEXT,
+    HUD_COMPACT_BACKGROUND,
+    HUD_COMPACT_TEXT
+};
+
 // TODO: restructure to change this forward declaration*
 std::string getSpeciesModeString(SpeciesMode mode, int randomCount);
 std::string getHudModeString(HudMode mode);
@@ -69,6 +86,10 @@ float scaleBehaviorValue(float baseValue, int intensity, float minMult, float ma
 // window constants
 const int WINDOW_WIDTH = 1200;
 const int WINDOW_HEIGHT = 900;
+// world (trail grid) size - same as the window by default, bigger worlds (up to 16384 x 16384) are
+// viewed through the camera: mouse wheel zooms, middle drag pans, home shows the whole world
+const int WORLD_WIDTH = WINDOW_WIDTH;
+const int WORLD_HEIGHT = WINDOW_HEIGHT;
 
 // mouse interaction settings
 struct MouseSettings
@@ -131,39 +152,62 @@ void randomizeSettings(SimulationSettings &settings)
 // declarations for species management
 void addRandomClassic5Species(PhysarumSimulation &simulation, SimulationSettings &settings);
 void removeRandomClassic5Species(PhysarumSimulation &simulation, SimulationSettings &settings);
+std::vector<int> classic5SpeciesSources(const std::vector<int> &previousActive);
 void toggleSpecies(int speciesIndex, PhysarumSimulation &simulation, SimulationSettings &settings);
 
-void drawCompactHUD(sf::RenderWindow &window, sf::Font &font, const SimulationSettings &settings,
+// tracked memory per subsystem, live and peak (MemoryTracker.h)
+void writeMemoryUsage(HudWriter &out)
+{
+    out << std::fixed << std::setprecision(1);
+    out << "Total: " << MemoryTracker::displayMB(MemoryTracker::totalLive()) << " MB (peak "
+        << MemoryTracker::displayMB(MemoryTracker::totalPeak()) << ")";
+    if (MemoryTracker::budget() > 0)
+        out << " / budget " << MemoryTracker::displayMB(MemoryTracker::budget()) << " MB";
+    out << "\n";
+    for (int i = 0; i < MemoryTracker::TAG_COUNT; ++i)
+    {
+        const MemoryTag tag = static_cast<MemoryTag>(i);
+        out << MemoryTracker::name(tag) << " " << MemoryTracker::displayMB(MemoryTracker::live(tag))
+            << " (" << MemoryTracker::displayMB(MemoryTracker::peak(tag)) << ")" << (i % 3 == 2 ? "\n" : "  |  ");
+    }
+}
+
+void drawCompactHUD(sf::RenderWindow &window, RetainedHud &hud, const SimulationSettings &settings,
                     const MouseSettings &mouseSettings, int agentCount,
                     SpeciesMode speciesMode, int randomCount, HudPosition position)
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(2);
+    RetainedHud::TextStyle style;
+    style.characterSize = 12;
+    style.outlineThickness = 1.0f;
+    style.refreshSeconds = 0.25f; // the agent count moves every frame with splits and deaths
 
     // minimal info only
-    oss << "Agents: " << agentCount << " | ";
-    oss << getSpeciesModeString(speciesMode, randomCount) << "\n";
-
-    // shading status and motion inertia (compact)
-    oss << (settings.slimeShadingEnabled ? "Shading: ON" : "Shading: OFF") << " | ";
-    oss << "Inertia: " << std::fixed << std::setprecision(2) << settings.motionInertia << " | ";
-    oss << (settings.anisotropicSplatsEnabled ? "Aniso: ON" : "Aniso: OFF") << " | ";
-    oss << "k: " << std::fixed << std::setprecision(2) << settings.complianceStrength << " | ";
-    oss << "d: " << std::fixed << std::setprecision(2) << settings.complianceDamping << "\n";
-
-    if (speciesMode == SpeciesMode::Random)
+    sf::FloatRect textBounds = hud.text(HUD_COMPACT_TEXT, style, [&](HudWriter &out)
     {
-        oss << "[N/V] Count | [G] Regen | ";
-    }
-    oss << "[F] Mode | [H] Toggle | [Shift+S] Shade | [Shift+1-4] Position";
-
-    sf::Text text(font, oss.str(), 12);
-    text.setFillColor(sf::Color::White);
-    text.setOutlineColor(sf::Color::Black);
-    text.setOutlineThickness(1.0f);
+        out << std::fixed << std::setprecision(2);
+
+        out << "Agents: " << agentCount << " | ";
+        out << getSpeciesModeString(speciesMode, randomCount) << " | ";
+        out << "Mem: " << std::setprecision(1) << MemoryTracker::displayMB(MemoryTracker::totalLive()) << " MB";
+        if (MemoryTracker::budget() > 0)
+            out << "/" << MemoryTracker::displayMB(MemoryTracker::budget());
+        out << "\n";
+
+        // shading status and motion inertia (compact)
+        out << (settings.slimeShadingEnabled ? "Shading: ON" : "Shading: OFF") << " | ";
+        out << "Inertia: " << std::fixed << std::setprecision(2) << settings.motionInertia << " | ";
+        out << (settings.anisotropicSplatsEnabled ? "Aniso: ON" : "Aniso: OFF") << " | ";
+        out << "k: " << std::fixed << std::setprecision(2) << settings.complianceStrength << " | ";
+        out << "d: " << std::fixed << std::setprecision(2) << settings.complianceDamping << "\n";
+
+        if (speciesMode == SpeciesMode::Random)
+        {
+            out << "[N/V] Count | [G] Regen | ";
+        }
+        out << "[F] Mode | [H] Toggle | [Shift+S] Shade | [Shift+1-4] Position";
+    });
 
     // position the hud based on the current position setting
-    sf::FloatRect textBounds = text.getLocalBounds();
     sf::Vector2f windowSize(static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y));
     sf::Vector2f hudPos;
 
@@ -183,121 +227,124 @@ void drawCompactHUD(sf::RenderWindow &window, sf::Font &font, const SimulationSe
         break;
     }
 
-    text.setPosition(hudPos);
+    hud.place(HUD_COMPACT_TEXT, hudPos);
 
     // draws the background if transparency is enabled
     if (hudTransparency)
     {
-        sf::RectangleShape background(sf::Vector2f(textBounds.size.x + 10, textBounds.size.y + 10));
-        background.setPosition({hudPos.x - 5, hudPos.y - 5});
-        background.setFillColor(sf::Color(0, 0, 0, 100));
-        window.draw(background);
+        hud.rect(HUD_COMPACT_BACKGROUND, sf::FloatRect({hudPos.x - 5, hudPos.y - 5}, {textBounds.size.x + 10, textBounds.size.y + 10}),
+                 sf::Color(0, 0, 0, 100));
     }
-
-    window.draw(text);
 }
 
-void drawSimpleHUD(sf::RenderWindow &window, sf::Font &font, const SimulationSettings &settings,
+void drawSimpleHUD(sf::RenderWindow &window, RetainedHud &hud, const SimulationSettings &settings,
                    const MouseSettings &mouseSettings, int agentCount,
                    SpeciesMode speciesMode, int randomCount)
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3);
-
-    oss << " Physarum Simulation (Modern) " << "\n";
-    oss << "Agents: " << agentCount << "\n";
-    oss << "Resolution: " << settings.width << "x" << settings.height << "\n\n";
-
-    oss << " Trail Settings " << "\n";
-    oss << "Trail Weight [5/6]: " << settings.trailWeight << "\n";
-    oss << "Decay Rate [3/4]: " << settings.decayRate << "\n";
-    oss << "Diffuse Rate [1/2]: " << settings.diffuseRate << "\n";
-    oss << "Display Threshold [T/Y]: " << settings.displayThreshold << "\n";
-    oss << "Blur [B]: " << (settings.blurEnabled ? "ON" : "OFF") << "\n\n";
-
-    oss << " Rendering " << "\n";
-    oss << "Slime Shading [Shift+S]: " << (settings.slimeShadingEnabled ? "ON" : "OFF") << "\n";
-    oss << "Anisotropic Splats [Shift+A]: " << (settings.anisotropicSplatsEnabled ? "ON" : "OFF") << "\n";
-    oss << "Compliance k [U/P]: " << std::fixed << std::setprecision(2) << settings.complianceStrength << "\n";
-    oss << "Damping d [;/' ]: " << std::fixed << std::setprecision(2) << settings.complianceDamping << "\n";
-    oss << "Motion Inertia [Shift+I/Shift+O]: " << std::fixed << std::setprecision(2) << settings.motionInertia << "\n\n";
+    RetainedHud::TextStyle style;
+    style.characterSize = 14;
+    style.outlineThickness = 1.5f;
+    style.refreshSeconds = 0.25f;
 
-    if (!settings.speciesSettings.empty())
+    sf::FloatRect textBounds = hud.text(HUD_FULL_TEXT, style, [&](HudWriter &out)
     {
-        const auto &species = settings.speciesSettings[0];
-        oss << " Movement Settings " << "\n";
-        oss << "Move Speed [E/R]: " << species.moveSpeed << "\n";
-        oss << "Turn Speed [Q/W]: " << species.turnSpeed << "\n";
-        oss << "Sensor Angle [7/8]: " << species.sensorAngleSpacing << "\n";
-        oss << "Sensor Distance [9/0]: " << species.sensorOffsetDistance << "\n\n";
-
-        // emergence & reproduction*
-        oss << " Emergence & Reproduction " << "\n";
-        oss << "Mating [Shift+X]: " << (species.matingEnabled ? "ON" : "OFF")
-            << "  |  Splitting [Shift+Z]: " << (species.splittingEnabled ? "ON" : "OFF")
-            << "  |  Cross-species [Shift+C]: " << (species.crossSpeciesMating ? "ON" : "OFF") << "\n";
-        oss << "Radius [[/]]: " << species.matingRadius
-            << "  |  Mutation [-/=]: " << species.hybridMutationRate << "\n";
-        oss << "Rebirth: " << (species.rebirthEnabled ? "ON" : "OFF")
-            << "  |  Lifespan(s): " << species.lifespanSeconds << "\n\n";
-    }
+        out << std::fixed << std::setprecision(3);
 
-    oss << " Mouse Interaction " << "\n";
-    oss << "Food Strength [Shift+↑/↓]: " << mouseSettings.foodStrength << "\n";
-    oss << "Brush Radius: " << mouseSettings.brushRadius << " px" << "\n\n";
 
-    oss << " Species Mode " << "\n";
-    oss << "Current: " << getSpeciesModeString(speciesMode, randomCount) << "\n";
+        out << " Physarum Simulation (Modern) " << "\n";
+        out << "Agents: " << agentCount << "\n";
+        out << "Resolution: " << settings.width << "x" << settings.height << "\n\n";
 
-    // mode specific information here
-    if (speciesMode == SpeciesMode::Classic5)
-    {
-        oss << "Species: Red(Aggressive), Blue(Cooperative), Green(Avoiding),\n";
-        oss << "         Yellow(Alien), Magenta(Anti-Alien)\n";
-        oss << "Intensity: [I/O] All +/- | [H/J/K/,/.] Individual Cycle\n";
-        oss << "Reroll: [G] Random combination of species\n";
-    }
-    else if (speciesMode == SpeciesMode::Random)
-    {
-        oss << "Random Count: " << randomCount << " species\n";
-        oss << "Controls: [N/V] Count +/- | [G] Regenerate\n";
-        oss << "Intensity: [I/O] All +/-\n";
-    }
-    else if (speciesMode == SpeciesMode::Single)
-    {
-        oss << "Single species mode\n";
-        oss << "Intensity: [H] Cycle | [I/O] +/-\n";
-    }
+        out << " Memory (MB, peak) " << "\n";
+        writeMemoryUsage(out);
+        out << std::setprecision(3) << "\n";
 
-    if (!settings.speciesSettings.empty())
-    {
-        oss << "Current Intensity: " << settings.speciesSettings[0].behaviorIntensity << " (1=mild, 4=extreme)\n";
-    }
-    oss << "\n";
+        out << " Trail Settings " << "\n";
+        out << "Trail Weight [5/6]: " << settings.trailWeight << "\n";
+        out << "Decay Rate [3/4]: " << settings.decayRate << "\n";
+        out << "Diffuse Rate [1/2]: " << settings.diffuseRate << "\n";
+        out << "Display Threshold [T/Y]: " << settings.displayThreshold << "\n";
+        out << "Blur [B]: " << (settings.blurEnabled ? "ON" : "OFF") << "\n\n";
 
-    oss << " Controls " << "\n";
-    oss << "[Space] Reset | [↑/↓] Agent Count" << "\n";
-    oss << "[S] Save | [L] Load | [Z] Randomize (plain) | [Shift+Z] Toggle Splitting" << "\n";
-    oss << "[C] Change Color | [M] Cycle Species Mode" << "\n";
+        out << " Rendering " << "\n";
+        out << "Slime Shading [Shift+S]: " << (settings.slimeShadingEnabled ? "ON" : "OFF") << "\n";
+        out << "Anisotropic Splats [Shift+A]: " << (settings.anisotropicSplatsEnabled ? "ON" : "OFF") << "\n";
+        out << "Compliance k [U/P]: " << std::fixed << std::setprecision(2) << settings.complianceStrength << "\n";
+        out << "Damping d [;/' ]: " << std::fixed << std::setprecision(2) << settings.complianceDamping << "\n";
+        out << "Motion Inertia [Shift+I/Shift+O]: " << std::fixed << std::setprecision(2) << settings.motionInertia << "\n\n";
 
-    if (speciesMode == SpeciesMode::Random)
-    {
-        oss << "[N/V] Random Count +/- | [G] Regenerate Random" << "\n";
-    }
+        if (!settings.speciesSettings.empty())
+        {
+            const auto &species = settings.speciesSettings[0];
+            out << " Movement Settings " << "\n";
+            out << "Move Speed [E/R]: " << species.moveSpeed << "\n";
+            out << "Turn Speed [Q/W]: " << species.turnSpeed << "\n";
+            out << "Sensor Angle [7/8]: " << species.sensorAngleSpacing << "\n";
+            out << "Sensor Distance [9/0]: " << species.sensorOffsetDistance << "\n\n";
+
+            // emergence & reproduction*
+            out << " Emergence & Reproduction " << "\n";
+            out << "Mating [Shift+X]: " << (species.matingEnabled ? "ON" : "OFF")
+                << "  |  Splitting [Shift+Z]: " << (species.splittingEnabled ? "ON" : "OFF")
+                << "  |  Cross-species [Shift+C]: " << (species.crossSpeciesMating ? "ON" : "OFF") << "\n";
+            out << "Radius [[/]]: " << species.matingRadius
+                << "  |  Mutation [-/=]: " << species.hybridMutationRate << "\n";
+            out << "Rebirth: " << (species.rebirthEnabled ? "ON" : "OFF")
+                << "  |  Lifespan(s): " << species.lifespanSeconds << "\n\n";
+        }
+
+        out << " Mouse Interaction " << "\n";
+        out << "Food Strength [Shift+↑/↓]: " << mouseSettings.foodStrength << "\n";
+        out << "Brush Radius: " << mouseSettings.brushRadius << " px" << "\n\n";
+
+        out << " Species Mode " << "\n";
+        out << "Current: " << getSpeciesModeString(speciesMode, randomCount) << "\n";
+
+        // mode specific information here
+        if (speciesMode == SpeciesMode::Classic5)
+        {
+            out << "Species: Red(Aggressive), Blue(Cooperative), Green(Avoiding),\n";
+            out << "         Yellow(Alien), Magenta(Anti-Alien)\n";
+            out << "Intensity: [I/O] All +/- | [H/J/K/,/.] Individual Cycle\n";
+            out << "Reroll: [G] Random combination of species\n";
+        }
+        else if (speciesMode == SpeciesMode::Random)
+        {
+            out << "Random Count: " << randomCount << " species\n";
+            out << "Controls: [N/V] Count +/- | [G] Regenerate\n";
+            out << "Intensity: [I/O] All +/-\n";
+        }
+        else if (speciesMode == SpeciesMode::Single)
+        {
+            out << "Single species mode\n";
+            out << "Intensity: [H] Cycle | [I/O] +/-\n";
+        }
 
-    oss << "[B] Toggle Blur | [Shift+S] Slime Shading | [Shift+A] Aniso Splats | [U/P] k -/+ | [;/' ] d -/+ | [Shift+I/Shift+O] Inertia +/- | [F] HUD Mode | [H] Hide HUD" << "\n";
-    oss << "[Shift+1-4] HUD Position | [X] HUD Transparency" << "\n";
-    oss << "[Shift+X] Toggle Mating | [Shift+C] Toggle Cross-species" << "\n";
-    oss << "[[/]] Mating Radius | [-/=] Hybrid Mutation" << "\n";
-    oss << "[Left Mouse] Food | [Right Mouse] Repellent" << "\n";
+        if (!settings.speciesSettings.empty())
+        {
+            out << "Current Intensity: " << settings.speciesSettings[0].behaviorIntensity << " (1=mild, 4=extreme)\n";
+        }
+        out << "\n";
 
-    sf::Text text(font, oss.str(), 14);
-    text.setFillColor(sf::Color::White);
-    text.setOutlineColor(sf::Color::Black);
-    text.setOutlineThickness(1.5f);
+        out << " Controls " << "\n";
+        out << "[Space] Reset | [↑/↓] Agent Count" << "\n";
+        out << "[S] Save | [L] Load | [Z] Randomize (plain) | [Shift+Z] Toggle Splitting" << "\n";
+        out << "[C] Change Color | [M] Cycle Species Mode" << "\n";
+
+        if (speciesMode == SpeciesMode::Random)
+        {
+            out << "[N/V] Random Count +/- | [G] Regenerate Random" << "\n";
+        }
+
+        out << "[B] Toggle Blur | [Shift+S] Slime Shading | [Shift+A] Aniso Splats | [U/P] k -/+ | [;/' ] d -/+ | [Shift+I/Shift+O] Inertia +/- | [F] HUD Mode | [H] Hide HUD" << "\n";
+        out << "[Shift+1-4] HUD Position | [X] HUD Transparency" << "\n";
+        out << "[Shift+X] Toggle Mating | [Shift+C] Toggle Cross-species" << "\n";
+        out << "[[/]] Mating Radius | [-/=] Hybrid Mutation" << "\n";
+        out << "[F5] Record Trail Field" << "\n";
+        out << "[Left Mouse] Food | [Right Mouse] Repellent" << "\n";
+    });
 
     // positions the hud based on the current position setting
-    sf::FloatRect textBounds = text.getLocalBounds();
     sf::Vector2f windowSize(static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y));
     sf::Vector2f hudPos;
 
@@ -317,22 +364,11 @@ void drawSimpleHUD(sf::RenderWindow &window, sf::Font &font, const SimulationSet
         break;
     }
 
-    text.setPosition(hudPos);
+    hud.place(HUD_FULL_TEXT, hudPos);
 
-    // draws background with configurable transparency
-    sf::RectangleShape background(sf::Vector2f(textBounds.size.x + 20, textBounds.size.y + 20));
-    background.setPosition({hudPos.x - 10, hudPos.y - 10});
-    if (hudTransparency)
-    {
-        background.setFillColor(sf::Color(0, 0, 0, 120)); // more transparent
-    }
-    else
-    {
-        background.setFillColor(sf::Color(0, 0, 0, 200)); // more opaque
-    }
-
-    window.draw(background);
-    window.draw(text);
+    // draws background with configurable transparency (more transparent / more opaque)
+    hud.rect(HUD_FULL_BACKGROUND, sf::FloatRect({hudPos.x - 10, hudPos.y - 10}, {textBounds.size.x + 20, textBounds.size.y + 20}),
+             hudTransparency ? sf::Color(0, 0, 0, 120) : sf::Color(0, 0, 0, 200));
 }
 
 // helper func to scale behavior values based on intensity (1-4)
@@ -1401,6 +1437,19 @@ void setupSpecies(SimulationSettings &settings)
     }
 }
 
+// maps each active classic species slot to the slot it had in previousActive (-1 = just added)
+// so the simulation can keep trails/agents of species that stayed when the set changes
+std::vector<int> classic5SpeciesSources(const std::vector<int> &previousActive)
+{
+    std::vector<int> sources;
+    for (int speciesIndex : activeSpeciesIndices)
+    {
+        auto it = std::find(previousActive.begin(), previousActive.end(), speciesIndex);
+        sources.push_back(it != previousActive.end() ? static_cast<int>(it - previousActive.begin()) : -1);
+    }
+    return sources;
+}
+
 // function to add a random classic 5 species
 void addRandomClassic5Species(PhysarumSimulation &simulation, SimulationSettings &settings)
 {
@@ -1509,8 +1558,63 @@ void removeRandomClassic5Species(PhysarumSimulation &simulation, SimulationSetti
     std::cout << std::endl;
 }
 
-int main()
+int main(int argc, char **argv)
 {
+    // slime --summarize <benchmark_events_*.csv>: per algorithm tables of a recorded race, no window
+    if (argc >= 3 && std::string(argv[1]) == "--summarize")
+    {
+        const auto rows = EventLog::summarize(argv[2]);
+        if (rows.empty())
+        {
+            std::cout << "No events in " << argv[2] << std::endl;
+            return 1;
+        }
+        EventLog::printSummary(rows, std::cout);
+        return 0;
+    }
+
+    // slime --field-info <field_*.slfr> / --field-probe <file> x y [species]: a recorded trail field,
+    // the probe prints one cell's value over the whole recording as csv (no re-simulating)
+    if (argc >= 3 && (std::string(argv[1]) == "--field-info" || std::string(argv[1]) == "--field-probe"))
+    {
+        FieldReader reader;
+        if (!reader.open(argv[2]) || reader.frameCount() == 0)
+        {
+            std::cout << "Could not read field recording " << argv[2] << std::endl;
+            return 1;
+        }
+        if (std::string(argv[1]) == "--field-info")
+        {
+            std::cout << reader.width() << "x" << reader.height() << ", " << reader.channels() << " channels, "
+                      << reader.bits() << " bit, " << reader.frameCount() << " frames (steps "
+                      << reader.frameStep(0) << " to " << reader.frameStep(reader.frameCount() - 1) << ", every "
+                      << reader.stepInterval() << ")" << std::endl;
+            return 0;
+        }
+        const int x = argc >= 5 ? std::atoi(argv[3]) : 0;
+        const int y = argc >= 5 ? std::atoi(argv[4]) : 0;
+        const int species = argc >= 6 ? std::atoi(argv[5]) : 0;
+        if (x < 0 || y < 0 || x >= reader.width() || y >= reader.height() || species < 0 || species >= reader.channels())
+        {
+            std::cout << "Cell or species outside the recording" << std::endl;
+            return 1;
+        }
+        const size_t cell = static_cast<size_t>(species) * reader.width() * reader.height() +
+                            static_cast<size_t>(y) * reader.width() + x;
+        std::vector<float> field;
+        std::cout << "step,value" << "\n";
+        for (size_t frame = 0; frame < reader.frameCount(); ++frame)
+        {
+            if (!reader.readFrame(frame, field))
+            {
+                std::cout << "Frame " << frame << " is damaged" << std::endl;
+                return 1;
+            }
+            std::cout << reader.frameStep(frame) << "," << field[cell] << "\n";
+        }
+        return 0;
+    }
+
     sf::RenderWindow window(sf::VideoMode({WINDOW_WIDTH, WINDOW_HEIGHT}), "Physarum Simulation");
     window.setFramerateLimit(60);
 
@@ -1524,8 +1628,10 @@ int main()
     }
 
     SimulationSettings settings;
-    settings.width = WINDOW_WIDTH;
-    settings.height = WINDOW_HEIGHT;
+    settings.width = WORLD_WIDTH;
+    settings.height = WORLD_HEIGHT;
+    settings.viewWidth = WINDOW_WIDTH;
+    settings.viewHeight = WINDOW_HEIGHT;
     settings.numAgents = 10;                                          // good density for network formation
     settings.spawnMode = SimulationSettings::SpawnMode::InwardCircle; // creates better initial clustering
 
@@ -1550,13 +1656,23 @@ int main()
 
     // initialize mouse settings for hud display
     MouseSettings mouseSettings;
+    RetainedHud hud;
 
     // performance timing
     sf::Clock clock;
+    sf::Clock frameWorkClock;
+    FrameBudgetController frameBudget(settings.frameBudget);
+
+    // middle mouse camera drag
+    bool cameraDragging = false;
+    sf::Vector2i cameraDragLast;
 
     while (window.isOpen())
     {
+        // everything in the frame arena from the last frame is gone from here on
+        FrameArena::beginFrame();
         sf::Time deltaTime = clock.restart();
+        frameWorkClock.restart();
         // handle events
         while (const std::optional event = window.pollEvent())
         {
@@ -1587,6 +1703,10 @@ int main()
                 if (keyPressed->code == sf::Keyboard::Key::Num6)
                     settings.trailWeight = std::max(settings.trailWeight - 0.5f, 0.0f);
 
+                // camera: whole world back in view
+                if (keyPressed->code == sf::Keyboard::Key::Home)
+                    simulation.resetCamera();
+
                 // movement settings
                 if (keyPressed->code == sf::Keyboard::Key::E)
                     species.moveSpeed = std::min(species.moveSpeed + 0.1f, 50.0f);
@@ -1640,7 +1760,16 @@ int main()
                 // simulation control
                 if (keyPressed->code == sf::Keyboard::Key::Space)
                 {
-                    if (simulation.isInBenchmarkMode()) {
+                    bool shiftDown = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LShift) ||
+                                     sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RShift);
+                    if (simulation.isInBenchmarkMode() && shiftDown) {
+                        // shift+space: run the race headless at full speed (race time is in ticks, so the results match a watched race)
+                        // 10 minutes of race time
+                        const int headlessMaxTicks = static_cast<int>(
+                            std::ceil(600.0f / std::max(settings.benchmarkSettings.raceTickSeconds, 1e-4f)));
+                        simulation.runBenchmarkHeadless(headlessMaxTicks);
+                        simulation.refreshDisplay();
+                    } else if (simulation.isInBenchmarkMode()) {
                         // in benchmark mode: start benchmark or reset
                         if (!simulation.getBenchmarkManager().isBenchmarkActive()) {
                             simulation.startBenchmark();
@@ -2182,10 +2311,11 @@ int main()
                         // add a random species from the classic 5+ that isn't already present
                         if (activeSpeciesIndices.size() < 8) // allow up to 8 species (5 classic + 3 malevolent)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             addRandomClassic5Species(simulation, settings);
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            // only the added/removed species changes, the rest of the world keeps running
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
 
                             // check if we added a malevolent species (indices 5-7)
                             bool hasParasite = std::find(activeSpeciesIndices.begin(), activeSpeciesIndices.end(), 5) != activeSpeciesIndices.end();
@@ -2222,10 +2352,11 @@ int main()
                         // will remove a random species from the active ones
                         if (activeSpeciesIndices.size() > 1)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             removeRandomClassic5Species(simulation, settings);
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            // only the added/removed species changes, the rest of the world keeps running
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                             std::cout << " Removed species! Now have " << activeSpeciesIndices.size() << " Classic species active" << std::endl;
                         }
                         else
@@ -2245,59 +2376,59 @@ int main()
                     {
                         if (keyPressed->code == sf::Keyboard::Key::Num1)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(0, simulation, settings); // red
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num2)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(1, simulation, settings); // blue
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num3)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(2, simulation, settings); // green
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num4)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(3, simulation, settings); // yellow
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num5)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(4, simulation, settings); // magenta
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num6)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(5, simulation, settings); // black
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num7)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(6, simulation, settings); // crimson
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                         else if (keyPressed->code == sf::Keyboard::Key::Num8)
                         {
+                            std::vector<int> previousActive = activeSpeciesIndices;
                             toggleSpecies(7, simulation, settings); // white
                             setupSpecies(settings);
-                            simulation.updateSettings(settings);
-                            simulation.reset();
+                            simulation.updateSettings(settings, classic5SpeciesSources(previousActive));
                         }
                     }
                 }
@@ -2345,6 +2476,15 @@ int main()
                     }
                 }
 
+                // f5: start / stop recording the trail field (FieldRecorder.h)
+                if (keyPressed->code == sf::Keyboard::Key::F5)
+                {
+                    if (simulation.isRecordingField())
+                        simulation.stopFieldRecording();
+                    else
+                        simulation.startFieldRecording();
+                }
+
                 // shift+f: toggle ALL ui off/on instantly
                 // TODO: update to not toggle off overlay texture
                 if (keyPressed->code == sf::Keyboard::Key::F &&
@@ -2427,6 +2567,15 @@ int main()
             if (const auto *mousePressed = event->getIf<sf::Event::MouseButtonPressed>())
             {
                 sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+                const sf::Vector2f cursorWorld = simulation.screenToWorld(mousePos);
+                const sf::Vector2i worldPos(static_cast<int>(cursorWorld.x), static_cast<int>(cursorWorld.y));
+
+                // middle button drags the camera
+                if (mousePressed->button == sf::Mouse::Button::Middle)
+                {
+                    cameraDragging = true;
+                    cameraDragLast = mousePressed->position;
+                }
 
                 // check for modifier keys (alt or cmd/option for pellets)
                 bool altPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl) ||
@@ -2446,15 +2595,15 @@ int main()
                     if (altPressed)
                     {
                         // alt/cmd + left click - place gentle attractive food pellet
-                        simulation.addFoodPellet(mousePos.x, mousePos.y, scaledFoodStrength * 5.0f, 200.0f, 0);
-                        std::cout << "Placed ATTRACTIVE FOOD PELLET at (" << mousePos.x << ", " << mousePos.y
+                        simulation.addFoodPellet(worldPos.x, worldPos.y, scaledFoodStrength * 5.0f, 200.0f, 0);
+                        std::cout << "Placed ATTRACTIVE FOOD PELLET at (" << worldPos.x << ", " << worldPos.y
                                   << ") strength: " << (scaledFoodStrength * 5.0f) << " radius: 200px" << std::endl;
                     }
                     else
                     {
                         // left mouse button - place normal food/attractant trail
-                        simulation.depositFood(mousePos.x, mousePos.y, scaledFoodStrength, mouseSettings.brushRadius);
-                        std::cout << "Placed food trail at (" << mousePos.x << ", " << mousePos.y << ") strength: " << scaledFoodStrength
+                        simulation.depositFood(worldPos.x, worldPos.y, scaledFoodStrength, mouseSettings.brushRadius);
+                        std::cout << "Placed food trail at (" << worldPos.x << ", " << worldPos.y << ") strength: " << scaledFoodStrength
                                   << " (base: " << mouseSettings.foodStrength << " × " << agentScalingFactor << ")" << std::endl;
                     }
                 }
@@ -2463,25 +2612,47 @@ int main()
                     if (altPressed)
                     {
                         // alt/cmd + right click - place gentle repulsive pellet
-                        simulation.addFoodPellet(mousePos.x, mousePos.y, scaledRepellentStrength * 5.0f, 200.0f, 0);
-                        std::cout << "Placed REPULSIVE FOOD PELLET at (" << mousePos.x << ", " << mousePos.y
+                        simulation.addFoodPellet(worldPos.x, worldPos.y, scaledRepellentStrength * 5.0f, 200.0f, 0);
+                        std::cout << "Placed REPULSIVE FOOD PELLET at (" << worldPos.x << ", " << worldPos.y
                                   << ") strength: " << (scaledRepellentStrength * 5.0f) << " radius: 200px" << std::endl;
                     }
                     else
                     {
                         // right mouse button - place normal repellent trail
-                        simulation.depositRepellent(mousePos.x, mousePos.y, scaledRepellentStrength, mouseSettings.brushRadius);
-                        std::cout << "Placed repellent trail at (" << mousePos.x << ", " << mousePos.y << ") strength: " << scaledRepellentStrength
+                        simulation.depositRepellent(worldPos.x, worldPos.y, scaledRepellentStrength, mouseSettings.brushRadius);
+                        std::cout << "Placed repellent trail at (" << worldPos.x << ", " << worldPos.y << ") strength: " << scaledRepellentStrength
                                   << " (base: " << mouseSettings.repellentStrength << " × " << agentScalingFactor << ")" << std::endl;
                     }
                 }
             }
+
+            // camera: wheel zooms about the cursor, middle drag pans
+            if (const auto *wheel = event->getIf<sf::Event::MouseWheelScrolled>())
+            {
+                simulation.zoomCamera(wheel->delta > 0.0f ? 0.8f : 1.25f, wheel->position);
+            }
+            if (const auto *mouseReleased = event->getIf<sf::Event::MouseButtonReleased>())
+            {
+                if (mouseReleased->button == sf::Mouse::Button::Middle)
+                    cameraDragging = false;
+            }
+            if (const auto *mouseMoved = event->getIf<sf::Event::MouseMoved>())
+            {
+                if (cameraDragging)
+                {
+                    const sf::Vector2i delta = mouseMoved->position - cameraDragLast;
+                    simulation.panCamera(sf::Vector2f(static_cast<float>(delta.x), static_cast<float>(delta.y)));
+                    cameraDragLast = mouseMoved->position;
+                }
+            }
         }
 
         // continuous mouse placement (hold and drag for a sorta brush like drawing though when resizing window its placed in a wrong spot)
         if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left) || sf::Mouse::isButtonPressed(sf::Mouse::Button::Right))
         {
             sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+            const sf::Vector2f cursorWorld = simulation.screenToWorld(mousePos);
+            const sf::Vector2i worldPos(static_cast<int>(cursorWorld.x), static_cast<int>(cursorWorld.y));
 
             // only gets placed if mouse is within window bounds
             if (mousePos.x >= 0 && mousePos.x < WINDOW_WIDTH &&
@@ -2495,37 +2666,49 @@ int main()
                 if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Left))
                 {
                     // continuous food placement with reduced strength for smooth drawing
-                    simulation.depositFood(mousePos.x, mousePos.y, scaledFoodStrength * 0.1f, mouseSettings.brushRadius);
+                    simulation.depositFood(worldPos.x, worldPos.y, scaledFoodStrength * 0.1f, mouseSettings.brushRadius);
                 }
                 else if (sf::Mouse::isButtonPressed(sf::Mouse::Button::Right))
                 {
                     // continuous repellent placement with reduced strength for smooth drawing
-                    simulation.depositRepellent(mousePos.x, mousePos.y, scaledRepellentStrength * 0.1f, mouseSettings.brushRadius);
+                    simulation.depositRepellent(worldPos.x, worldPos.y, scaledRepellentStrength * 0.1f, mouseSettings.brushRadius);
                 }
             }
         }
 
-        // update simulation
-        simulation.update(deltaTime.asSeconds());
+        // update simulation: fixed ticks off the accumulator, quality knobs from the frame budget
+        frameBudget.configure(settings.frameBudget);
+        int ticks = frameBudget.beginFrame(deltaTime.asSeconds());
+        FrameBudgetController::Quality quality = frameBudget.getQuality(settings.stepsPerFrame);
+        simulation.setQualityOverrides(quality.blurInterval, quality.allowShading, quality.allowOverlay);
+        if (ticks > 0)
+        {
+            simulation.simulateTicks(ticks, quality.stepsPerTick);
+            simulation.refreshDisplay();
+        }
 
         // render
         window.clear(sf::Color::Black);
         simulation.draw(window, font);
 
-        // draws the hud based on current mode
+        // draws the hud based on current mode (retained: only relaid out when what it shows changes)
+        hud.beginFrame(font);
         switch (currentHudMode)
         {
         case HudMode::Full:
-            drawSimpleHUD(window, font, settings, mouseSettings, simulation.getAgentCount(), currentSpeciesMode, randomSpeciesCount);
+            drawSimpleHUD(window, hud, settings, mouseSettings, simulation.getAgentCount(), currentSpeciesMode, randomSpeciesCount);
             break;
         case HudMode::Compact:
-            drawCompactHUD(window, font, settings, mouseSettings, simulation.getAgentCount(), currentSpeciesMode, randomSpeciesCount, currentHudPosition);
+            drawCompactHUD(window, hud, settings, mouseSettings, simulation.getAgentCount(), currentSpeciesMode, randomSpeciesCount, currentHudPosition);
             break;
         case HudMode::Hidden:
             // or draw nothing
             break;
         }
+        hud.draw(window);
 
+        // measured before display() so the framerate limit wait doesnt count against the budget
+        frameBudget.endFrame(frameWorkClock.getElapsedTime().asSeconds() * 1000.0f);
         window.display();
     }
 
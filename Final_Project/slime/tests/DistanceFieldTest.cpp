@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "Pathfinder.h"
+#include <cmath>
+#include <random>
+
+// delta stepping (computeDistanceFieldParallel) against the sequential dijkstra field: same distance
+// in every cell, infinity in the same cells, for any bucket width and thread count
+
+namespace
+{
+    constexpr int CELL = 4;
+
+    void expectSameField(const Pathfinder::DistanceField &expected, const Pathfinder::DistanceField &actual)
+    {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            if (std::isinf(expected[i]))
+                ASSERT_TRUE(std::isinf(actual[i])) << "cell " << i << " should be unreachable";
+            else
+                ASSERT_NEAR(expected[i], actual[i], 1e-3f) << "cell " << i;
+        }
+    }
+}
+
+TEST(DistanceFieldTest, ParallelMatchesDijkstraOnRandomGrids)
+{
+    std::mt19937 rng(9);
+    for (int world = 0; world < 100; ++world)
+    {
+        const int w = 20 + static_cast<int>(rng() % 150);
+        const int h = 20 + static_cast<int>(rng() % 150);
+        Pathfinder pathfinder(w * CELL, h * CELL, CELL);
+        const int obstacles = static_cast<int>(rng() % 40);
+        for (int i = 0; i < obstacles; ++i)
+            pathfinder.addObstacle(static_cast<int>(rng() % w), static_cast<int>(rng() % h),
+                                   2 + static_cast<int>(rng() % 14), 2 + static_cast<int>(rng() % 14));
+
+        GridCell source{static_cast<int>(rng() % w), static_cast<int>(rng() % h)};
+        const auto expected = pathfinder.computeDistanceField(source);
+        for (float delta : {0.3f, 1.0f, 1.5f, 4.0f})
+        {
+            for (unsigned threads : {1u, 3u, 8u})
+            {
+                SCOPED_TRACE("world " + std::to_string(world) + " delta " + std::to_string(delta) +
+                             " threads " + std::to_string(threads));
+                expectSameField(expected, pathfinder.computeDistanceFieldParallel(source, delta, threads));
+            }
+        }
+    }
+}
+
+TEST(DistanceFieldTest, WalledOffCellsStayUnreachable)
+{
+    // a closed ring of walls around a 10x10 room, the source outside it
+    Pathfinder pathfinder(60 * CELL, 40 * CELL, CELL);
+    pathfinder.addObstacle(30, 10, 12, 1);
+    pathfinder.addObstacle(30, 21, 12, 1);
+    pathfinder.addObstacle(30, 10, 1, 12);
+    pathfinder.addObstacle(41, 10, 1, 12);
+
+    const GridCell source{5, 5};
+    const auto expected = pathfinder.computeDistanceField(source);
+    EXPECT_TRUE(std::isinf(expected[15 * 60 + 35])); // inside the room
+    EXPECT_FALSE(std::isinf(expected[30 * 60 + 50]));
+    EXPECT_EQ(expected[5 * 60 + 5], 0.0f);
+    for (unsigned threads : {1u, 3u, 8u})
+        expectSameField(expected, pathfinder.computeDistanceFieldParallel(source, 1.5f, threads));
+}
+
+TEST(DistanceFieldTest, BlockedSourceReachesNothing)
+{
+    Pathfinder pathfinder(40 * CELL, 40 * CELL, CELL);
+    pathfinder.addObstacle(10, 10, 5, 5);
+
+    const GridCell source{12, 12};
+    const auto expected = pathfinder.computeDistanceField(source);
+    for (float distance : expected)
+        EXPECT_TRUE(std::isinf(distance));
+    expectSameField(expected, pathfinder.computeDistanceFieldParallel(source, 1.5f, 3));
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "FastMath.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// the error bounds promised in FastMath.h, swept against libm (plus the simd array path against the
+// same bounds) and the worst 8 bit color difference on the real display curves
+
+namespace
+{
+    constexpr int SAMPLES = 200000;
+
+    // floats between two non negative values, counted on the bit patterns: subtracting them would go
+    // through subnormals near FLT_MIN, which a -ffast-math program flushes to zero
+    float ulpDistance(float approx, float exact)
+    {
+        const auto a = static_cast<std::int64_t>(FastMath::detail::floatToBits(approx));
+        const auto e = static_cast<std::int64_t>(FastMath::detail::floatToBits(exact));
+        return static_cast<float>(a > e ? a - e : e - a);
+    }
+}
+
+TEST(FastMathTest, ExpWithinFourUlp)
+{
+    std::vector<float> in(SAMPLES), out(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i)
+        in[i] = -87.0f + 175.0f * i / (SAMPLES - 1);
+    FastMath::expArray(in.data(), out.data(), in.size());
+    float worst = 0.0f, worstArray = 0.0f;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const float exact = std::exp(in[i]);
+        worst = std::max(worst, ulpDistance(FastMath::exp(in[i]), exact));
+        worstArray = std::max(worstArray, ulpDistance(out[i], exact));
+    }
+    EXPECT_LE(worst, 4.0f);
+    EXPECT_LE(worstArray, 4.0f);
+}
+
+TEST(FastMathTest, ExpUnderflowsToZero)
+{
+    EXPECT_EQ(FastMath::exp(-87.5f), 0.0f);
+    EXPECT_EQ(FastMath::exp2(-127.0f), 0.0f);
+}
+
+TEST(FastMathTest, Exp2WithinFourUlp)
+{
+    float worst = 0.0f;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const float x = -126.0f + 253.0f * i / (SAMPLES - 1);
+        worst = std::max(worst, ulpDistance(FastMath::exp2(x), std::exp2(x)));
+    }
+    EXPECT_LE(worst, 4.0f);
+}
+
+TEST(FastMathTest, Log2WithinAbsoluteBound)
+{
+    // 2^-120 .. 2^120, stepping the bit pattern (log spaced, and unlike log2(exp2(t)) nothing a
+    // -ffast-math build could fold away). the bound is 2e-7 on top of one ulp of the result
+    const std::uint32_t first = 0x03800000u, last = 0x7b800000u;
+    float worst = 0.0f;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const auto step = static_cast<std::uint64_t>(last - first) * static_cast<std::uint64_t>(i) / (SAMPLES - 1);
+        const float x = FastMath::detail::bitsToFloat(first + static_cast<std::uint32_t>(step));
+        const float exact = std::log2(x);
+        const float ulp = std::nextafter(std::fabs(exact), 1e30f) - std::fabs(exact);
+        worst = std::max(worst, std::fabs(FastMath::log2(x) - exact) - ulp);
+    }
+    EXPECT_LE(worst, 2e-7f);
+
+    // where the result is small the one ulp is nothing, this is the 2e-7 alone
+    float worstNearOne = 0.0f;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const float x = 0.5f + 1.5f * i / (SAMPLES - 1);
+        worstNearOne = std::max(worstNearOne, std::fabs(FastMath::log2(x) - std::log2(x)));
+    }
+    EXPECT_LE(worstNearOne, 2e-7f);
+}
+
+TEST(FastMathTest, PowWithinRelativeBound)
+{
+    // the display / shading domain: x in (0, 1], exponents up to 32
+    const float exponents[] = {0.5f, 0.8f, 2.0f, 8.0f, 24.0f, 32.0f};
+    std::vector<float> in(SAMPLES), out(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i)
+        in[i] = static_cast<float>(i + 1) / SAMPLES;
+    float worst = 0.0f, worstArray = 0.0f;
+    for (float y : exponents)
+    {
+        FastMath::powArray(in.data(), y, out.data(), in.size());
+        for (int i = 0; i < SAMPLES; ++i)
+        {
+            const float exact = std::pow(in[i], y);
+            if (exact < 1e-30f)
+                continue;
+            worst = std::max(worst, std::fabs(FastMath::pow(in[i], y) - exact) / exact);
+            worstArray = std::max(worstArray, std::fabs(out[i] - exact) / exact);
+        }
+    }
+    EXPECT_LE(worst, 1e-5f);
+    EXPECT_LE(worstArray, 1e-5f);
+    EXPECT_EQ(FastMath::pow(0.0f, 2.0f), 0.0f);
+}
+
+TEST(FastMathTest, SinCosWithinAbsoluteBound)
+{
+    float worst = 0.0f;
+    for (int i = 0; i < SAMPLES; ++i)
+    {
+        const float x = -8192.0f + 16384.0f * i / (SAMPLES - 1);
+        worst = std::max(worst, std::fabs(FastMath::sin(x) - std::sin(x)));
+        worst = std::max(worst, std::fabs(FastMath::cos(x) - std::cos(x)));
+    }
+    EXPECT_LE(worst, 2e-7f);
+}
+
+TEST(FastMathTest, DisplayCurvesWithinOneColorLevel)
+{
+    // what actually ends up on screen: the trail intensity curve, the specular term and the splat
+    // weights quantized to 8 bit. truncation can still flip a level right at a boundary, more than
+    // one means a real error
+    auto level = [](float f) { return static_cast<int>(std::min(255.0f, f * 255.0f)); };
+    int worst = 0;
+    for (int i = 0; i <= 65536; ++i)
+    {
+        const float v = i / 65536.0f;
+        worst = std::max(worst, std::abs(level(FastMath::pow(v, 0.8f)) - level(std::pow(v, 0.8f))));
+        worst = std::max(worst, std::abs(level(FastMath::pow(v, 24.0f) * 0.55f) - level(std::pow(v, 24.0f) * 0.55f)));
+        const float e = -10.0f * v;
+        worst = std::max(worst, std::abs(level(FastMath::exp(e)) - level(std::exp(e))));
+    }
+    EXPECT_LE(worst, 1);
+}